@@ -0,0 +1,163 @@
+import { DeviceTypeEvents } from '@gnaudio/jabra-node-sdk';
+
+/**
+ * Compact binary encoding of high-rate device events sent from the server to clients
+ * through a MessagePort - one buffer per tick instead of one structured-clone ipc message
+ * per event.
+ *
+ * A batch is a sequence of little-endian records:
+ *   uint16 deviceID, uint8 event code, uint8 value count, value count * int32 values
+ *
+ * Only events whose arguments are numbers, booleans or flat objects of those are encoded.
+ * All other device events are still sent as ordinary ipc messages.
+ *
+ * @internal
+ * @hidden
+ */
+
+type FieldKind = 'number' | 'boolean';
+
+interface EventCodec {
+    event: DeviceTypeEvents;
+    encode: (args: any[]) => number[];
+    decode: (values: number[]) => any[];
+}
+
+function encodeField(kind: FieldKind, value: any): number {
+    return kind === 'boolean' ? (value ? 1 : 0) : value;
+}
+
+function decodeField(kind: FieldKind, value: number): any {
+    return kind === 'boolean' ? value !== 0 : value;
+}
+
+/**
+ * Codec for events with positional number/boolean arguments.
+ */
+function positional(event: DeviceTypeEvents, kinds: FieldKind[]): EventCodec {
+    return {
+        event,
+        encode: (args) => kinds.map((kind, i) => encodeField(kind, args[i])),
+        decode: (values) => kinds.map((kind, i) => decodeField(kind, values[i]))
+    };
+}
+
+/**
+ * Codec for events with a single flat object argument.
+ */
+function singleObject(event: DeviceTypeEvents, fields: Array<[string, FieldKind]>): EventCodec {
+    return {
+        event,
+        encode: (args) => fields.map(([name, kind]) => encodeField(kind, args[0][name])),
+        decode: (values) => [ fields.reduce((obj, [name, kind], i) => {
+            obj[name] = decodeField(kind, values[i]);
+            return obj;
+        }, {} as { [name: string]: any }) ]
+    };
+}
+
+/**
+ * The batched events - the index is the event code on the wire, so only append to this list.
+ */
+const eventCodecs: ReadonlyArray<EventCodec> = [
+    positional('btnPress', ['number', 'boolean']),
+    positional('busyLightChange', ['boolean']),
+    positional('downloadFirmwareProgress', ['number', 'number', 'number']),
+    positional('onBatteryStatusUpdate', ['number', 'boolean', 'boolean']),
+    positional('onRemoteMmiEvent', ['number', 'number']),
+    positional('onxpressConnectionStatusEvent', ['boolean']),
+    positional('onUploadProgress', ['number', 'number']),
+    positional('onCameraStatusEvent', ['boolean']),
+    positional('onBluetoothLinkQualityChangeEvent', ['number']),
+    positional('onNetworkStatusChangedEvent', ['number', 'number']),
+    singleObject('onHeadDetectionStatusEvent', [['leftOn', 'boolean'], ['rightOn', 'boolean']]),
+    positional('onJackConnectorStatusEvent', ['boolean']),
+    singleObject('onLinkConnectionStatusEvent', [['open', 'boolean'], ['component', 'number']])
+];
+
+const eventCodes = new Map<DeviceTypeEvents, number>(eventCodecs.map((codec, i) => [codec.event, i] as [DeviceTypeEvents, number]));
+
+const RECORD_HEADER_SIZE = 4;
+
+/**
+ * Returns true if the device event is sent in batches when a batch port is available.
+ */
+export function isBatchedDeviceEvent(event: DeviceTypeEvents): boolean {
+    return eventCodes.has(event);
+}
+
+/**
+ * Collects device events on the server until the next flush.
+ */
+export class DeviceEventBatchEncoder {
+    private records: Array<{ deviceID: number, code: number, values: number[] }> = [];
+    private size: number = 0;
+
+    /**
+     * Returns false if the event is not a batched event.
+     */
+    add(deviceID: number, event: DeviceTypeEvents, args: any[]): boolean {
+        const code = eventCodes.get(event);
+        if (code === undefined) {
+            return false;
+        }
+
+        const values = eventCodecs[code].encode(args);
+        this.records.push({ deviceID, code, values });
+        this.size += RECORD_HEADER_SIZE + values.length * 4;
+        return true;
+    }
+
+    isEmpty(): boolean {
+        return this.records.length === 0;
+    }
+
+    /**
+     * Encode all events added since the last call into one buffer.
+     */
+    take(): ArrayBuffer {
+        const buffer = new ArrayBuffer(this.size);
+        const view = new DataView(buffer);
+        let offset = 0;
+        this.records.forEach((record) => {
+            view.setUint16(offset, record.deviceID, true);
+            view.setUint8(offset + 2, record.code);
+            view.setUint8(offset + 3, record.values.length);
+            offset += RECORD_HEADER_SIZE;
+            record.values.forEach((value) => {
+                view.setInt32(offset, value, true);
+                offset += 4;
+            });
+        });
+
+        this.records = [];
+        this.size = 0;
+        return buffer;
+    }
+}
+
+/**
+ * Decode a batch on the client, calling emit for each event in the order they were added.
+ */
+export function decodeDeviceEventBatch(buffer: ArrayBuffer, emit: (deviceID: number, event: DeviceTypeEvents, args: any[]) => void): void {
+    const view = new DataView(buffer);
+    let offset = 0;
+    while (offset + RECORD_HEADER_SIZE <= buffer.byteLength) {
+        const deviceID = view.getUint16(offset, true);
+        const code = view.getUint8(offset + 2);
+        const count = view.getUint8(offset + 3);
+        offset += RECORD_HEADER_SIZE;
+
+        const values: number[] = [];
+        for (let i = 0; i < count; ++i) {
+            values.push(view.getInt32(offset, true));
+            offset += 4;
+        }
+
+        // Skip codes from a newer server rather than failing the whole batch.
+        const codec = eventCodecs[code];
+        if (codec) {
+            emit(deviceID, codec.event, codec.decode(values));
+        }
+    }
+}
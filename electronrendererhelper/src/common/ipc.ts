@@ -44,6 +44,29 @@ export const jabraLogEventName = "jabraApiClientLog";
  */
 export const jabraApiClientReadyEventName  = "jabraApiClientReadyEventName";
 
+/**
+ * Send by the client with (deviceID, eventName, subscribe) when it gets its first listener for a
+ * device event (subscribe = true) or loses its last one (subscribe = false). The server only
+ * listens for a device event while at least one client is subscribed to it.
+ */
+export const jabraDeviceEventSubscriptionEventName = "jabraDeviceEventSubscription";
+
+/**
+ * Reply (event.returnValue) to a synchronous method call sent by ipcRenderer.sendSync.
+ */
+export type SyncMethodResponse = {
+    err: SerializedError | undefined;
+    result: any;
+};
+
+/**
+ * Send by the client with a MessagePort on which it wants to receive high-rate device events
+ * as binary batches (see eventbatch.ts). Once a port is open, the server no longer sends these
+ * events to the frame of the client as individual ipc messages. Batches only hold events the
+ * frame subscribed to and are not ordered with the ipc messages of other events.
+ */
+export const jabraDeviceEventBatchPortEventName = "jabraDeviceEventBatchPort";
+
 /**
  * Event channel name for executing methods against a specific device.
  */
@@ -51,6 +74,13 @@ export function getExecuteDeviceTypeApiMethodEventName(deviceID: number) {
     return 'executeDeviceApiMethod:' + deviceID.toString();
 }
 
+/**
+ * Event channel name for executing synchronous methods against a specific device.
+ */
+export function getExecuteDeviceTypeApiSyncMethodEventName(deviceID: number) {
+    return 'executeDeviceApiSyncMethod:' + deviceID.toString();
+}
+
 /**
  * Event channel name for responding with results to executing methods against a specific device.
  */
@@ -72,6 +102,13 @@ export function getExecuteJabraTypeApiMethodEventName() {
     return 'executeJabraApiMethod';
 }
 
+/**
+ * Event channel name for executing synchronous general methods on the jabra sdk (not device specific).
+ */
+export function getExecuteJabraTypeApiSyncMethodEventName() {
+    return 'executeJabraApiSyncMethod';
+}
+
 /**
  * Event channel name for responding with results to executing methods on the jabra sdk (not device specific).
  */
@@ -3,18 +3,26 @@
 // electron app has these types loaded already.
 type BrowserWindow = import('electron').BrowserWindow;
 type IpcMain = import('electron').IpcMain;
+type MessagePortMain = import('electron').MessagePortMain;
+type IpcMainEvent = import('electron').IpcMainEvent;
 
 import { isNodeJs, nameof, serializeError } from '../common/util';
 
 import { _getJabraApiMetaSync, createJabraApplication, JabraType, ConfigParamsCloud,
-         DeviceEventsList, ClassEntry, DeviceType,
+         DeviceEventsList, DeviceTypeEvents, ClassEntry, DeviceType,
          _JabraGetNativeAddonLogConfig, _JabraNativeAddonLog, NativeAddonLogConfig, AddonLogSeverity } from '@gnaudio/jabra-node-sdk';
 
 import { getExecuteDeviceTypeApiMethodEventName, getDeviceTypeApiCallabackEventName, 
          getJabraTypeApiCallabackEventName, getExecuteJabraTypeApiMethodEventName, 
          getExecuteJabraTypeApiMethodResponseEventName, 
          getExecuteDeviceTypeApiMethodResponseEventName,
-         createApiClientInitEventName, jabraLogEventName, ApiClientInitEventData, jabraApiClientReadyEventName, ApiClientIntResponse, createApiClientInitResponseEventName } from '../common/ipc';
+         getExecuteJabraTypeApiSyncMethodEventName, getExecuteDeviceTypeApiSyncMethodEventName, SyncMethodResponse,
+         createApiClientInitEventName, jabraLogEventName, ApiClientInitEventData, jabraApiClientReadyEventName, ApiClientIntResponse, createApiClientInitResponseEventName,
+         jabraDeviceEventBatchPortEventName, jabraDeviceEventSubscriptionEventName } from '../common/ipc';
+
+import { DeviceEventBatchEncoder, isBatchedDeviceEvent } from '../common/eventbatch';
+
+import { SettingsSnapshotCache } from './settingsSnapshotCache';
 
 /**
  * This factory singleton is responsible for creating the server side Jabra API server that serves 
@@ -150,6 +158,14 @@ export class JabraApiServerFactory
     }
 }
 
+/**
+ * Listener forwarding a device event to the clients subscribed to it.
+ */
+interface DeviceEventSubscription {
+    frames: Map<number, number>;
+    listener: (...args: any[]) => void;
+}
+
 /**
  * Server side Jabra APi server that serves events and forwards commands for the 
  * corresponding (client side) createApiClient() helper.
@@ -168,6 +184,24 @@ export class JabraApiServer
     public readonly ipcMain: IpcMain;
     public readonly window: BrowserWindow;
 
+    /**
+     * Ports of client frames receiving high-rate device events as binary batches (see eventbatch.ts),
+     * each with the batch of its frame - a frame only gets the events it subscribed to.
+     */
+    private readonly eventBatchPorts = new Map<number, { port: MessagePortMain, batch: DeviceEventBatchEncoder }>();
+    private eventBatchFlushScheduled: boolean = false;
+
+    /**
+     * Only set while enabled with setSettingsCacheEnabled.
+     */
+    private settingsCache: SettingsSnapshotCache | null = null;
+
+    /**
+     * Device events forwarded to clients: per device and event, the number of subscriptions of
+     * each client frame and the listener registered on the device while there are any.
+     */
+    private readonly deviceEventSubscriptions = new Map<number, Map<DeviceTypeEvents, DeviceEventSubscription>>();
+
     /**
      * Constructs a Jabra API server object.
      * 
@@ -192,6 +226,21 @@ export class JabraApiServer
         return this.jabraApi;
     }
 
+    /**
+     * Answer getSettingsAsync() calls of all clients from settings cached in the main process.
+     * Disabled by default, as the cache enables settings change events for every device it holds
+     * settings of - to notice changes made on the device itself - until the device detaches or
+     * the cache is disabled again.
+     */
+    public setSettingsCacheEnabled(enabled: boolean) {
+        if (enabled && !this.settingsCache) {
+            this.settingsCache = new SettingsSnapshotCache();
+        } else if (!enabled && this.settingsCache) {
+            this.settingsCache.dispose();
+            this.settingsCache = null;
+        }
+    }
+
     private constructor(jabraApi: JabraType, ipcMain: IpcMain, jabraApiMeta: ClassEntry[], clientInitResponsesRequested: ApiClientIntResponse[], window: BrowserWindow) {
         this.jabraApi = jabraApi;
         this.ipcMain = ipcMain;
@@ -231,6 +280,13 @@ export class JabraApiServer
             let deviceData = this.getPublicDeviceData(device);
 
             this.unsubscribeDeviceTypeEvents(device);
+            if (this.settingsCache) {
+                this.settingsCache.onDetach(device);
+            }
+
+            // Send pending events of the device now rather than in the next tick. The ports are not
+            // ordered with ipc messages, so clients may still get them after the detach.
+            this.flushEventBatch();
 
             this.window.webContents.send(getJabraTypeApiCallabackEventName('detach'), deviceData);
         });
@@ -271,6 +327,47 @@ export class JabraApiServer
             }
         });
 
+        // A (re)initializing client starts without subscriptions - drop any left by an earlier client in the same frame:
+        this.ipcMain.on(createApiClientInitEventName, this.onClientInit);
+
+        // Subscribe/unsubscribe device events on behalf of clients:
+        this.ipcMain.on(jabraDeviceEventSubscriptionEventName, (event, deviceID: number, eventName: DeviceTypeEvents, subscribe: boolean) => {
+            const device = jabraApi.getAttachedDevices().find((d) => d.deviceID === deviceID);
+            if (!device || DeviceEventsList.indexOf(eventName) < 0) {
+                return;
+            }
+
+            if (subscribe) {
+                this.subscribeDeviceEvent(device, eventName, event.frameId);
+            } else {
+                this.unsubscribeDeviceEvent(device, eventName, event.frameId);
+            }
+        });
+
+        // Receive a port from clients that want high-rate device events as binary batches:
+        this.ipcMain.on(jabraDeviceEventBatchPortEventName, (event) => {
+            const port = event.ports && event.ports[0];
+            if (port) {
+                const frameId = event.frameId;
+                _JabraNativeAddonLog(AddonLogSeverity.info, "JabraApiServer.setupElectonEvents", "Sending device events as batches to client at frame " + frameId);
+
+                // A reloaded client replaces the port of its frame.
+                const previous = this.eventBatchPorts.get(frameId);
+                if (previous) {
+                    previous.port.close();
+                }
+
+                this.eventBatchPorts.set(frameId, { port, batch: new DeviceEventBatchEncoder() });
+                port.on('close', () => {
+                    const current = this.eventBatchPorts.get(frameId);
+                    if (current && current.port === port) {
+                        this.eventBatchPorts.delete(frameId);
+                    }
+                });
+                port.start();
+            }
+        });
+
         // Receive JabraType api method calls from client:
         this.ipcMain.on(getExecuteJabraTypeApiMethodEventName(), (event, methodName: string, executionId: number, ...args: any[]) => {
             const frameId = event.frameId;
@@ -290,6 +387,11 @@ export class JabraApiServer
                 this.window.webContents.sendToFrame(frameId, getExecuteJabraTypeApiMethodResponseEventName(), methodName, executionId, serializeError(err), undefined);
             }
         });
+
+        // Receive synchronous JabraType api method calls from client:
+        this.ipcMain.on(getExecuteJabraTypeApiSyncMethodEventName(), (event, methodName: string, ...args: any[]) => {
+            event.returnValue = this.executeSyncApiCall("JabraApiServer.setupElectonEvents", () => this.executeJabraApiCall(jabraApi, methodName, -1, ...args));
+        });
     }
 
     private subscribeDeviceTypeEvents(device: DeviceType) {
@@ -312,23 +414,140 @@ export class JabraApiServer
                 this.window.webContents.sendToFrame(frameId, getExecuteDeviceTypeApiMethodResponseEventName(device.deviceID), methodName, executionId, serializeError(err), undefined);
             }
         });
-    
-    
-        // Setup forwarding for all device events:
-        DeviceEventsList.forEach((e) => {
-            device.on(e as any, ((...args: any[]) => {         
-                this.window.webContents.send(getDeviceTypeApiCallabackEventName(e, device.deviceID), ...args);
-            }));
+
+        // Receive synchronous DeviceType api method calls from client:
+        this.ipcMain.on(getExecuteDeviceTypeApiSyncMethodEventName(device.deviceID), (event, methodName: string, ...args: any[]) => {
+            event.returnValue = this.executeSyncApiCall("JabraApiServer.subscribeDeviceTypeEvents", () => this.executeDeviceApiCall(device, methodName, -1, ...args));
+        });
+    }
+
+    /**
+     * Start forwarding a device event for a client frame. The event is only subscribed on the
+     * device while some client wants it, so native listeners (head detection, settings changes
+     * etc.) stay off for events nobody watches.
+     */
+    private subscribeDeviceEvent(device: DeviceType, e: DeviceTypeEvents, frameId: number) {
+        let events = this.deviceEventSubscriptions.get(device.deviceID);
+        if (!events) {
+            events = new Map<DeviceTypeEvents, DeviceEventSubscription>();
+            this.deviceEventSubscriptions.set(device.deviceID, events);
+        }
+
+        let subscription = events.get(e);
+        if (!subscription) {
+            const frames = new Map<number, number>();
+            subscription = {
+                frames,
+                listener: (...args: any[]) => this.forwardDeviceEvent(device.deviceID, e, frames, args)
+            };
+            events.set(e, subscription);
+            device.on(e as any, subscription.listener as any);
+        }
+
+        subscription.frames.set(frameId, (subscription.frames.get(frameId) || 0) + 1);
+    }
+
+    private unsubscribeDeviceEvent(device: DeviceType, e: DeviceTypeEvents, frameId: number, allOfFrame: boolean = false) {
+        const events = this.deviceEventSubscriptions.get(device.deviceID);
+        const subscription = events && events.get(e);
+        if (!events || !subscription) {
+            return;
+        }
+
+        const count = allOfFrame ? 0 : (subscription.frames.get(frameId) || 0) - 1;
+        if (count > 0) {
+            subscription.frames.set(frameId, count);
+        } else {
+            subscription.frames.delete(frameId);
+        }
+
+        if (subscription.frames.size === 0) {
+            device.off(e as any, subscription.listener as any);
+            events.delete(e);
+            if (events.size === 0) {
+                this.deviceEventSubscriptions.delete(device.deviceID);
+            }
+        }
+    }
+
+    private readonly onClientInit = (event: IpcMainEvent) => {
+        if (this.jabraApi) {
+            this.unsubscribeFrameDeviceEvents(this.jabraApi, event.frameId);
+        }
+    };
+
+    private unsubscribeFrameDeviceEvents(jabraApi: JabraType, frameId: number) {
+        jabraApi.getAttachedDevices().forEach((device) => {
+            const events = this.deviceEventSubscriptions.get(device.deviceID);
+            if (events) {
+                Array.from(events.keys()).forEach((e) => this.unsubscribeDeviceEvent(device, e, frameId, true));
+            }
+        });
+    }
+
+    /**
+     * Forward a device event to the subscribed client frames - batched to frames that opened a
+     * batch port and as an ordinary ipc message to all others. Batches and ipc messages are
+     * separate channels, so events sent on one are not ordered with events sent on the other.
+     */
+    private forwardDeviceEvent(deviceID: number, e: DeviceTypeEvents, frames: Map<number, number>, args: any[]) {
+        const eventName = getDeviceTypeApiCallabackEventName(e, deviceID);
+        if (this.eventBatchPorts.size > 0 && isBatchedDeviceEvent(e)) {
+            frames.forEach((count, frameId) => {
+                const eventBatchPort = this.eventBatchPorts.get(frameId);
+                if (eventBatchPort) {
+                    this.addToEventBatch(eventBatchPort.batch, deviceID, e, args);
+                } else {
+                    // Clients that never opened a port (e.g. older or non-sandboxed renderers) still need the event.
+                    this.window.webContents.sendToFrame(frameId, eventName, ...args);
+                }
+            });
+        } else {
+            this.window.webContents.send(eventName, ...args);
+        }
+    }
+
+    private addToEventBatch(batch: DeviceEventBatchEncoder, deviceID: number, event: DeviceTypeEvents, args: any[]) {
+        batch.add(deviceID, event, args);
+
+        // Send everything that arrived in this tick as one message per frame.
+        if (!this.eventBatchFlushScheduled) {
+            this.eventBatchFlushScheduled = true;
+            setImmediate(() => this.flushEventBatch());
+        }
+    }
+
+    private flushEventBatch() {
+        this.eventBatchFlushScheduled = false;
+        this.eventBatchPorts.forEach(({ port, batch }) => {
+            if (!batch.isEmpty()) {
+                port.postMessage(batch.take());
+            }
         });
     }
 
     private unsubscribeDeviceTypeEvents(device: DeviceType) {
         this.ipcMain.removeAllListeners(getExecuteDeviceTypeApiMethodEventName(device.deviceID));
-        DeviceEventsList.forEach((e) => {
-            device.on(e as any, ((...args: any[]) => {
-                this.window.webContents.removeAllListeners(getDeviceTypeApiCallabackEventName(e, device.deviceID));
-            }));
-        });
+        this.ipcMain.removeAllListeners(getExecuteDeviceTypeApiSyncMethodEventName(device.deviceID));
+
+        const events = this.deviceEventSubscriptions.get(device.deviceID);
+        if (events) {
+            events.forEach((subscription, e) => device.off(e as any, subscription.listener as any));
+            this.deviceEventSubscriptions.delete(device.deviceID);
+        }
+    }
+
+    /**
+     * Execute a method for a client blocked in ipcRenderer.sendSync. Always returns a
+     * response, as the client would otherwise wait forever.
+     */
+    private executeSyncApiCall(caller: string, call: () => any): SyncMethodResponse {
+        try {
+            return { err: undefined, result: call() };
+        } catch (err) {
+            _JabraNativeAddonLog(AddonLogSeverity.error, caller, err);
+            return { err: serializeError(err), result: undefined };
+        }
     }
 
     private executeJabraApiCall(jabraApi: JabraType,methodName: string,  executionId: number, ...args: any[]) : any {
@@ -352,7 +571,23 @@ export class JabraApiServer
             throw new Error("Failed executing method " + methodName + " on detached device with id=" + device.deviceID);
         }
 
-        return (device as any)[methodName].apply(device, args);
+        const settingsCache = this.settingsCache;
+        if (!settingsCache) {
+            return (device as any)[methodName].apply(device, args);
+        }
+
+        if (SettingsSnapshotCache.isCached(methodName, args)) {
+            return settingsCache.getSettingsAsync(device);
+        }
+
+        // Drop cached settings both before and after methods that might change them.
+        settingsCache.onDeviceApiCall(device, methodName, args);
+        const result = (device as any)[methodName].apply(device, args);
+        if (result instanceof Promise) {
+            const invalidate = () => settingsCache.onDeviceApiCall(device, methodName, args);
+            result.then(invalidate, invalidate);
+        }
+        return result;
     }
 
     /**
@@ -360,7 +595,16 @@ export class JabraApiServer
     */
     public shutdown() : Promise<void> {
         this.ipcMain.removeAllListeners(getExecuteJabraTypeApiMethodEventName());
+        this.ipcMain.removeAllListeners(getExecuteJabraTypeApiSyncMethodEventName());
         this.ipcMain.removeAllListeners(jabraLogEventName);
+        this.ipcMain.removeAllListeners(jabraDeviceEventBatchPortEventName);
+        this.ipcMain.removeAllListeners(jabraDeviceEventSubscriptionEventName);
+        this.ipcMain.removeListener(createApiClientInitEventName, this.onClientInit);
+
+        this.flushEventBatch();
+        this.eventBatchPorts.forEach(({ port }) => port.close());
+        this.eventBatchPorts.clear();
+        this.setSettingsCacheEnabled(false);
 
         if (this.jabraApi) {
             const api = this.jabraApi;
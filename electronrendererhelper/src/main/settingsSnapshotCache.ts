@@ -0,0 +1,138 @@
+import { DeviceType, DeviceSettings, _JabraNativeAddonLog, AddonLogSeverity } from '@gnaudio/jabra-node-sdk';
+
+import { nameof } from '../common/util';
+
+/**
+ * Device settings shared by all clients of the server, so that repeated getSettingsAsync
+ * calls are answered without calling into the native addon.
+ *
+ * A snapshot is dropped when the device reports changed settings, when a client calls any
+ * other device method than a getter (it might change settings) and when the device is detached.
+ * Snapshots are only kept while settings change events are enabled for the device, as changes
+ * made on the device itself would otherwise go unnoticed. Only created while enabled with
+ * JabraApiServer.setSettingsCacheEnabled.
+ *
+ * @internal
+ * @hidden
+ */
+export class SettingsSnapshotCache
+{
+    private readonly snapshots = new Map<number, Promise<DeviceSettings>>();
+
+    /**
+     * If settings change events are enabled for a device - undefined until we enabled
+     * them or a client enabled/disabled them.
+     */
+    private readonly changeEventsEnabled = new Map<number, boolean>();
+
+    /**
+     * Our own onSettingsChanged listeners - clients may not be subscribed to the event.
+     */
+    private readonly changeListeners = new Map<number, { device: DeviceType, listener: (guids: string[]) => void }>();
+
+    private disposed: boolean = false;
+
+    /**
+     * Returns true if the device method is answered by this cache.
+     */
+    public static isCached(methodName: string, args: any[]): boolean {
+        return methodName === nameof<DeviceType>("getSettingsAsync") && args.length === 0;
+    }
+
+    public getSettingsAsync(device: DeviceType): Promise<DeviceSettings> {
+        const deviceID = device.deviceID;
+        const cached = this.snapshots.get(deviceID);
+        if (cached) {
+            return cached;
+        }
+
+        const enabled = this.changeEventsEnabled.get(deviceID);
+        if (enabled === false) {
+            return device.getSettingsAsync();
+        }
+
+        const snapshot = (enabled ? Promise.resolve(true) : this.enableChangeEventsAsync(device)).then((cacheable) => {
+            if (!cacheable && this.snapshots.get(deviceID) === snapshot) {
+                this.snapshots.delete(deviceID);
+            }
+            return device.getSettingsAsync();
+        });
+
+        // Concurrent callers share the request in progress. Failures are not cached.
+        this.snapshots.set(deviceID, snapshot);
+        snapshot.catch(() => {
+            if (this.snapshots.get(deviceID) === snapshot) {
+                this.snapshots.delete(deviceID);
+            }
+        });
+
+        return snapshot;
+    }
+
+    /**
+     * Call before and after executing a device method on behalf of a client.
+     */
+    public onDeviceApiCall(device: DeviceType, methodName: string, args: any[]) {
+        if (methodName === nameof<DeviceType>("setSettingsChangeEventsEnabledAsync")) {
+            this.changeEventsEnabled.set(device.deviceID, !!args[0]);
+            this.invalidate(device.deviceID);
+        } else if (!methodName.startsWith("get")) {
+            this.invalidate(device.deviceID);
+        }
+    }
+
+    public invalidate(deviceID: number) {
+        this.snapshots.delete(deviceID);
+    }
+
+    public onDetach(device: DeviceType) {
+        this.snapshots.delete(device.deviceID);
+        this.changeEventsEnabled.delete(device.deviceID);
+        this.removeChangeListener(device.deviceID);
+    }
+
+    /**
+     * Drop everything and stop listening for settings changes - including for requests still in progress.
+     */
+    public dispose() {
+        this.disposed = true;
+        this.snapshots.clear();
+        this.changeEventsEnabled.clear();
+        Array.from(this.changeListeners.keys()).forEach((deviceID) => this.removeChangeListener(deviceID));
+    }
+
+    private addChangeListener(device: DeviceType) {
+        if (!this.changeListeners.has(device.deviceID)) {
+            const listener = () => this.invalidate(device.deviceID);
+            device.on('onSettingsChanged', listener);
+            this.changeListeners.set(device.deviceID, { device, listener });
+        }
+    }
+
+    private removeChangeListener(deviceID: number) {
+        const entry = this.changeListeners.get(deviceID);
+        if (entry) {
+            entry.device.off('onSettingsChanged', entry.listener);
+            this.changeListeners.delete(deviceID);
+        }
+    }
+
+    private enableChangeEventsAsync(device: DeviceType): Promise<boolean> {
+        return device.setSettingsChangeEventsEnabledAsync(true).then(() => {
+            if (this.disposed) {
+                return false;
+            }
+            this.addChangeListener(device);
+
+            // A client may have disabled them meanwhile.
+            if (!this.changeEventsEnabled.has(device.deviceID)) {
+                this.changeEventsEnabled.set(device.deviceID, true);
+            }
+            return this.changeEventsEnabled.get(device.deviceID)!;
+        }).catch((err) => {
+            _JabraNativeAddonLog(AddonLogSeverity.warning, "SettingsSnapshotCache.enableChangeEventsAsync", "Not caching settings of device #" + device.deviceID + " as settings change events could not be enabled: " + err);
+            this.changeEventsEnabled.set(device.deviceID, false);
+            return false;
+        });
+    }
+}
@@ -6,13 +6,17 @@ import { ClassEntry, JabraType, DeviceInfo,
          enumDeviceBtnType, enumFirmwareEventType, enumFirmwareEventStatus, PairedListInfo, enumUploadEventStatus,
          JabraTypeEvents, DeviceTypeEvents, JabraEventsList, DeviceEventsList, DeviceType, MetaApi, MethodEntry, 
          AddonLogSeverity, NativeAddonLogConfig, DeviceTiming, enumRemoteMmiType, enumRemoteMmiInput, DectInfo,
-         enumBTLinkQuality, enumNetworkInterface, enumNetworkInterfaceStatus } from '@gnaudio/jabra-node-sdk';
+         enumBTLinkQuality, enumNetworkInterface, enumNetworkInterfaceStatus, HeadDetectionStatus, LinkConnectionStatus } from '@gnaudio/jabra-node-sdk';
 
 import { getExecuteDeviceTypeApiMethodEventName, getDeviceTypeApiCallabackEventName, getJabraTypeApiCallabackEventName, 
          getExecuteJabraTypeApiMethodEventName, getExecuteJabraTypeApiMethodResponseEventName, 
          getExecuteDeviceTypeApiMethodResponseEventName, createApiClientInitEventName,
+         getExecuteJabraTypeApiSyncMethodEventName, getExecuteDeviceTypeApiSyncMethodEventName, SyncMethodResponse,
          jabraApiClientReadyEventName, jabraLogEventName, ApiClientInitEventData,
-         createApiClientInitResponseEventName } from '../common/ipc';
+         createApiClientInitResponseEventName, jabraDeviceEventBatchPortEventName,
+         jabraDeviceEventSubscriptionEventName } from '../common/ipc';
+
+import { decodeDeviceEventBatch } from '../common/eventbatch';
 
 import { nameof, isBrowser, serializeError } from '../common/util';
 
@@ -155,6 +159,11 @@ interface DeviceTypeExtras {
      * Internal method that is called when a device is deatached.
      */
     _update_detached_time_ms(time_ms: number): void;
+
+    /**
+     * Internal method that emits a device event received in a binary batch.
+     */
+    _emitEvent(eventName: DeviceTypeEvents, ...args: any[]): void;
 }
 
 interface JabraTypeExtras {
@@ -336,6 +345,11 @@ class SimpleEventEmitter<T extends string> {
             callbacks!.splice(findIndex, 1);
         }
     }
+
+    listenerCount(eventName: T): number {
+        let callbacks = this._eventListeners.get(eventName);
+        return callbacks ? callbacks.length : 0;
+    }
     
     removeAllListeners() {
         this._eventListeners.forEach((l) => {
@@ -386,21 +400,15 @@ function doCreateRemoteJabraType(jabraTypeMeta: ClassEntry, deviceTypeMeta: Clas
             // Return our own list of proxies devices for this method !!
             return Array.from(devices.values());
         } else if (methodMeta) {
-            const thisMethodId = methodExecutionId++;
-            let combinedEventArgs = [ methodName, thisMethodId, ...args];
-            ipcRenderer.send(getExecuteJabraTypeApiMethodEventName(), ...combinedEventArgs);
-
             if (methodMeta.jsType===Promise.name) {
+                const thisMethodId = methodExecutionId++;
+                let combinedEventArgs = [ methodName, thisMethodId, ...args];
+                ipcRenderer.send(getExecuteJabraTypeApiMethodEventName(), ...combinedEventArgs);
                 return new Promise(function(resolve, reject) {
                     resultsByExecutionId.set(thisMethodId, { methodName, resolve, reject });
                 });
             } else {
-                // For now, we only need to support async remote method (returning promises). If needed in the future, 
-                // such methods could be easily supported by calling ipcRenderer.sendSync instead and handle that on the server.
-                let error = new Error("This remote client currently only support async remote methods that return promises unlike '" + methodName + "'."); 
-                console.warn(error);
-                JabraNativeAddonLog(ipcRenderer, AddonLogSeverity.error, "doCreateRemoteJabraType.executeApiMethod", error);
-                throw error;
+                return executeSyncApiMethod(ipcRenderer, getExecuteJabraTypeApiSyncMethodEventName(), methodName, args);
             }
         } else {
           JabraNativeAddonLog(ipcRenderer, AddonLogSeverity.error, "doCreateRemoteJabraType.executeApiMethod", "Do not know how to execute " + methodName);
@@ -477,6 +485,14 @@ function doCreateRemoteJabraType(jabraTypeMeta: ClassEntry, deviceTypeMeta: Clas
         emitEvent('firstScanDone');
     });
 
+    const eventBatchPort = openDeviceEventBatchPort(ipcRenderer, (deviceID, eventName, args) => {
+        // Events of devices we have not seen attach (or have seen detach) are ignored.
+        const device = devices.get(deviceID);
+        if (device) {
+            device._emitEvent(eventName, ...args);
+        }
+    });
+
     function shutdown() {
         // Mark this instance.
         shutDownStatus = true;
@@ -490,6 +506,10 @@ function doCreateRemoteJabraType(jabraTypeMeta: ClassEntry, deviceTypeMeta: Clas
             ipcRenderer.removeAllListeners(getJabraTypeApiCallabackEventName(e));
         });
 
+        if (eventBatchPort) {
+            eventBatchPort.close();
+        }
+
         // Unsubscriber everything for each device also:
         devices.forEach( (device, key) => {
             device._shutdown();
@@ -516,6 +536,29 @@ function doCreateRemoteJabraType(jabraTypeMeta: ClassEntry, deviceTypeMeta: Clas
     return new Proxy<JabraType & JabraTypeExtras>(jabraTypeReadonlyProperties as (JabraType & JabraTypeExtras), proxyHandler);
 }
 
+/**
+ * Ask the server to send high-rate device events as binary batches on a MessagePort. Returns
+ * null if this electron version (or the exposed ipcRenderer) can not transfer ports, in which
+ * case the events keep coming as ordinary ipc messages.
+ */
+function openDeviceEventBatchPort(ipcRenderer: IpcRenderer, emit: (deviceID: number, eventName: DeviceTypeEvents, args: any[]) => void): MessagePort | null {
+    if (typeof MessageChannel === 'undefined' || typeof ipcRenderer.postMessage !== 'function') {
+        return null;
+    }
+
+    try {
+        const channel = new MessageChannel();
+        channel.port1.onmessage = (event: MessageEvent) => {
+            decodeDeviceEventBatch(event.data, emit);
+        };
+        ipcRenderer.postMessage(jabraDeviceEventBatchPortEventName, null, [channel.port2]);
+        return channel.port1;
+    } catch (err) {
+        JabraNativeAddonLog(ipcRenderer, AddonLogSeverity.warning, "openDeviceEventBatchPort", err);
+        return null;
+    }
+}
+
 /**
  * Create remote DeviceType using a proxy that forwards events and commands using ipc.
  */
@@ -539,12 +582,22 @@ function createRemoteDeviceType(deviceInfo: DeviceInfo & DeviceTiming, deviceTyp
         eventEmitter.emit(eventName, ...args);
     }
     
+    // The server only forwards device events some client is subscribed to, so tell it when the
+    // first listener of an event is added and when the last one is removed.
     function executeOn(eventName: string, callback: EventCallback) {
+        const firstListener = eventEmitter.listenerCount(eventName as DeviceTypeEvents) === 0;
         eventEmitter.on(eventName as DeviceTypeEvents, callback);
+        if (firstListener && eventEmitter.listenerCount(eventName as DeviceTypeEvents) > 0) {
+            ipcRenderer.send(jabraDeviceEventSubscriptionEventName, deviceInfo.deviceID, eventName, true);
+        }
     }
 
     function executeOff(eventName: string, callback: EventCallback) {
+        const hadListeners = eventEmitter.listenerCount(eventName as DeviceTypeEvents) > 0;
         eventEmitter.off(eventName as DeviceTypeEvents, callback);
+        if (hadListeners && eventEmitter.listenerCount(eventName as DeviceTypeEvents) === 0) {
+            ipcRenderer.send(jabraDeviceEventSubscriptionEventName, deviceInfo.deviceID, eventName, false);
+        }
     }  
     
     function executeApiMethod(methodName: string, methodMeta: MethodEntry, ...args : any[]) : any {
@@ -558,6 +611,9 @@ function createRemoteDeviceType(deviceInfo: DeviceInfo & DeviceTiming, deviceTyp
             const time_ms = args[0];
             // Assign to detached_time_ms even though it is formally a readonly because we don't want clients to change it.
             (deviceInfo.detached_time_ms as DeviceType['detached_time_ms']) = time_ms;
+        } else if (methodName == nameof<DeviceTypeExtras>("_emitEvent"))  {
+            const [eventName, ...eventArgs] = args;
+            emitEvent(eventName, ...eventArgs);
         } else if (methodMeta) {
             const thisMethodExecutionId = methodExecutionId++;
             let combinedEventArgs = [ methodName, thisMethodExecutionId, ...args];
@@ -567,11 +623,7 @@ function createRemoteDeviceType(deviceInfo: DeviceInfo & DeviceTiming, deviceTyp
                     resultsByExecutionId.set(thisMethodExecutionId, { methodName, resolve, reject });
                 });
             } else {
-                // For now, we only need to support async remote method (returning promises). If needed in the future, 
-                // such methods could be easily supported by calling ipcRenderer.sendSync instead and handle that on the server.
-                let error = new Error("This remote client currently only support async remote methods that return promises unlike '" + methodName + "'.");
-                JabraNativeAddonLog(ipcRenderer, AddonLogSeverity.error, "createRemoteDeviceType.executeApiMethod", error);
-                throw error;
+                return executeSyncApiMethod(ipcRenderer, getExecuteDeviceTypeApiSyncMethodEventName(deviceInfo.deviceID), methodName, args);
             }
         } else {
             JabraNativeAddonLog(ipcRenderer, AddonLogSeverity.error, "createRemoteDeviceType.executeApiMethod", "Do not know how to execute " + methodName);
@@ -667,6 +719,22 @@ function createRemoteDeviceType(deviceInfo: DeviceInfo & DeviceTiming, deviceTyp
         emitEvent('onBluetoothLinkQualityChangeEvent', linkQuality);
     });
 
+    ipcRenderer.on(getDeviceTypeApiCallabackEventName('onSettingsChanged', deviceInfo.deviceID), (event, guids: string[]) => {
+        emitEvent('onSettingsChanged', guids);
+    });
+
+    ipcRenderer.on(getDeviceTypeApiCallabackEventName('onHeadDetectionStatusEvent', deviceInfo.deviceID), (event, status: HeadDetectionStatus) => {
+        emitEvent('onHeadDetectionStatusEvent', status);
+    });
+
+    ipcRenderer.on(getDeviceTypeApiCallabackEventName('onJackConnectorStatusEvent', deviceInfo.deviceID), (event, inserted: boolean) => {
+        emitEvent('onJackConnectorStatusEvent', inserted);
+    });
+
+    ipcRenderer.on(getDeviceTypeApiCallabackEventName('onLinkConnectionStatusEvent', deviceInfo.deviceID), (event, status: LinkConnectionStatus) => {
+        emitEvent('onLinkConnectionStatusEvent', status);
+    });
+
     ipcRenderer.on(getDeviceTypeApiCallabackEventName('onDiagLogEvent', deviceInfo.deviceID), (event) => {
         emitEvent('onDiagLogEvent');
     });
@@ -693,8 +761,11 @@ function createRemoteDeviceType(deviceInfo: DeviceInfo & DeviceTiming, deviceTyp
         // Signal that device is no longer valid:
         shutDownStatus = true;
 
-        // Remove all event subscriptions:
+        // Remove all event subscriptions (the server drops those of detached devices itself):
         DeviceEventsList.forEach((e) => {
+            if (!deviceInfo.detached_time_ms && eventEmitter.listenerCount(e) > 0) {
+                ipcRenderer.send(jabraDeviceEventSubscriptionEventName, deviceInfo.deviceID, e, false);
+            }
             ipcRenderer.removeAllListeners(getDeviceTypeApiCallabackEventName(e, deviceInfo.deviceID));
         });
 
@@ -717,6 +788,23 @@ function createRemoteDeviceType(deviceInfo: DeviceInfo & DeviceTiming, deviceTyp
     return new Proxy<DeviceType & DeviceTypeExtras>(deviceInfo as (DeviceType & DeviceTypeExtras), proxyHandler);
 }
 
+/**
+ * Execute a synchronous remote method. This blocks the renderer until the main process has
+ * answered - the synchronous api methods only return data already held by the main process.
+ */
+function executeSyncApiMethod(ipcRenderer: IpcRenderer, channel: string, methodName: string, args: any[]): any {
+    const response: SyncMethodResponse = ipcRenderer.sendSync(channel, methodName, ...args);
+
+    // First make it easier to debug/inspect results:
+    addToStringToDeserializedObject(response.err);
+    addToStringToDeserializedObject(response.result);
+
+    if (response.err) {
+        throw deserializeError(response.err as SerializedError);
+    }
+    return response.result;
+}
+
 /**
  * Patch deserialized object to make it more friendly to use.
  */
@@ -0,0 +1,86 @@
+import { DeviceTypeEvents } from '@gnaudio/jabra-node-sdk';
+
+import { DeviceEventBatchEncoder, decodeDeviceEventBatch, isBatchedDeviceEvent } from '../common/eventbatch';
+
+type DecodedEvent = { deviceID: number, event: DeviceTypeEvents, args: any[] };
+
+/**
+ * Arguments as emitted by DeviceType for every batched event - including negative and extreme values.
+ */
+const batchedEvents: Array<[DeviceTypeEvents, any[]]> = [
+    ['btnPress', [-1, true]],
+    ['busyLightChange', [false]],
+    ['downloadFirmwareProgress', [2, -3, 100]],
+    ['onBatteryStatusUpdate', [-2147483648, true, false]],
+    ['onRemoteMmiEvent', [1, -7]],
+    ['onxpressConnectionStatusEvent', [true]],
+    ['onUploadProgress', [0, 2147483647]],
+    ['onCameraStatusEvent', [false]],
+    ['onBluetoothLinkQualityChangeEvent', [-4]],
+    ['onNetworkStatusChangedEvent', [3, -1]],
+    ['onHeadDetectionStatusEvent', [{ leftOn: true, rightOn: false }]],
+    ['onJackConnectorStatusEvent', [true]],
+    ['onLinkConnectionStatusEvent', [{ open: false, component: -2 }]]
+];
+
+function roundTrip(encoder: DeviceEventBatchEncoder): DecodedEvent[] {
+    const decoded: DecodedEvent[] = [];
+    decodeDeviceEventBatch(encoder.take(), (deviceID, event, args) => {
+        decoded.push({ deviceID, event, args });
+    });
+    return decoded;
+}
+
+test('every batched event survives an encode/decode round trip', () => {
+    const encoder = new DeviceEventBatchEncoder();
+    batchedEvents.forEach(([event, args], i) => {
+        expect(isBatchedDeviceEvent(event)).toBe(true);
+        expect(encoder.add(i, event, args)).toBe(true);
+    });
+
+    expect(encoder.isEmpty()).toBe(false);
+    expect(roundTrip(encoder)).toEqual(batchedEvents.map(([event, args], i) => ({ deviceID: i, event, args })));
+});
+
+test('events of different devices keep their order', () => {
+    const encoder = new DeviceEventBatchEncoder();
+    encoder.add(65535, 'btnPress', [5, false]);
+    encoder.add(0, 'onBatteryStatusUpdate', [50, false, true]);
+    encoder.add(65535, 'btnPress', [-5, true]);
+
+    expect(roundTrip(encoder)).toEqual([
+        { deviceID: 65535, event: 'btnPress', args: [5, false] },
+        { deviceID: 0, event: 'onBatteryStatusUpdate', args: [50, false, true] },
+        { deviceID: 65535, event: 'btnPress', args: [-5, true] }
+    ]);
+});
+
+test('an empty batch decodes to no events', () => {
+    const encoder = new DeviceEventBatchEncoder();
+    expect(encoder.isEmpty()).toBe(true);
+
+    const buffer = encoder.take();
+    expect(buffer.byteLength).toBe(0);
+
+    const emit = jest.fn();
+    decodeDeviceEventBatch(buffer, emit);
+    expect(emit).not.toHaveBeenCalled();
+});
+
+test('take starts a new batch', () => {
+    const encoder = new DeviceEventBatchEncoder();
+    encoder.add(1, 'onCameraStatusEvent', [true]);
+    encoder.take();
+
+    expect(encoder.isEmpty()).toBe(true);
+    expect(roundTrip(encoder)).toEqual([]);
+});
+
+test('events with other arguments are not batched', () => {
+    const encoder = new DeviceEventBatchEncoder();
+    (['onDevLogEvent', 'onBTParingListChange', 'onSettingsChanged', 'onDectInfoEvent'] as DeviceTypeEvents[]).forEach((event) => {
+        expect(isBatchedDeviceEvent(event)).toBe(false);
+        expect(encoder.add(1, event, ['{}'])).toBe(false);
+    });
+    expect(encoder.isEmpty()).toBe(true);
+});
@@ -20,3 +20,44 @@ test('init, version and clean dispose', async () => {
 });
 
 
+
+test('perf stats have the documented shape', async () => {
+  let config: ConfigParamsCloud = {
+    blockAllNetworkAccess: true
+  };
+
+  let app = await createJabraApplication('A7tSsfD42VenLagL2mM6i2f0VafP/842cbuPCnC+uE8=', config);
+
+  try {
+    app.resetPerfStats();
+    expect(app.getPerfStats()).toEqual({});
+
+    await app.getSDKVersionAsync();
+
+    const stats = app.getPerfStats();
+    const functionNames = Object.keys(stats);
+    expect(functionNames.length).toBeGreaterThan(0);
+
+    functionNames.forEach((functionName) => {
+      const phases = Object.keys(stats[functionName]);
+      expect(phases.length).toBeGreaterThan(0);
+      phases.forEach((phase) => {
+        expect(['queue', 'execute', 'mapping', 'callback']).toContain(phase);
+
+        const phaseStats = (stats[functionName] as any)[phase];
+        expect(phaseStats.count).toBeGreaterThan(0);
+        ['meanUs', 'p50Us', 'p90Us', 'p99Us', 'maxUs'].forEach((field) => {
+          expect(typeof phaseStats[field]).toBe('number');
+        });
+        expect(phaseStats.p50Us).toBeLessThanOrEqual(phaseStats.p90Us);
+        expect(phaseStats.p90Us).toBeLessThanOrEqual(phaseStats.p99Us);
+        expect(phaseStats.p99Us).toBeLessThanOrEqual(phaseStats.maxUs);
+      });
+    });
+
+    app.resetPerfStats();
+    expect(app.getPerfStats()).toEqual({});
+  } finally {
+    await app.disposeAsync();
+  }
+});
@@ -1,5 +1,6 @@
 import { createJabraApplication, DeviceType, JabraType, jabraEnums, 
-         enumAPIReturnCode, ConfigParamsCloud } from '@gnaudio/jabra-node-sdk';
+         enumAPIReturnCode, ConfigParamsCloud, JabraEventsList, DeviceEventsList, toHexString,
+         _JabraSetNativeAddonLogSeverity, _JabraSetNativeAddonLogCategory } from '@gnaudio/jabra-node-sdk';
 
 test('exported standard members ok', async () => {
     expect(createJabraApplication).toBeTruthy();
@@ -9,4 +10,22 @@ test('exported standard members ok', async () => {
     expect(DeviceType).toBeTruthy();
     expect(JabraType).toBeTruthy(); 
 });
-  
\ No newline at end of file
+
+test('exported event lists and helpers ok', async () => {
+    expect(JabraEventsList).toContain('eventTiming');
+    expect(DeviceEventsList).toContain('onHeadDetectionStatusEvent');
+    expect(DeviceEventsList).toContain('onJackConnectorStatusEvent');
+    expect(DeviceEventsList).toContain('onLinkConnectionStatusEvent');
+    expect(typeof toHexString).toBe('function');
+    expect(typeof _JabraSetNativeAddonLogSeverity).toBe('function');
+    expect(typeof _JabraSetNativeAddonLogCategory).toBe('function');
+});
+
+test('exported methods ok', async () => {
+    ['getExecutorStats', 'getPerfStats', 'resetPerfStats', 'getEventChannelStats', 'setEventFilter'].forEach((name) => {
+        expect(typeof (JabraType.prototype as any)[name]).toBe('function');
+    });
+    ['getCachedInfo', 'getCapabilities', 'getSnapshotAsync', 'getSettingsSchemaAsync', 'getSettingValuesAsync', 'getConstantsTreeAsync'].forEach((name) => {
+        expect(typeof (DeviceType.prototype as any)[name]).toBe('function');
+    });
+});
@@ -1,10 +1,49 @@
+import * as path from 'path';
 
+import { _JabraNativeAddonLog, _JabraGetNativeAddonLogConfig, _JabraSetNativeAddonLogSeverity,
+         _JabraSetNativeAddonLogCategory, AddonLogSeverity } from '@gnaudio/jabra-node-sdk';
 
-import { _JabraNativeAddonLog, AddonLogSeverity } from '@gnaudio/jabra-node-sdk';
+// The native addon of the sdk - the public log wrappers swallow errors, so check it directly.
+const sdkRoot = path.dirname(require.resolve('@gnaudio/jabra-node-sdk/package.json'));
+const sdkIntegration = require(require.resolve('bindings', { paths: [sdkRoot] }))({ bindings: 'sdkintegration', module_root: sdkRoot });
 
 test('native logging works', async () => {
     expect(_JabraNativeAddonLog).toBeTruthy();
     
     // Verify that we can call method without exceptions.
     _JabraNativeAddonLog(AddonLogSeverity.info, "TESTING", "test function called");
-});
\ No newline at end of file
+});
+
+test('log severity can be changed at runtime', () => {
+    const originalSeverity = sdkIntegration.GetNativeAddonLogConfig().maxSeverity;
+    try {
+        sdkIntegration.SetNativeAddonLogSeverity(AddonLogSeverity.debug);
+        expect(sdkIntegration.NativeAddonLogSeverityGate[0]).toBe(AddonLogSeverity.debug);
+        expect(sdkIntegration.GetNativeAddonLogConfig().maxSeverity).toBe(AddonLogSeverity.debug);
+
+        _JabraSetNativeAddonLogSeverity(AddonLogSeverity.warning);
+        expect(sdkIntegration.NativeAddonLogSeverityGate[0]).toBe(AddonLogSeverity.warning);
+        expect(_JabraGetNativeAddonLogConfig()!.maxSeverity).toBe(AddonLogSeverity.warning);
+    } finally {
+        sdkIntegration.SetNativeAddonLogSeverity(originalSeverity);
+    }
+});
+
+test('log category can be changed at runtime', () => {
+    const originalCategory = sdkIntegration.GetNativeAddonLogConfig().categories.device;
+    try {
+        sdkIntegration.SetNativeAddonLogCategory("device", AddonLogSeverity.verbose, 10);
+        const category = sdkIntegration.GetNativeAddonLogConfig().categories.device;
+        expect(category.maxSeverity).toBe(AddonLogSeverity.verbose);
+        expect(category.sampleEvery).toBe(10);
+    } finally {
+        sdkIntegration.SetNativeAddonLogCategory("device", originalCategory.maxSeverity, originalCategory.sampleEvery);
+    }
+});
+
+test('unknown log category is rejected', () => {
+    expect(() => sdkIntegration.SetNativeAddonLogCategory("nonexisting", AddonLogSeverity.info)).toThrow(TypeError);
+
+    // The public wrapper only logs the error.
+    expect(() => _JabraSetNativeAddonLogCategory("nonexisting" as any, AddonLogSeverity.info)).not.toThrow();
+});
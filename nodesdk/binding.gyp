@@ -166,6 +166,38 @@
          ]
         }],
       ]
+    },
+    {
+      "target_name": "jabra-log-decode",
+      "type": "executable",
+      "cflags_cc": [
+        "-std=c++14"
+      ],
+      "sources": [ "src/tools/jabralogdecode.cc" ],
+      "include_dirs": [
+        "src/main",
+        "includes",
+      ],
+      'conditions': [
+        ['OS=="win"', {
+          'defines': [ '_HAS_EXCEPTIONS=1' ],
+          'msvs_settings': {
+            'VCCLCompilerTool': { 'ExceptionHandling': 1 },
+          },
+        }],
+        ['OS=="linux"', {
+          'cflags_cc': [
+            '-fexceptions'
+          ],
+        }],
+        ['OS=="mac"', {
+          'xcode_settings': {
+            'GCC_ENABLE_CPP_EXCEPTIONS': 'YES',
+            'CLANG_CXX_LIBRARY': 'libc++',
+            'MACOSX_DEPLOYMENT_TARGET': '10.7',
+          },
+        }],
+      ]
     }
   ]
 }
@@ -1,42 +1,41 @@
 #include "stdafx.h"
 #include <unordered_map>
+#include <algorithm>
+#include <memory>
+#include <atomic>
 #include <chrono>
 #include <string.h>
 #include "bt.h"
 #include "app.h"
 #include "device.h"
 #include "deviceconstants.h"
+#include "deviceregistry.h"
+#include "eventchannel.h"
+#include "eventsubscriptions.h"
+#include "jsonwriter.h"
+#include "settings.h"
+#include "propertykeys.h"
+
+// Default bound on the number of undelivered events (see eventDelivery.maxQueueSize).
+static const int32_t DEFAULT_EVENT_QUEUE_SIZE = 4096;
 
 // -----------------------------------------------------------
 
 /**
  * Holds all init state to pass between threads, including
  * all paramters to Jabra_Initialize, Jabra_SetAppID and
- * all event handler functions.
+ * the event channel delivering events to javascript.
  */
 class StateJabraInitialize {
   private:
   Napi::Env env;
 
   std::string appId;
-  ThreadSafeCallback *initializedCallback;
-  ThreadSafeCallback *firstScanDoneCallback;
-  ThreadSafeCallback *attachedCallback;
-  ThreadSafeCallback *deAttachedCallback;
-  ThreadSafeCallback *buttonInDataTranslatedCallback;
-  ThreadSafeCallback *devLogCallback;
-  ThreadSafeCallback *diagLogCallback;
-  ThreadSafeCallback *batteryStatusCallback;
-  ThreadSafeCallback *remoteMmiCallback;
-  ThreadSafeCallback *xpressConnectionStatusCallback;
-  ThreadSafeCallback *downloadFirmwareProgressCallback;
-  ThreadSafeCallback *uploadProgressCallback;
-  ThreadSafeCallback *registerPairingListCallback;
-  ThreadSafeCallback *gNPButtonEventCallBack;
-  ThreadSafeCallback *dectInfoCallback;
-  ThreadSafeCallback *cameraStatusCallback;
-  ThreadSafeCallback *bluetoothLinkQualityChangeCallback;
-  ThreadSafeCallback *networkStatusChangeCallback;
+
+  // Owned on the main thread, posted to from sdk threads through activeEventChannel.
+  std::shared_ptr<EventChannel> eventChannel;
+  std::atomic<EventChannel*> activeEventChannel;
+  std::atomic<unsigned int> activePosters;
 
   std::string proxy;
   std::string baseUrl_capabilities;
@@ -45,57 +44,16 @@ class StateJabraInitialize {
   bool nonJabraDeviceDectection;
 
   bool initializationStartedState;
-  
-  static void releaseCallback(ThreadSafeCallback* & callback) {
-    if (callback) {
-      ThreadSafeCallback* exception_safe_copy = callback;
-      callback = nullptr;
-      delete exception_safe_copy;
-    }
-  }
 
   public:
   StateJabraInitialize() : env(NULL), 
-                           initializedCallback(nullptr),
-                           firstScanDoneCallback(nullptr),
-                           attachedCallback(nullptr),
-                           deAttachedCallback(nullptr),
-                           buttonInDataTranslatedCallback(nullptr),
-                           devLogCallback(nullptr),
-                           diagLogCallback(nullptr),
-                           batteryStatusCallback(nullptr),
-                           remoteMmiCallback(nullptr),
-                           xpressConnectionStatusCallback(nullptr),
-                           downloadFirmwareProgressCallback(nullptr),
-                           uploadProgressCallback(nullptr),
-                           registerPairingListCallback(nullptr),
-                           gNPButtonEventCallBack(nullptr),
-                           dectInfoCallback(nullptr),
-                           cameraStatusCallback(nullptr),
-                           bluetoothLinkQualityChangeCallback(nullptr),
-                           networkStatusChangeCallback(nullptr),
+                           activeEventChannel(nullptr),
+                           activePosters(0),
                            initializationStartedState(false) {}
 
   void set(const Napi::Env& _env,
            const std::string& _appId,
-           ThreadSafeCallback* _initializedCallback,
-           ThreadSafeCallback* _firstScanDoneCallback,
-           ThreadSafeCallback* _attachedCallback,
-           ThreadSafeCallback* _deAttachedCallback,
-           ThreadSafeCallback* _buttonInDataTranslatedCallback,
-           ThreadSafeCallback* _devLogCallback,
-           ThreadSafeCallback* _diagLogCallback,
-           ThreadSafeCallback* _batteryStatusCallback,
-           ThreadSafeCallback* _remoteMmiCallback,
-           ThreadSafeCallback* _xpressConnectionStatusCallback,
-           ThreadSafeCallback* _downloadFirmwareProgressCallback,
-           ThreadSafeCallback* _uploadProgressCallback,
-           ThreadSafeCallback* _registerPairingListCallback,
-           ThreadSafeCallback* _gNPButtonEventCallBack,
-           ThreadSafeCallback* _dectInfoCallback,
-           ThreadSafeCallback* _cameraStatusCallback,
-           ThreadSafeCallback* _bluetoothLinkQualityChangeCallback,
-           ThreadSafeCallback* _networkStatusChangeCallback,
+           const std::shared_ptr<EventChannel>& _eventChannel,
            const std::string& _proxy,
            const std::string& _baseUrl_capabilities,
            const std::string& _baseUrl_fw,
@@ -105,24 +63,8 @@ class StateJabraInitialize {
       env = _env;
       appId = _appId;
 
-      initializedCallback = _initializedCallback;
-      firstScanDoneCallback = _firstScanDoneCallback;
-      attachedCallback = _attachedCallback;
-      deAttachedCallback = _deAttachedCallback;
-      buttonInDataTranslatedCallback = _buttonInDataTranslatedCallback;
-      devLogCallback = _devLogCallback;
-      diagLogCallback = _diagLogCallback;
-      batteryStatusCallback = _batteryStatusCallback;
-      remoteMmiCallback = _remoteMmiCallback;
-      xpressConnectionStatusCallback = _xpressConnectionStatusCallback;
-      downloadFirmwareProgressCallback = _downloadFirmwareProgressCallback;
-      uploadProgressCallback = _uploadProgressCallback;
-      registerPairingListCallback = _registerPairingListCallback;
-      gNPButtonEventCallBack = _gNPButtonEventCallBack;
-      dectInfoCallback = _dectInfoCallback;
-      cameraStatusCallback = _cameraStatusCallback;
-      bluetoothLinkQualityChangeCallback = _bluetoothLinkQualityChangeCallback;
-      networkStatusChangeCallback = _networkStatusChangeCallback;
+      eventChannel = _eventChannel;
+      activeEventChannel = eventChannel.get();
 
       proxy = _proxy;
       baseUrl_capabilities = _baseUrl_capabilities;
@@ -143,76 +85,38 @@ class StateJabraInitialize {
     return appId;
   }
 
-  ThreadSafeCallback * getInitializedCallback() {
-    return initializedCallback;
-  }
-
-  ThreadSafeCallback * getFirstScanDoneCallback() {
-    return firstScanDoneCallback;
-  }
-
-  ThreadSafeCallback * getAttachedCallback() {
-    return attachedCallback;
-  }
-
-  ThreadSafeCallback * getDeAttachedCallback() {
-    return deAttachedCallback;
-  }
-
-  ThreadSafeCallback * getButtonInDataTranslatedCallback() {
-    return buttonInDataTranslatedCallback;
-  }
-
-  ThreadSafeCallback * getDevLogCallback() {
-    return devLogCallback;
-  }
-
-  ThreadSafeCallback * getDiagnosticLogCallback() {
-    return diagLogCallback;
-  }
-
-  ThreadSafeCallback * getBatteryStatusCallback() {
-    return batteryStatusCallback;
-  }
-
-  ThreadSafeCallback * getRemoteMmiCallback () {
-    return remoteMmiCallback;
-  }
-  
-  ThreadSafeCallback * getXpressConnectionStatusCallback () {
-    return xpressConnectionStatusCallback;
-  } 
-
-  ThreadSafeCallback * getDownloadFirmwareProgressCallback() {
-    return downloadFirmwareProgressCallback;
-  }
-
-  ThreadSafeCallback * getUploadProgressCallback() {
-    return uploadProgressCallback;
-  }
-
-  ThreadSafeCallback * getRegisterPairingListCallback() {
-    return registerPairingListCallback;
-  }
-
-  ThreadSafeCallback * getGNPButtonEventCallBack() {
-    return gNPButtonEventCallBack;
-  }
-
-  ThreadSafeCallback * getDectInfoCallBack() {
-    return dectInfoCallback;
+  // Needs to be called from main thread.
+  std::shared_ptr<EventChannel> getEventChannel() {
+    return eventChannel;
   }
 
-  ThreadSafeCallback * getCameraStatusCallback() {
-    return cameraStatusCallback;
+  /**
+   * Post an event to javascript - safe to call from any thread. Ignored if not initialized.
+   */
+  void post(EventType type, uint32_t key, const EventChannel::ArgFunc& argFunc) {
+    ++activePosters;
+    EventChannel* channel = activeEventChannel;
+    if (channel) {
+      channel->post(type, key, argFunc);
+    }
+    --activePosters;
   }
 
-  ThreadSafeCallback * getBluetoothLinkQualityChangeCallback() {
-    return bluetoothLinkQualityChangeCallback;
+  void post(EventType type, const EventChannel::ArgFunc& argFunc) {
+    post(type, 0, argFunc);
   }
 
-  ThreadSafeCallback * getnetworkStatusChangeCallback() {
-    return networkStatusChangeCallback;
+  /**
+   * Post a fixed size event record to javascript without locking or allocation - safe to call
+   * from any thread. Ignored if not initialized.
+   */
+  void post(EventType type, uint32_t key, const EventRecord& record, const char * text = nullptr, size_t textLength = 0) {
+    ++activePosters;
+    EventChannel* channel = activeEventChannel;
+    if (channel) {
+      channel->post(type, key, record, text, textLength);
+    }
+    --activePosters;
   }
 
   std::string& getProxy() {
@@ -239,24 +143,16 @@ class StateJabraInitialize {
   // to make sure the node process won't block on exit).
   // Needs to be called from main thread.
   void done() {
-    releaseCallback(initializedCallback);
-    releaseCallback(firstScanDoneCallback);
-    releaseCallback(attachedCallback);
-    releaseCallback(deAttachedCallback);
-    releaseCallback(buttonInDataTranslatedCallback);
-    releaseCallback(devLogCallback);
-    releaseCallback(diagLogCallback);
-    releaseCallback(batteryStatusCallback);
-    releaseCallback(remoteMmiCallback);
-    releaseCallback(xpressConnectionStatusCallback);
-    releaseCallback(downloadFirmwareProgressCallback);
-    releaseCallback(uploadProgressCallback);
-    releaseCallback(registerPairingListCallback);
-    releaseCallback(gNPButtonEventCallBack);
-    releaseCallback(dectInfoCallback);
-    releaseCallback(cameraStatusCallback);
-    releaseCallback(bluetoothLinkQualityChangeCallback);
-    releaseCallback(networkStatusChangeCallback);
+    // Wait for posts in progress on sdk threads before the channel can be closed and freed.
+    activeEventChannel = nullptr;
+    while (activePosters != 0) {
+      std::this_thread::yield();
+    }
+
+    if (eventChannel) {
+      eventChannel->close();
+      eventChannel.reset();
+    }
  
     // Re-allow init again.
     initializationStartedState = false;
@@ -270,50 +166,409 @@ static std::uint64_t getTimeSinceEpoc() {
    return std::chrono::system_clock::now().time_since_epoch() / std::chrono::milliseconds(1);
 }
 
+// Json dumps of native event data (for logging purposes).
+
+static std::string toString(const ManagedPairingList& src) {
+  util::JsonWriter json;
+  json.beginObject();
+  json.field("listType", (int)src.listType);
+  json.key("pairedDevice").beginArray();
+  for (const ManagedPairedDevice& device : src.pairedDevice) {
+    json.beginObject();
+    json.field("deviceName", device.deviceName);
+    json.field("deviceBTAddr", toBTAddrString(device.deviceBTAddr.data(), device.deviceBTAddr.size()));
+    json.field("isConnected", device.isConnected);
+    json.endObject();
+  }
+  json.endArray();
+  json.endObject();
+  return json.take();
+}
+
+static std::string toString(const ButtonEvent& src) {
+  util::JsonWriter json;
+  json.beginArray();
+  for (int i=0; i<src.buttonEventCount; ++i) {
+    const ButtonEventInfo& info = src.buttonEventInfo[i];
+    json.beginObject();
+    json.field("buttonTypeKey", info.buttonTypeKey);
+    json.field("buttonTypeValue", info.buttonTypeValue);
+    json.key("buttonEventType").beginArray();
+    for (int j=0; j<info.buttonEventTypeSize; ++j) {
+      json.beginObject();
+      json.field("key", info.buttonEventType[j].key);
+      json.field("value", info.buttonEventType[j].value);
+      json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+  }
+  json.endArray();
+  return json.take();
+}
+
+static std::string toString(const Jabra_DectInfo& src) {
+  util::JsonWriter json;
+  json.beginObject();
+  switch (src.DectType) {
+    case DectDensity:
+      json.field("kind", "density");
+      json.field("sumMeasuredRSSI", src.DectDensity.SumMeasuredRSSI);
+      json.field("maximumReferenceRSSI", src.DectDensity.MaximumReferenceRSSI);
+      json.field("numberMeasuredSlots", src.DectDensity.NumberMeasuredSlots);
+      json.field("dataAgeSeconds", src.DectDensity.DataAgeSeconds);
+      break;
+    case DectErrorCount:
+      json.field("kind", "errorCount");
+      json.field("syncErrors", src.DectErrorCount.syncErrors);
+      json.field("aErrors", src.DectErrorCount.aErrors);
+      json.field("xErrors", src.DectErrorCount.xErrors);
+      json.field("zErrors", src.DectErrorCount.zErrors);
+      json.field("hubSyncErrors", src.DectErrorCount.hubSyncErrors);
+      json.field("hubAErrors", src.DectErrorCount.hubAErrors);
+      json.field("handoversCount", src.DectErrorCount.handoversCount);
+      break;
+    default:
+      json.field("kind", (int)src.DectType);
+  }
+  json.field("rawDataLen", src.RawDataLen);
+  json.endObject();
+  return json.take();
+}
+
+// Decoders for the event records posted from sdk threads - run on the javascript main thread.
+
+static void decodeEventTime(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, (double)record.payload.eventTime) };
+}
+
+static void decodeDeviceEventTime(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, record.deviceId), Napi::Number::New(env, (double)record.payload.eventTime) };
+}
+
+static void decodeDevice(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, record.deviceId) };
+}
+
+static void decodeDeviceText(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, record.deviceId), Napi::String::New(env, record.text, record.textLength) };
+}
+
+static void decodeDeviceValue(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, record.deviceId), Napi::Number::New(env, record.payload.value) };
+}
+
+static void decodeDeviceStatus(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, record.deviceId), Napi::Boolean::New(env, record.payload.status) };
+}
+
+static void decodeButtonInDataTranslated(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, record.deviceId), Napi::Number::New(env, record.payload.button.translatedInData), Napi::Boolean::New(env, record.payload.button.buttonInData) };
+}
+
+static void decodeBatteryStatus(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, record.deviceId), Napi::Number::New(env, record.payload.battery.levelInPercent), Napi::Boolean::New(env, record.payload.battery.charging), Napi::Boolean::New(env, record.payload.battery.batteryLow) };
+}
+
+static void decodeRemoteMmi(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, record.deviceId), Napi::Number::New(env, record.payload.remoteMmi.type), Napi::Number::New(env, record.payload.remoteMmi.input) };
+}
+
+static void decodeFirmwareProgress(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, record.deviceId), Napi::Number::New(env, record.payload.progress.type), Napi::Number::New(env, record.payload.progress.status), Napi::Number::New(env, record.payload.progress.percentage) };
+}
+
+static void decodeUploadProgress(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, record.deviceId), Napi::Number::New(env, record.payload.progress.status), Napi::Number::New(env, record.payload.progress.percentage) };
+}
+
+static void decodeNetworkStatus(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  args = { Napi::Number::New(env, record.deviceId), Napi::Number::New(env, record.payload.network.phy), Napi::Number::New(env, record.payload.network.status) };
+}
+
+static void decodeHeadDetection(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  Napi::Object status = Napi::Object::New(env);
+  status.Set(Napi::String::New(env, "leftOn"), Napi::Boolean::New(env, record.payload.headDetection.leftOn));
+  status.Set(Napi::String::New(env, "rightOn"), Napi::Boolean::New(env, record.payload.headDetection.rightOn));
+  args = { Napi::Number::New(env, record.deviceId), status };
+}
+
+static void decodeLinkConnection(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  Napi::Object status = Napi::Object::New(env);
+  status.Set(Napi::String::New(env, "open"), Napi::Boolean::New(env, record.payload.linkConnection.open));
+  status.Set(Napi::String::New(env, "component"), Napi::Number::New(env, record.payload.linkConnection.component));
+  args = { Napi::Number::New(env, record.deviceId), status };
+}
+
+static void decodeDectInfo(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args) {
+  const Jabra_DectInfo& dectInfoStack = record.payload.dectInfo;
+  util::ObjectBuilder dectInfoNapi(env, keys);
+
+  const size_t rawDataLen = std::min<size_t>(dectInfoStack.RawDataLen, sizeof(dectInfoStack.RawData));
+  dectInfoNapi.set(PropertyKey::rawData, util::newUint8Array(env, dectInfoStack.RawData, rawDataLen));
+
+  switch (dectInfoStack.DectType) {
+    case DectDensity: {
+      const Jabra_DectInfoDensity& dectDensity = dectInfoStack.DectDensity;
+      dectInfoNapi.set(PropertyKey::kind, keys[PropertyKey::density]);
+      dectInfoNapi.set(PropertyKey::sumMeasuredRSSI, Napi::Number::New(env, dectDensity.SumMeasuredRSSI));
+      dectInfoNapi.set(PropertyKey::maximumReferenceRSSI, Napi::Number::New(env, dectDensity.MaximumReferenceRSSI));
+      dectInfoNapi.set(PropertyKey::numberMeasuredSlots, Napi::Number::New(env, dectDensity.NumberMeasuredSlots));
+      dectInfoNapi.set(PropertyKey::dataAgeSeconds, Napi::Number::New(env, dectDensity.DataAgeSeconds));
+      break;
+    }
+
+    case DectErrorCount: {
+      const Jabra_DectErrorCount& dectError = dectInfoStack.DectErrorCount;
+      dectInfoNapi.set(PropertyKey::kind, keys[PropertyKey::errorCount]);
+      dectInfoNapi.set(PropertyKey::syncErrors, Napi::Number::New(env, dectError.syncErrors));
+      dectInfoNapi.set(PropertyKey::aErrors, Napi::Number::New(env, dectError.aErrors));
+      dectInfoNapi.set(PropertyKey::xErrors, Napi::Number::New(env, dectError.xErrors));
+      dectInfoNapi.set(PropertyKey::zErrors, Napi::Number::New(env, dectError.zErrors));
+      dectInfoNapi.set(PropertyKey::hubSyncErrors, Napi::Number::New(env, dectError.hubSyncErrors));
+      dectInfoNapi.set(PropertyKey::hubAErrors, Napi::Number::New(env, dectError.hubAErrors));
+      dectInfoNapi.set(PropertyKey::handoversCount, Napi::Number::New(env, dectError.handoversCount));
+      break;
+    }
+  }
+
+  args = { Napi::Number::New(env, record.deviceId), dectInfoNapi.build() };
+}
+
 /** 
  * As a hack, use global to pass state between thread and callbacks. Could be avoided if
  * the Jabra SDK c-type callbacks could be extended with a arbitary context parameter.
  */
 static StateJabraInitialize state_Jabra_Initialize;
 
+/**
+ * Post a state event unless the event filter throttles it - throttled events are posted later
+ * through the throttled event poster.
+ */
+static void postStateEvent(EventType type, uint32_t key, const EventRecord& record) {
+  if (!throttleEvent(type, key, record)) {
+    state_Jabra_Initialize.post(type, key, record);
+  }
+}
+
 LinkQualityStatusListener& internalCallbackManager::getLinkQualityCallback()
 {
   static LinkQualityStatusListener BTLinkQualityChangeEventCallback = [](unsigned short deviceID, LinkQuality status)
   {
     try {
-      LOG_VERBOSE_(LOGINSTANCE) << "BTLinkQualityChangeEventCallback got LinkQuality = " << status;
-
-      auto callback = state_Jabra_Initialize.getBluetoothLinkQualityChangeCallback();
-      if (callback) {
-        callback->call([deviceID, status](Napi::Env env, std::vector<napi_value>& args) {
-          args = { Napi::Number::New(env, deviceID), Napi::Number::New(env, status)};
-        });
+      if (!shouldPostEvent(EventType::BluetoothLinkQuality, deviceID)) {
+        return;
       }
-      LOG_VERBOSE_(LOGINSTANCE) << "BTLinkQualityChangeEventCallback handling finished";
+      const uint64_t firedNs = eventClockNs();
+      LOG_SAMPLED_CAT_(LogCategory::bt, plog::verbose) << "BTLinkQualityChangeEventCallback got LinkQuality = " << status;
+
+      EventRecord record = {};
+      record.firedNs = firedNs;
+      record.decode = &decodeDeviceValue;
+      record.deviceId = deviceID;
+      record.payload.value = status;
+      postStateEvent(EventType::BluetoothLinkQuality, deviceID, record);
+      LOG_SAMPLED_CAT_(LogCategory::bt, plog::verbose) << "BTLinkQualityChangeEventCallback handling finished";
     } catch (const std::exception &e) {
       const std::string errorMsg = "BTLinkQualityChangeEventCallback failed: " + std::string(e.what());
-      LOG_FATAL_(LOGINSTANCE) << errorMsg;
+      LOG_FATAL_CAT_(LogCategory::bt) << errorMsg;
     } catch (...) {
       const std::string errorMsg = "BTLinkQualityChangeEventCallback failed failed with unknown exception";
-      LOG_FATAL_(LOGINSTANCE) << errorMsg;
+      LOG_FATAL_CAT_(LogCategory::bt) << errorMsg;
     }
   };
   return BTLinkQualityChangeEventCallback;
-}    
+}
+
+SettingsListener& internalCallbackManager::getSettingsChangeCallback()
+{
+  static SettingsListener SettingsChangeEventCallback = [](unsigned short deviceID, DeviceSettings* settings)
+  {
+    try {
+      LOG_SAMPLED_CAT_(LogCategory::settings, plog::verbose) << "SettingsChangeEventCallback got " << (settings != nullptr ? std::to_string(settings->settingCount) : "null") << " settings";
+      if (settings != nullptr) {
+        // The sdk may report settings that were written with their current value - only pass on real changes.
+        const std::vector<std::string> changedGuids = updateSettingsSnapshot(deviceID, settings);
+        Jabra_FreeDeviceSettings(settings);
+
+        // The snapshot is kept up to date regardless, so later subscribers are compared against current values.
+        if (!changedGuids.empty() && shouldPostEvent(EventType::SettingsChanged, deviceID)) {
+          state_Jabra_Initialize.post(EventType::SettingsChanged, deviceID, [deviceID, changedGuids](Napi::Env env, const util::PropertyKeys& keys, std::vector<napi_value>& args) {
+            Napi::Array guids = Napi::Array::New(env, changedGuids.size());
+            for (size_t i = 0; i < changedGuids.size(); ++i) {
+              guids.Set((uint32_t)i, Napi::String::New(env, changedGuids[i]));
+            }
+            args = { Napi::Number::New(env, deviceID), guids };
+          });
+        }
+      }
+      LOG_SAMPLED_CAT_(LogCategory::settings, plog::verbose) << "SettingsChangeEventCallback handling finished";
+    } catch (const std::exception &e) {
+      const std::string errorMsg = "SettingsChangeEventCallback failed: " + std::string(e.what());
+      LOG_FATAL_CAT_(LogCategory::settings) << errorMsg;
+    } catch (...) {
+      const std::string errorMsg = "SettingsChangeEventCallback failed failed with unknown exception";
+      LOG_FATAL_CAT_(LogCategory::settings) << errorMsg;
+    }
+  };
+  return SettingsChangeEventCallback;
+}
+
+HeadDetectionStatusListener& internalCallbackManager::getHeadDetectionStatusCallback()
+{
+  static HeadDetectionStatusListener HeadDetectionStatusEventCallback = [](unsigned short deviceID, const HeadDetectionStatus status)
+  {
+    try {
+      if (!shouldPostEvent(EventType::HeadDetectionStatus, deviceID)) {
+        return;
+      }
+      const uint64_t firedNs = eventClockNs();
+      LOG_SAMPLED_CAT_(LogCategory::device, plog::verbose) << "HeadDetectionStatusEventCallback got leftOn = " << status.leftOn << ", rightOn = " << status.rightOn;
+
+      EventRecord record = {};
+      record.firedNs = firedNs;
+      record.decode = &decodeHeadDetection;
+      record.deviceId = deviceID;
+      record.payload.headDetection.leftOn = status.leftOn;
+      record.payload.headDetection.rightOn = status.rightOn;
+      postStateEvent(EventType::HeadDetectionStatus, deviceID, record);
+      LOG_SAMPLED_CAT_(LogCategory::device, plog::verbose) << "HeadDetectionStatusEventCallback handling finished";
+    } catch (const std::exception &e) {
+      const std::string errorMsg = "HeadDetectionStatusEventCallback failed: " + std::string(e.what());
+      LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
+    } catch (...) {
+      const std::string errorMsg = "HeadDetectionStatusEventCallback failed failed with unknown exception";
+      LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
+    }
+  };
+  return HeadDetectionStatusEventCallback;
+}
+
+JackConnectorStatusListener& internalCallbackManager::getJackConnectorStatusCallback()
+{
+  static JackConnectorStatusListener JackConnectorStatusEventCallback = [](unsigned short deviceID, const JackStatus status)
+  {
+    try {
+      if (!shouldPostEvent(EventType::JackConnectorStatus, deviceID)) {
+        return;
+      }
+      const uint64_t firedNs = eventClockNs();
+      LOG_SAMPLED_CAT_(LogCategory::device, plog::verbose) << "JackConnectorStatusEventCallback got inserted = " << status.inserted;
+
+      EventRecord record = {};
+      record.firedNs = firedNs;
+      record.decode = &decodeDeviceStatus;
+      record.deviceId = deviceID;
+      record.payload.status = status.inserted;
+      postStateEvent(EventType::JackConnectorStatus, deviceID, record);
+      LOG_SAMPLED_CAT_(LogCategory::device, plog::verbose) << "JackConnectorStatusEventCallback handling finished";
+    } catch (const std::exception &e) {
+      const std::string errorMsg = "JackConnectorStatusEventCallback failed: " + std::string(e.what());
+      LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
+    } catch (...) {
+      const std::string errorMsg = "JackConnectorStatusEventCallback failed failed with unknown exception";
+      LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
+    }
+  };
+  return JackConnectorStatusEventCallback;
+}
+
+LinkConnectionStatusListener& internalCallbackManager::getLinkConnectionStatusCallback()
+{
+  static LinkConnectionStatusListener LinkConnectionStatusEventCallback = [](unsigned short deviceID, const LinkConnectStatus status)
+  {
+    try {
+      if (!shouldPostEvent(EventType::LinkConnectionStatus, deviceID)) {
+        return;
+      }
+      const uint64_t firedNs = eventClockNs();
+      LOG_SAMPLED_CAT_(LogCategory::device, plog::verbose) << "LinkConnectionStatusEventCallback got open = " << status.open << " for component " << status.component;
+
+      EventRecord record = {};
+      record.firedNs = firedNs;
+      record.decode = &decodeLinkConnection;
+      record.deviceId = deviceID;
+      record.payload.linkConnection.open = status.open;
+      record.payload.linkConnection.component = (int32_t)status.component;
+      // Each earbud has its own link, so keep the latest status per component.
+      postStateEvent(EventType::LinkConnectionStatus, ((uint32_t)deviceID << 16) | (uint32_t)status.component, record);
+      LOG_SAMPLED_CAT_(LogCategory::device, plog::verbose) << "LinkConnectionStatusEventCallback handling finished";
+    } catch (const std::exception &e) {
+      const std::string errorMsg = "LinkConnectionStatusEventCallback failed: " + std::string(e.what());
+      LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
+    } catch (...) {
+      const std::string errorMsg = "LinkConnectionStatusEventCallback failed failed with unknown exception";
+      LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
+    }
+  };
+  return LinkConnectionStatusEventCallback;
+}
+
+/**
+ * Parse the optional eventDelivery config into the event channel (batching, timing and per event overflow policy).
+ */
+static void configureEventDelivery(const char * const functionName, Napi::Object& eventDelivery, EventChannel& eventChannel) {
+  // All events except the initialized one represent device events that can be batched and timed.
+  const bool batched = util::getObjBooleanOrDefault(eventDelivery, "batched", false);
+  const bool timing = util::getObjBooleanOrDefault(eventDelivery, "timing", false);
+  for (size_t i = 0; i < (size_t)EventType::COUNT; ++i) {
+    if ((EventType)i != EventType::Initialized) {
+      eventChannel.setBatched((EventType)i, batched);
+      eventChannel.setTiming((EventType)i, timing);
+    }
+  }
+
+  // Both coalesce and overflowPolicy take the event names used with on() in javascript. Only
+  // events that carry a latest-value state can be coalesced.
+  if (eventDelivery.Has("coalesce")) {
+    Napi::Array coalesce = eventDelivery.Get("coalesce").As<Napi::Array>();
+    for (uint32_t i = 0; i < coalesce.Length(); ++i) {
+      const std::string eventName = coalesce.Get(i).As<Napi::String>();
+      EventType type;
+      if (EventChannel::typeFromPublicName(eventName, type) && EventChannel::isStateEvent(type)) {
+        eventChannel.setPolicy(type, OverflowPolicy::Coalesce);
+      } else {
+        LOG_WARNING_(LOGINSTANCE) << functionName << " ignoring coalescing for unsupported event " << eventName;
+      }
+    }
+  }
+
+  if (eventDelivery.Has("overflowPolicy")) {
+    Napi::Object overflowPolicy = eventDelivery.Get("overflowPolicy").As<Napi::Object>();
+    Napi::Array names = overflowPolicy.GetPropertyNames();
+    for (uint32_t i = 0; i < names.Length(); ++i) {
+      const std::string eventName = names.Get(i).As<Napi::String>();
+      const std::string policyName = overflowPolicy.Get(eventName).As<Napi::String>();
+
+      EventType type;
+      if (!EventChannel::typeFromPublicName(eventName, type)) {
+        LOG_WARNING_(LOGINSTANCE) << functionName << " ignoring overflow policy for unknown event " << eventName;
+      } else if (policyName == "block") {
+        eventChannel.setPolicy(type, OverflowPolicy::Block);
+      } else if (policyName == "dropOldest") {
+        eventChannel.setPolicy(type, OverflowPolicy::DropOldest);
+      } else if (policyName == "coalesce") {
+        if (EventChannel::isStateEvent(type)) {
+          eventChannel.setPolicy(type, OverflowPolicy::Coalesce);
+        } else {
+          LOG_WARNING_(LOGINSTANCE) << functionName << " ignoring coalescing for unsupported event " << eventName;
+        }
+      } else {
+        LOG_WARNING_(LOGINSTANCE) << functionName << " ignoring unknown overflow policy " << policyName << " for event " << eventName;
+      }
+    }
+  }
+}
 
 /**
  * Implements a combination of Jabra_Initialize, Jabra_SetAppID and all Jabra_RegisterXXX 
  * event handler setup functions. The implementation creates it's own thread to call 
  * all Jabra SDK functions. 
  * 
- * Important tempoary implementation note:
- * Callbacks are currently managed using a 3rd party napi-thread-safe-callback
- * library as the node-addon-api does not yet provide a c++ api for
- * cross thread callbacks. This 3rd-party implementation is not as portable
- * or future-proof n-api. Hence, once a official ThreadSafeFunction
- * (https://github.com/nodejs/node-addon-api/pull/442) is released 
- * the implementation should switch to the official 
- *
+ * All events are delivered to javascript through a single bounded EventChannel
+ * (see eventchannel.h) that is drained on the main thread. Device events are only
+ * copied and posted for devices with subscribers that pass the event filter
+ * (see eventsubscriptions.h).
  */
 Napi::Value napi_Initialize(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
@@ -333,29 +588,22 @@ Napi::Value napi_Initialize(const Napi::CallbackInfo& info) {
       util::FUNCTION, util::FUNCTION, util::FUNCTION,
       util::FUNCTION, util::FUNCTION, util::FUNCTION,
       util::FUNCTION, util::FUNCTION, util::FUNCTION,
-      util::FUNCTION, util::FUNCTION, util::FUNCTION, util::OBJECT })) {
+      util::FUNCTION, util::FUNCTION, util::FUNCTION,
+      util::FUNCTION, util::FUNCTION, util::FUNCTION,
+      util::FUNCTION, util::OBJECT })) {
 
     int argNr = 0;
 
+    // The background log writer is stopped by UnInitialize.
+    resumeAsyncLogging();
+
     std::string appId = info[argNr++].As<Napi::String>();
-    auto initializedCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto firstScanDoneCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto attachedCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto deAttachedCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto buttonInDataTranslatedCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto devLogCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto diagLogCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto batteryStatusCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto remoteMmiCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto xpressConnectionStatusCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto downloadFirmwareProgressCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto uploadProgressCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto registerPairingListCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto gNPButtonEventCallBack = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto dectInfoCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto cameraStatusCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto bluetoothLinkQualityCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
-    auto networkStatusChangeCallback = new ThreadSafeCallback(info[argNr++].As<Napi::Function>());
+
+    // Callback arguments are in EventType order.
+    std::vector<Napi::Function> eventCallbacks;
+    for (size_t i = 0; i < (size_t)EventType::COUNT; ++i) {
+      eventCallbacks.push_back(info[argNr++].As<Napi::Function>());
+    }
 
     Napi::Object configParams = info[argNr++].As<Napi::Object>();
     
@@ -365,33 +613,34 @@ Napi::Value napi_Initialize(const Napi::CallbackInfo& info) {
     const bool blockAllNetworkAccess =  configParams.Has("blockAllNetworkAccess") ? (bool)configParams.Get("blockAllNetworkAccess").As<Napi::Boolean>() : false;
     const bool nonJabraDeviceDectection =  configParams.Has("nonJabraDeviceDectection") ? (bool)configParams.Get("nonJabraDeviceDectection").As<Napi::Boolean>() : false;
 
+    Napi::Object eventDelivery = configParams.Has("eventDelivery") ? configParams.Get("eventDelivery").As<Napi::Object>() : Napi::Object::New(env);
+    const int32_t maxQueueSize = util::getObjInt32OrDefault(eventDelivery, "maxQueueSize", DEFAULT_EVENT_QUEUE_SIZE);
+
+    std::shared_ptr<EventChannel> eventChannel = EventChannel::New(env, eventCallbacks, maxQueueSize > 0 ? maxQueueSize : DEFAULT_EVENT_QUEUE_SIZE);
+
+    // Frequent status and log events must never stall the sdk threads - everything else
+    // (attach/detach, buttons, progress etc.) is worth waiting for.
+    for (EventType type : { EventType::DevLog, EventType::DiagnosticLog, EventType::BatteryStatus, EventType::XpressConnectionStatus,
+                            EventType::DectInfo, EventType::CameraStatus, EventType::BluetoothLinkQuality, EventType::NetworkStatusChange,
+                            EventType::HeadDetectionStatus, EventType::JackConnectorStatus, EventType::LinkConnectionStatus }) {
+      eventChannel->setPolicy(type, OverflowPolicy::DropOldest);
+    }
+
+    configureEventDelivery(functionName, eventDelivery, *eventChannel);
 
     state_Jabra_Initialize.set(env,
                                appId,
-                               initializedCallback,
-                               firstScanDoneCallback,
-                               attachedCallback,
-                               deAttachedCallback,
-                               buttonInDataTranslatedCallback,
-                               devLogCallback,
-                               diagLogCallback,
-                               batteryStatusCallback,
-                               remoteMmiCallback,
-                               xpressConnectionStatusCallback,
-                               downloadFirmwareProgressCallback,
-                               uploadProgressCallback,
-                               registerPairingListCallback,
-                               gNPButtonEventCallBack,
-                               dectInfoCallback,
-                               cameraStatusCallback,
-                               bluetoothLinkQualityCallback,
-                               networkStatusChangeCallback,
+                               eventChannel,
                                proxy,
                                baseUrl_capabilities,
                                baseUrl_fw,
                                blockAllNetworkAccess,
                                nonJabraDeviceDectection);
 
+    setThrottledEventPoster([](EventType type, uint32_t key, const EventRecord& record) {
+      state_Jabra_Initialize.post(type, key, record);
+    });
+
     std::thread initThread([functionName](){
       try {                  
           ConfigParams_cloud configParams_cloud;
@@ -413,113 +662,101 @@ Napi::Value napi_Initialize(const Napi::CallbackInfo& info) {
           LOG_DEBUG_(LOGINSTANCE) << "Calling Jabra_Initialize";
           if (Jabra_InitializeV2([]() {  // First scan done.
               try {
-                LOG_DEBUG_(LOGINSTANCE) << "First scan done";
+                const uint64_t firedNs = eventClockNs();
+                LOG_DEBUG_CAT_(LogCategory::device) << "First scan done";
 
                 auto eventTime = getTimeSinceEpoc();
 
-                auto firstScanCallback = state_Jabra_Initialize.getFirstScanDoneCallback();
-                if (firstScanCallback) {
-                  firstScanCallback->call([eventTime](Napi::Env env, std::vector<napi_value>& args) {
-                    args = { Napi::Number::New(env, eventTime) };
-                  });            
-                }
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeEventTime;
+                record.payload.eventTime = eventTime;
+                state_Jabra_Initialize.post(EventType::FirstScanDone, 0, record);
               } catch (const std::exception &e) {       
                 const std::string errorMsg = "Init firstScanDone callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "Init firstScanDone callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
               }
             }, [](Jabra_DeviceInfo _deviceInfo) { // attached            
               try {
-                LOG_DEBUG_(LOGINSTANCE) << "Device #" << _deviceInfo.deviceID << " attached";
+                LOG_DEBUG_CAT_(LogCategory::device) << "Device #" << _deviceInfo.deviceID << " attached";
 
                 auto eventTime = getTimeSinceEpoc();
 
-                auto attachedCallback = state_Jabra_Initialize.getAttachedCallback();
-
-                if (attachedCallback) {
-                  // Make safe copy to avoid refering to memeory freed by Jabra_FreeDeviceInfo below.
-                  ManagedDeviceInfo deviceInfo(_deviceInfo);                
-                  Jabra_FreeDeviceInfo(_deviceInfo);
-
-                  attachedCallback->call([deviceInfo, eventTime](Napi::Env env, std::vector<napi_value>& args) {
-                      Napi::Object result = Napi::Object::New(env);
-                      result.Set(Napi::String::New(env, "deviceID"), (Napi::Number::New(env, deviceInfo.deviceID)));
-                      result.Set(Napi::String::New(env, "productID"), (Napi::Number::New(env, deviceInfo.productID)));
-                      result.Set(Napi::String::New(env, "vendorID"), (Napi::Number::New(env, deviceInfo.vendorID)));
-                      result.Set(Napi::String::New(env, "deviceName"), (Napi::String::New(env, deviceInfo.deviceName)));
+                // Make safe copy to avoid refering to memeory freed by Jabra_FreeDeviceInfo below.
+                ManagedDeviceInfo deviceInfo(_deviceInfo);                
+                Jabra_FreeDeviceInfo(_deviceInfo);
 
-                      result.Set(Napi::String::New(env, "usbDevicePath"), (Napi::String::New(env, deviceInfo.usbDevicePath)));
-                      result.Set(Napi::String::New(env, "parentInstanceId"), (Napi::String::New(env, deviceInfo.parentInstanceId)));
+                // Cache before the event is posted, so the registry knows the device when javascript sees it.
+                registerDevice(deviceInfo);
 
-                      result.Set(Napi::String::New(env, "errorStatus"), (Napi::Number::New(env, deviceInfo.errStatus)));
-                      result.Set(Napi::String::New(env, "isDongleDevice"), (Napi::Boolean::New(env, deviceInfo.isDongle)));
-                      result.Set(Napi::String::New(env, "dongleName"), (Napi::String::New(env, deviceInfo.dongleName)));
-                      result.Set(Napi::String::New(env, "variant"), (Napi::String::New(env, deviceInfo.variant)));
-                      result.Set(Napi::String::New(env, "ESN"), (Napi::String::New(env, deviceInfo.serialNumber)));
-
-                      result.Set(Napi::String::New(env, "isInFirmwareUpdateMode"), (Napi::Boolean::New(env, deviceInfo.isInFirmwareUpdateMode)));
-                      result.Set(Napi::String::New(env, "connectionType"), (Napi::Number::New(env, deviceInfo.deviceconnection)));
-                      //result.Set(Napi::String::New(env, "connectionId"), (Napi::Number::New(env, deviceInfo.connectionId))); // connectionId not set by native lib
-                      if (deviceInfo.parentDeviceId != 65535) // 65535 (-1) means there is no parent
-                        result.Set(Napi::String::New(env, "parentDeviceId"), (Napi::Number::New(env, deviceInfo.parentDeviceId)));
-
-                      args = { result, Napi::Number::New(env, eventTime) };
-                  });
-                }
+                state_Jabra_Initialize.post(EventType::Attached, [deviceInfo, eventTime](Napi::Env env, const util::PropertyKeys& keys, std::vector<napi_value>& args) {
+                    args = { makeDeviceInfoObject(env, keys, deviceInfo), Napi::Number::New(env, eventTime) };
+                });
 
-                LOG_VERBOSE_(LOGINSTANCE) << "Device attach callback handling finished";
+                LOG_VERBOSE_CAT_(LogCategory::device) << "Device attach callback handling finished";
               } catch (const std::exception &e) {       
                 const std::string errorMsg = "Init attached callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "Init attached callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
               }
             }, [](unsigned short deviceID) { // deattached 
               try {
-                LOG_DEBUG_(LOGINSTANCE) << "Device #" << deviceID << " de-attached";
+                const uint64_t firedNs = eventClockNs();
+                LOG_DEBUG_CAT_(LogCategory::device) << "Device #" << deviceID << " de-attached";
 
                 auto eventTime = getTimeSinceEpoc();
 
                 freeConstants(deviceID); // Free any Jabra_Constants that might have been created
-                auto deAttachedCallback = state_Jabra_Initialize.getDeAttachedCallback();
-                if (deAttachedCallback) {
-                  deAttachedCallback->call([deviceID, eventTime](Napi::Env env, std::vector<napi_value>& args) {
-                    args = { Napi::Number::New(env, deviceID), Napi::Number::New(env, eventTime) };
-                  });
-                }
-
-                LOG_VERBOSE_(LOGINSTANCE) << "Device de-attach callback handling finished";
+                unregisterDevice(deviceID); // Drop cached device info and capabilities
+                freeSettingsSnapshot(deviceID);
+                freeSettingsChangeListener(deviceID); // The sdk drops the listener with the device
+                freeEventSubscriptions(deviceID);
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeDeviceEventTime;
+                record.deviceId = deviceID;
+                record.payload.eventTime = eventTime;
+                state_Jabra_Initialize.post(EventType::DeAttached, deviceID, record);
+
+                LOG_VERBOSE_CAT_(LogCategory::device) << "Device de-attach callback handling finished";
               } catch (const std::exception &e) {       
                 const std::string errorMsg = "Init deattached callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "Init deattached callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::device) << errorMsg;
               }
             }, [](unsigned short deviceID, unsigned short usagePage, unsigned short usage, bool buttonInData) { // Buttons raw.
                 // Ignore - not used.
             },
             [](unsigned short deviceID, Jabra_HidInput translatedInData, bool buttonInData) { // Buttons translated
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Device #" << deviceID << " button press " << translatedInData << ", " << buttonInData;
-
-                auto buttonInDataTranslatedCallback = state_Jabra_Initialize.getButtonInDataTranslatedCallback();
-                if (buttonInDataTranslatedCallback) {
-                  buttonInDataTranslatedCallback->call([deviceID, translatedInData, buttonInData](Napi::Env env, std::vector<napi_value>& args) {
-                      args = { Napi::Number::New(env, deviceID), Napi::Number::New(env, (int)translatedInData), Napi::Boolean::New(env, buttonInData) };
-                  });
+                if (!shouldPostEvent(EventType::ButtonInDataTranslated, deviceID)) {
+                  return;
                 }
-
-                LOG_VERBOSE_(LOGINSTANCE) << "Device button press callback handling finished";
+                const uint64_t firedNs = eventClockNs();
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Device #" << deviceID << " button press " << translatedInData << ", " << buttonInData;
+
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeButtonInDataTranslated;
+                record.deviceId = deviceID;
+                record.payload.button.translatedInData = (int)translatedInData;
+                record.payload.button.buttonInData = buttonInData;
+                state_Jabra_Initialize.post(EventType::ButtonInDataTranslated, deviceID, record);
+
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Device button press callback handling finished";
               } catch (const std::exception &e) {       
                 const std::string errorMsg = "Init translatedInData callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "Init translatedInData callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               }
             },
             nonJabraDeviceDectection, &config
@@ -530,122 +767,149 @@ Napi::Value napi_Initialize(const Napi::CallbackInfo& info) {
 
             Jabra_RegisterDevLogCallback([](unsigned short deviceID, char* _eventStr) {
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterDevLogCallback callback got eventStr " << _eventStr;
-                if (_eventStr) {
-                  auto devLogCallback = state_Jabra_Initialize.getDevLogCallback();
-
-                  // Make safe copy to avoid refering to memeory freed by Jabra_FreeString below.
-                  std::string eventStr(_eventStr);
-
-                  if (devLogCallback) {
-                    devLogCallback->call([deviceID, eventStr](Napi::Env env, std::vector<napi_value>& args) {
-                        args = { Napi::Number::New(env, deviceID), Napi::String::New(env, eventStr) };
-                    });
+                if (!shouldPostEvent(EventType::DevLog, deviceID)) {
+                  if (_eventStr) {
+                    Jabra_FreeString(_eventStr);
                   }
+                  return;
+                }
+                const uint64_t firedNs = eventClockNs();
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterDevLogCallback callback got eventStr " << _eventStr;
+                if (_eventStr) {
+                  // The channel copies the string into its arena before it is freed by Jabra_FreeString below.
+                  EventRecord record = {};
+                  record.firedNs = firedNs;
+                  record.decode = &decodeDeviceText;
+                  record.deviceId = deviceID;
+                  state_Jabra_Initialize.post(EventType::DevLog, deviceID, record, _eventStr, strlen(_eventStr));
                   Jabra_FreeString(_eventStr);
                 }
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterDevLogCallback callback handling finished";
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterDevLogCallback callback handling finished";
               } catch (const std::exception &e) {
                 const std::string errorMsg = "DevLogCallback callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "DevLogCallback callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               }              
             });
 
             Jabra_RegisterDiagnosticLogCallback([](const unsigned short deviceID) {
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterDiagnosticLogCallback callback";
-                auto diagnosticLogCallback = state_Jabra_Initialize.getDiagnosticLogCallback();
-                if (diagnosticLogCallback) {
-                  diagnosticLogCallback->call([deviceID](Napi::Env env, std::vector<napi_value>& args) {
-                      args = { Napi::Number::New(env, deviceID) };
-                  });
+                if (!shouldPostEvent(EventType::DiagnosticLog, deviceID)) {
+                  return;
                 }
-                LOG_VERBOSE_(LOGINSTANCE) << "diagLogCallback callback handling finished";
+                const uint64_t firedNs = eventClockNs();
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterDiagnosticLogCallback callback";
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeDevice;
+                record.deviceId = deviceID;
+                state_Jabra_Initialize.post(EventType::DiagnosticLog, deviceID, record);
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "diagLogCallback callback handling finished";
               } catch (const std::exception &e) {
                 const std::string errorMsg = "diagLogCallback callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "diagLogCallback callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               }              
             });
 
             Jabra_RegisterFirmwareProgressCallBack([](unsigned short deviceID, Jabra_FirmwareEventType type, Jabra_FirmwareEventStatus status, unsigned short percentage) {
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterFirmwareProgressCallBack callback got " << type << " " << status << " " << percentage;
-
-                auto downloadFirmwareProgressCallback = state_Jabra_Initialize.getDownloadFirmwareProgressCallback();
-                if (downloadFirmwareProgressCallback) {
-                  downloadFirmwareProgressCallback->call([deviceID, type, status, percentage](Napi::Env env, std::vector<napi_value>& args) {
-                      args = { Napi::Number::New(env, deviceID), Napi::Number::New(env, (int)type), Napi::Number::New(env, (int)status), Napi::Number::New(env, percentage) };
-                  });
+                if (!shouldPostEvent(EventType::DownloadFirmwareProgress, deviceID)) {
+                  return;
                 }
-
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterFirmwareProgressCallBack callback handling finished";
+                const uint64_t firedNs = eventClockNs();
+                LOG_SAMPLED_CAT_(LogCategory::fwu, plog::verbose) << "Jabra_RegisterFirmwareProgressCallBack callback got " << type << " " << status << " " << percentage;
+
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeFirmwareProgress;
+                record.deviceId = deviceID;
+                record.payload.progress.type = (int)type;
+                record.payload.progress.status = (int)status;
+                record.payload.progress.percentage = percentage;
+                state_Jabra_Initialize.post(EventType::DownloadFirmwareProgress, deviceID, record);
+
+                LOG_SAMPLED_CAT_(LogCategory::fwu, plog::verbose) << "Jabra_RegisterFirmwareProgressCallBack callback handling finished";
               } catch (const std::exception &e) {
                 const std::string errorMsg = "FirmwareProgress callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::fwu) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "FirmwareProgress callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::fwu) << errorMsg;
               }
 
             });
 
             Jabra_RegisterPairingListCallback([](unsigned short deviceID, Jabra_PairingList *lst) {
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterPairingListCallback callback called with " << (lst!=nullptr ? std::to_string(lst->count) : "null") << " pairings";
+                if (!shouldPostEvent(EventType::PairingList, deviceID)) {
+                  if (lst != nullptr) {
+                    Jabra_FreePairingList(lst);
+                  }
+                  return;
+                }
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterPairingListCallback callback called with " << (lst!=nullptr ? std::to_string(lst->count) : "null") << " pairings";
                 if (lst != nullptr) {
                   ManagedPairingList mlst(*lst);
+                  IF_LOG_CAT_(LogCategory::callbacks, plog::verbose) {
+                    LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterPairingListCallback got " << toString(mlst);
+                  }
 
-                  auto registerPairingListCallback = state_Jabra_Initialize.getRegisterPairingListCallback();
-                  if (registerPairingListCallback) {
-                    registerPairingListCallback->call([deviceID, mlst](Napi::Env env, std::vector<napi_value>& args) {
-                        Napi::Object jlst = Napi::Object::New(env);
-                        jlst.Set(Napi::String::New(env, "listType"), Napi::Number::New(env, mlst.listType));
+                  state_Jabra_Initialize.post(EventType::PairingList, deviceID, [deviceID, mlst](Napi::Env env, const util::PropertyKeys& keys, std::vector<napi_value>& args) {
+                      Napi::Object jlst = Napi::Object::New(env);
+                      jlst.Set(Napi::String::New(env, "listType"), Napi::Number::New(env, mlst.listType));
 
-                        Napi::Array jPairedDevices = Napi::Array::New(env);
+                      Napi::Array jPairedDevices = Napi::Array::New(env);
 
-                        int i = 0;
-                        for (auto it = mlst.pairedDevice.begin(); it != mlst.pairedDevice.end(); it++) {
-                          const ManagedPairedDevice& src =  *it;
+                      int i = 0;
+                      for (auto it = mlst.pairedDevice.begin(); it != mlst.pairedDevice.end(); it++) {
+                        const ManagedPairedDevice& src =  *it;
 
-                          Napi::Object jDev = Napi::Object::New(env);
+                        Napi::Object jDev = Napi::Object::New(env);
 
-                          jDev.Set(Napi::String::New(env, "deviceName"), Napi::String::New(env, src.deviceName));
+                        jDev.Set(Napi::String::New(env, "deviceName"), Napi::String::New(env, src.deviceName));
 
-                          std::string btAddrStr = toBTAddrString(src.deviceBTAddr.data(), src.deviceBTAddr.size());
+                        std::string btAddrStr = toBTAddrString(src.deviceBTAddr.data(), src.deviceBTAddr.size());
 
-                          jDev.Set(Napi::String::New(env, "deviceBTAddr"), Napi::String::New(env, btAddrStr));
+                        jDev.Set(Napi::String::New(env, "deviceBTAddr"), Napi::String::New(env, btAddrStr));
 
-                          jDev.Set(Napi::String::New(env, "isConnected"), Napi::Boolean::New(env, src.isConnected));
+                        jDev.Set(Napi::String::New(env, "isConnected"), Napi::Boolean::New(env, src.isConnected));
 
-                          jPairedDevices.Set(i++, jDev);
-                        }                    
+                        jPairedDevices.Set(i++, jDev);
+                      }                    
+
+                      jlst.Set(Napi::String::New(env, "pairedDevice"), jPairedDevices);
+                      args = { Napi::Number::New(env, deviceID), jlst };
+                  });
 
-                        jlst.Set(Napi::String::New(env, "pairedDevice"), jPairedDevices);
-                        args = { Napi::Number::New(env, deviceID), jlst };
-                    });
-                  }
-                  
                   Jabra_FreePairingList(lst);
                 }
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterPairingListCallback callback handling finished";
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterPairingListCallback callback handling finished";
               } catch (const std::exception &e) {
                 const std::string errorMsg = "Jabra_RegisterPairingListCallback callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "Jabra_RegisterPairingListCallback callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               }
             });
 
             Jabra_RegisterForGNPButtonEvent([] (unsigned short deviceID, ButtonEvent *buttonEvent) {
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterForGNPButtonEvent callback called with " << (buttonEvent!=nullptr ? std::to_string(buttonEvent->buttonEventCount) : "null") << " button events";
+                if (!shouldPostEvent(EventType::GNPButtonEvent, deviceID)) {
+                  Jabra_FreeButtonEvents(buttonEvent);
+                  return;
+                }
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterForGNPButtonEvent callback called with " << (buttonEvent!=nullptr ? std::to_string(buttonEvent->buttonEventCount) : "null") << " button events";
+                IF_LOG_CAT_(LogCategory::callbacks, plog::verbose) {
+                  if (buttonEvent != nullptr) {
+                    LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterForGNPButtonEvent got " << toString(*buttonEvent);
+                  }
+                }
 
                 // First unpack individual key/values into a managed structure that we can safely pass to the callback.
                 std::vector<ManagedButtonEventInfo> buttonInfos;
@@ -661,267 +925,257 @@ Napi::Value napi_Initialize(const Napi::CallbackInfo& info) {
                   }
                 }
 
-                auto gNPButtonEventCallBack = state_Jabra_Initialize.getGNPButtonEventCallBack();
-                if (gNPButtonEventCallBack) {
-                  gNPButtonEventCallBack->call([deviceID, buttonInfos](Napi::Env env, std::vector<napi_value>& args) {
-                      Napi::Array buttonEvents = Napi::Array::New(env);
-
-                      // Now repack individual key/value entries into a json structure similar to the orginal:
-                      std::unordered_map<unsigned short, uint32_t> targets;
-                      for (auto itr = buttonInfos.begin(); itr != buttonInfos.end(); itr++) {
-                        const ManagedButtonEventInfo& src = *itr;
-
-                        // Find out if there is there is already an entry for this buttontype, so we can
-                        // and add to that if it exist.
-                        if (targets.find(src.buttonTypeKey) == targets.end()) {
-                           Napi::Array buttonEventInfos = Napi::Array::New(env);
-                           
-                           Napi::Object o = Napi::Object::New(env);
-                           o.Set(Napi::String::New(env, "buttonTypeKey"), Napi::Number::New(env, src.buttonTypeKey));
-                           o.Set(Napi::String::New(env, "buttonTypeValue"), Napi::String::New(env, src.buttonTypeValue));
-                           o.Set(Napi::String::New(env, "buttonEventType"), buttonEventInfos);
-
-                           uint32_t buttonEventsIndex = buttonEvents.Length();
-                           buttonEvents.Set(buttonEventsIndex, o);
-                           targets.insert(std::pair<unsigned short, uint32_t>(src.buttonTypeKey, buttonEventsIndex)); 
-                        }
-
-                        int buttonEventsIndex = targets[src.buttonTypeKey]; // Should always succed.
-                        Napi::Value targetButtonEventInfo = buttonEvents.Get(buttonEventsIndex);
-
-                        if (!targetButtonEventInfo.IsUndefined()) {
-                          Napi::Object targetButtonEventInfoObj = targetButtonEventInfo.As<Napi::Object>();
-                          Napi::Array targetArray = targetButtonEventInfoObj.Get("buttonEventType").As<Napi::Array>();
-
-                          Napi::Object keyValue = Napi::Object::New(env);
-                          keyValue.Set(Napi::String::New(env, "key"), Napi::Number::New(env, src.key));
-                          keyValue.Set(Napi::String::New(env, "value"), Napi::String::New(env, src.value));
-
-                          targetArray.Set(targetArray.Length(), keyValue);
-                        } else { // We should not get here.
-                          LOG_ERROR_(LOGINSTANCE) << "Jabra_RegisterForGNPButtonEvent callback internal error - could not lookup target";
-                        }
+                state_Jabra_Initialize.post(EventType::GNPButtonEvent, deviceID, [deviceID, buttonInfos](Napi::Env env, const util::PropertyKeys& keys, std::vector<napi_value>& args) {
+                    Napi::Array buttonEvents = Napi::Array::New(env);
+
+                    // Now repack individual key/value entries into a json structure similar to the orginal:
+                    std::unordered_map<unsigned short, uint32_t> targets;
+                    for (auto itr = buttonInfos.begin(); itr != buttonInfos.end(); itr++) {
+                      const ManagedButtonEventInfo& src = *itr;
+
+                      // Find out if there is there is already an entry for this buttontype, so we can
+                      // and add to that if it exist.
+                      if (targets.find(src.buttonTypeKey) == targets.end()) {
+                         Napi::Array buttonEventInfos = Napi::Array::New(env);
+                         
+                         Napi::Object o = util::ObjectBuilder(env, keys)
+                           .set(PropertyKey::buttonTypeKey, Napi::Number::New(env, src.buttonTypeKey))
+                           .set(PropertyKey::buttonTypeValue, Napi::String::New(env, src.buttonTypeValue))
+                           .set(PropertyKey::buttonEventType, buttonEventInfos)
+                           .build();
+
+                         uint32_t buttonEventsIndex = buttonEvents.Length();
+                         buttonEvents.Set(buttonEventsIndex, o);
+                         targets.insert(std::pair<unsigned short, uint32_t>(src.buttonTypeKey, buttonEventsIndex)); 
                       }
 
-                      args = { Napi::Number::New(env, deviceID), buttonEvents };
-                  });
-                }
-                
+                      int buttonEventsIndex = targets[src.buttonTypeKey]; // Should always succed.
+                      Napi::Value targetButtonEventInfo = buttonEvents.Get(buttonEventsIndex);
+
+                      if (!targetButtonEventInfo.IsUndefined()) {
+                        Napi::Object targetButtonEventInfoObj = targetButtonEventInfo.As<Napi::Object>();
+                        Napi::Array targetArray = targetButtonEventInfoObj.Get(keys[PropertyKey::buttonEventType]).As<Napi::Array>();
+
+                        Napi::Object keyValue = util::ObjectBuilder(env, keys)
+                          .set(PropertyKey::key, Napi::Number::New(env, src.key))
+                          .set(PropertyKey::value, Napi::String::New(env, src.value))
+                          .build();
+
+                        targetArray.Set(targetArray.Length(), keyValue);
+                      } else { // We should not get here.
+                        LOG_ERROR_CAT_(LogCategory::callbacks) << "Jabra_RegisterForGNPButtonEvent callback internal error - could not lookup target";
+                      }
+                    }
+
+                    args = { Napi::Number::New(env, deviceID), buttonEvents };
+                });
+
                 Jabra_FreeButtonEvents(buttonEvent);
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterForGNPButtonEvent callback handling finished";
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterForGNPButtonEvent callback handling finished";
               } catch (const std::exception &e) {
                 const std::string errorMsg = "Jabra_RegisterForGNPButtonEvent callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "Jabra_RegisterForGNPButtonEvent callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               }
             });
 
             Jabra_RegisterBatteryStatusUpdateCallback([] (unsigned short deviceID, int levelInPercent, bool charging, bool batteryLow) {
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterBatteryStatusUpdateCallback callback got " << levelInPercent << " " << charging << " " << batteryLow;
-
-                auto batteryStatusCallback = state_Jabra_Initialize.getBatteryStatusCallback();
-
-                if (batteryStatusCallback) {
-                  batteryStatusCallback->call([deviceID, levelInPercent, charging, batteryLow](Napi::Env env, std::vector<napi_value>& args) {
-                      args = { Napi::Number::New(env, deviceID), Napi::Number::New(env, levelInPercent), Napi::Boolean::New(env, charging), Napi::Boolean::New(env, batteryLow) };
-                  });
+                if (!shouldPostEvent(EventType::BatteryStatus, deviceID)) {
+                  return;
                 }
-
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterBatteryStatusUpdateCallback callback handling finished";
+                const uint64_t firedNs = eventClockNs();
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterBatteryStatusUpdateCallback callback got " << levelInPercent << " " << charging << " " << batteryLow;
+
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeBatteryStatus;
+                record.deviceId = deviceID;
+                record.payload.battery.levelInPercent = levelInPercent;
+                record.payload.battery.charging = charging;
+                record.payload.battery.batteryLow = batteryLow;
+                postStateEvent(EventType::BatteryStatus, deviceID, record);
+
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterBatteryStatusUpdateCallback callback handling finished";
               } catch (const std::exception &e) {
                 const std::string errorMsg = "BatteryStatusUpdate callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "BatteryStatusUpdate callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               }
             });
            
             Jabra_RegisterRemoteMmiCallback([] (unsigned short deviceID, RemoteMmiType type, RemoteMmiInput action){
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterRemoteMmiCallback callback got " << type << " " << action;
-
-                auto remoteMmiCallback = state_Jabra_Initialize.getRemoteMmiCallback();
-
-                if (remoteMmiCallback) {
-                  remoteMmiCallback->call([deviceID, type, action](Napi::Env env, std::vector<napi_value>& args) {
-                    args = { Napi::Number::New(env, deviceID), Napi::Number::New(env, type), Napi::Number::New(env, action)};
-                  });
+                if (!shouldPostEvent(EventType::RemoteMmi, deviceID)) {
+                  return;
                 }
+                const uint64_t firedNs = eventClockNs();
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterRemoteMmiCallback callback got " << type << " " << action;
+
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeRemoteMmi;
+                record.deviceId = deviceID;
+                record.payload.remoteMmi.type = type;
+                record.payload.remoteMmi.input = action;
+                state_Jabra_Initialize.post(EventType::RemoteMmi, deviceID, record);
               } catch (const std::exception &e) {
                 const std::string errorMsg = "RegisterRemoteMmiCallback callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "RegisterRemoteMmiCallback callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               }
             });
             
             Jabra_RegisterXpressConnectionStatusCallback([] (unsigned short deviceID, bool status) {
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterXpressConnectionStatusCallback callback got " << status; 
-
-                auto xpressConnectionStatusCallback = state_Jabra_Initialize.getXpressConnectionStatusCallback();
-
-                if (xpressConnectionStatusCallback) {
-                  xpressConnectionStatusCallback->call([deviceID, status](Napi::Env env, std::vector<napi_value>& args) {
-                    args = { Napi::Number::New(env, deviceID), Napi::Boolean::New(env, status)};
-                  });
+                if (!shouldPostEvent(EventType::XpressConnectionStatus, deviceID)) {
+                  return;
                 }
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterXpressConnectionStatusCallback callback handling finished";
+                const uint64_t firedNs = eventClockNs();
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterXpressConnectionStatusCallback callback got " << status; 
+
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeDeviceStatus;
+                record.deviceId = deviceID;
+                record.payload.status = status;
+                postStateEvent(EventType::XpressConnectionStatus, deviceID, record);
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterXpressConnectionStatusCallback callback handling finished";
               } catch (const std::exception &e) {
                 const std::string errorMsg = "RegisterXpressConnectionStatusCallback callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "RegisterXpressConnectionStatusCallback callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               }
             });
 
             Jabra_RegisterUploadProgress([] (unsigned short deviceID, Jabra_UploadEventStatus status, unsigned short percentage) {
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterUploadProgress got " << status << " " << percentage;
-
-                auto uploadProgressCallback = state_Jabra_Initialize.getUploadProgressCallback();
-
-                if (uploadProgressCallback) {
-                  uploadProgressCallback->call([deviceID, status, percentage](Napi::Env env, std::vector<napi_value>& args) {
-                      args = { Napi::Number::New(env, deviceID), Napi::Number::New(env, status), Napi::Number::New(env, percentage) };
-                  });
+                if (!shouldPostEvent(EventType::UploadProgress, deviceID)) {
+                  return;
                 }
-
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterUploadProgress callback handling finished";
+                const uint64_t firedNs = eventClockNs();
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterUploadProgress got " << status << " " << percentage;
+
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeUploadProgress;
+                record.deviceId = deviceID;
+                record.payload.progress.status = status;
+                record.payload.progress.percentage = percentage;
+                state_Jabra_Initialize.post(EventType::UploadProgress, deviceID, record);
+
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterUploadProgress callback handling finished";
               } catch (const std::exception &e) {
                 const std::string errorMsg = "RegisterUploadProgress callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "RegisterUploadProgress callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               }
             });
 
             Jabra_RegisterDectInfoHandler([] (unsigned short deviceID, Jabra_DectInfo* dectInfo) {
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterDectInfoHandler got " << dectInfo;
-
-                auto dectInfoCallback = state_Jabra_Initialize.getDectInfoCallBack();
-
-                if (dectInfoCallback) {
-                  /*
-                      Jabra_DectInfo is a C struct with a bunch of numbers
-                      and a statically allocate array. It's safe to copy it
-                      this way.
-                  */
-                  Jabra_DectInfo dectInfoStack = *dectInfo;
+                if (!shouldPostEvent(EventType::DectInfo, deviceID)) {
                   Jabra_FreeDectInfoStr(dectInfo);
-
-                  dectInfoCallback->call([deviceID, dectInfoStack](Napi::Env env, std::vector<napi_value>& args) {
-                    Napi::Object dectInfoNapi = Napi::Object::New(env);
-
-                    Napi::Uint8Array rawData = Napi::Uint8Array::New(env, dectInfoStack.RawDataLen);
-                    for (unsigned int k = 0; k < dectInfoStack.RawDataLen; ++k) {
-                      rawData[k] = dectInfoStack.RawData[k];
-                    }
-                    dectInfoNapi.Set(Napi::String::New(env, "rawData"), rawData);
-
-                    switch (dectInfoStack.DectType) {
-                      case DectDensity: {
-                        const Jabra_DectInfoDensity& dectDensity = dectInfoStack.DectDensity;
-                        dectInfoNapi.Set(Napi::String::New(env, "kind"), Napi::String::New(env, "density"));
-                        dectInfoNapi.Set(Napi::String::New(env, "sumMeasuredRSSI"), Napi::Number::New(env, dectDensity.SumMeasuredRSSI));
-                        dectInfoNapi.Set(Napi::String::New(env, "maximumReferenceRSSI"), Napi::Number::New(env, dectDensity.MaximumReferenceRSSI));
-                        dectInfoNapi.Set(Napi::String::New(env, "numberMeasuredSlots"), Napi::Number::New(env, dectDensity.NumberMeasuredSlots));
-                        dectInfoNapi.Set(Napi::String::New(env, "dataAgeSeconds"), Napi::Number::New(env, dectDensity.DataAgeSeconds));
-                        break;
-                      }
-
-                      case DectErrorCount: {
-                        const Jabra_DectErrorCount& dectError = dectInfoStack.DectErrorCount;
-                        dectInfoNapi.Set(Napi::String::New(env, "kind"), Napi::String::New(env, "errorCount"));
-                        dectInfoNapi.Set(Napi::String::New(env, "syncErrors"), Napi::Number::New(env, dectError.syncErrors));
-                        dectInfoNapi.Set(Napi::String::New(env, "aErrors"), Napi::Number::New(env, dectError.aErrors));
-                        dectInfoNapi.Set(Napi::String::New(env, "xErrors"), Napi::Number::New(env, dectError.xErrors));
-                        dectInfoNapi.Set(Napi::String::New(env, "zErrors"), Napi::Number::New(env, dectError.zErrors));
-                        dectInfoNapi.Set(Napi::String::New(env, "hubSyncErrors"), Napi::Number::New(env, dectError.hubSyncErrors));
-                        dectInfoNapi.Set(Napi::String::New(env, "hubAErrors"), Napi::Number::New(env, dectError.hubAErrors));
-                        dectInfoNapi.Set(Napi::String::New(env, "handoversCount"), Napi::Number::New(env, dectError.handoversCount));
-                        break;
-                      }
-                    }
-
-                    args = { Napi::Number::New(env, deviceID), dectInfoNapi };
-                  });
+                  return;
+                }
+                const uint64_t firedNs = eventClockNs();
+                IF_LOG_CAT_(LogCategory::dect, plog::verbose) {
+                  LOG_SAMPLED_CAT_(LogCategory::dect, plog::verbose) << "Jabra_RegisterDectInfoHandler got " << toString(*dectInfo);
                 }
 
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterDectInfoHandler callback handling finished";
+                /*
+                    Jabra_DectInfo is a C struct with a bunch of numbers
+                    and a statically allocate array. It's safe to copy it
+                    this way.
+                */
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeDectInfo;
+                record.deviceId = deviceID;
+                record.payload.dectInfo = *dectInfo;
+                Jabra_FreeDectInfoStr(dectInfo);
+
+                postStateEvent(EventType::DectInfo, ((uint32_t)deviceID << 16) | record.payload.dectInfo.DectType, record);
+
+                LOG_SAMPLED_CAT_(LogCategory::dect, plog::verbose) << "Jabra_RegisterDectInfoHandler callback handling finished";
               } catch (const std::exception &e) {
                 const std::string errorMsg = "RegisterDectInfoHandler callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::dect) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "RegisterDectInfoHandler callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::dect) << errorMsg;
               }
             });
 
             Jabra_RegisterCameraStatusCallback([] (unsigned short deviceID, bool status) {
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterCameraStatusCallback callback got " << status;
-
-                auto cameraStatusCallback = state_Jabra_Initialize.getCameraStatusCallback();
-
-                if (cameraStatusCallback) {
-                  cameraStatusCallback->call([deviceID, status](Napi::Env env, std::vector<napi_value>& args) {
-                    args = { Napi::Number::New(env, deviceID), Napi::Boolean::New(env, status)};
-                  });
+                if (!shouldPostEvent(EventType::CameraStatus, deviceID)) {
+                  return;
                 }
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterCameraStatusCallback callback handling finished";
+                const uint64_t firedNs = eventClockNs();
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterCameraStatusCallback callback got " << status;
+
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeDeviceStatus;
+                record.deviceId = deviceID;
+                record.payload.status = status;
+                postStateEvent(EventType::CameraStatus, deviceID, record);
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterCameraStatusCallback callback handling finished";
               } catch (const std::exception &e) {
                 const std::string errorMsg = "cameraStatusCallback callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "cameraStatusCallback callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               }
             });
 
             Jabra_RegisterNetworkStatusChangedCallback([] (unsigned short deviceID, NetworkInterface PHY, NetworkInterfaceStatus status) {
               try {
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterNetworkStatusChangedCallback callback got " << status;
-
-                auto networkStatusCallback = state_Jabra_Initialize.getnetworkStatusChangeCallback();
-
-                if (networkStatusCallback) {
-                  networkStatusCallback->call([deviceID, PHY, status](Napi::Env env, std::vector<napi_value>& args) {
-                    args = { Napi::Number::New(env, deviceID), Napi::Number::New(env, PHY), Napi::Number::New(env, status)};
-                  });
+                if (!shouldPostEvent(EventType::NetworkStatusChange, deviceID)) {
+                  return;
                 }
-                LOG_VERBOSE_(LOGINSTANCE) << "Jabra_RegisterNetworkStatusChangedCallback callback handling finished";
+                const uint64_t firedNs = eventClockNs();
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterNetworkStatusChangedCallback callback got " << status;
+
+                EventRecord record = {};
+                record.firedNs = firedNs;
+                record.decode = &decodeNetworkStatus;
+                record.deviceId = deviceID;
+                record.payload.network.phy = PHY;
+                record.payload.network.status = status;
+                postStateEvent(EventType::NetworkStatusChange, ((uint32_t)deviceID << 16) | PHY, record);
+                LOG_SAMPLED_CAT_(LogCategory::callbacks, plog::verbose) << "Jabra_RegisterNetworkStatusChangedCallback callback handling finished";
               } catch (const std::exception &e) {
                 const std::string errorMsg = "networkStatusCallback callback failed: " + std::string(e.what());
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               } catch (...) {
                 const std::string errorMsg = "networkStatusCallback callback failed failed with unknown exception";
-                LOG_FATAL_(LOGINSTANCE) << errorMsg;
+                LOG_FATAL_CAT_(LogCategory::callbacks) << errorMsg;
               }
             });
 
             // Finally, notify caller that init succeded:
-            auto initCallback = state_Jabra_Initialize.getInitializedCallback();
-            if (initCallback) {
-              initCallback->call([](Napi::Env env, std::vector<napi_value>& args) {
-                  args = { };
-              });
-            }
+            state_Jabra_Initialize.post(EventType::Initialized, [](Napi::Env env, const util::PropertyKeys& keys, std::vector<napi_value>& args) {
+                args = { };
+            });
           } else { // Init failed.
             LOG_FATAL_(LOGINSTANCE) << "Jabra_Initialize failed";
 
-            auto initCallback = state_Jabra_Initialize.getInitializedCallback();
-            if (initCallback) {
-              initCallback->error("Could not initialize jabra sdk");
-            }
+            state_Jabra_Initialize.post(EventType::Initialized, [](Napi::Env env, const util::PropertyKeys& keys, std::vector<napi_value>& args) {
+                args = { Napi::Error::New(env, "Could not initialize jabra sdk").Value() };
+            });
           }
       } catch (const std::exception &e) {       
         const std::string errorMsg = std::string(functionName) + " worker thread failed: " + std::string(e.what());
@@ -945,15 +1199,35 @@ Napi::Value napi_UnInitialize(const Napi::CallbackInfo& info) {
   return util::JSyncWrapper<Napi::Value>(__func__, info, [](const char * const functionName, const Napi::CallbackInfo& info) -> Napi::Value {
     Napi::Env env = info.Env();
     freeConstants();
+    unregisterDevices();
+    freeSettingsSnapshot();
+    freeSettingsSchemas();
+    freeEventSubscriptions();
     bool retv = Jabra_Uninitialize();
     if (retv) {
+      freeSettingsChangeListeners();
       // Properly need to be called from main thread - so not sure this can be async if we should want this ?
       state_Jabra_Initialize.done();
     }
+    // Write the log and stop its writer thread, so nothing is left for process exit - records
+    // logged after this are written directly until the sdk is initialized again.
+    stopAsyncLogging();
     return Napi::Boolean::New(env, retv);
   });
 }
 
+Napi::Value napi_GetEventChannelStatsSync(const Napi::CallbackInfo& info) {
+  return util::JSyncWrapper<Napi::Value>(__func__, info, [](const char * const functionName, const Napi::CallbackInfo& info) -> Napi::Value {
+    std::shared_ptr<EventChannel> eventChannel = state_Jabra_Initialize.getEventChannel();
+    if (!eventChannel) {
+      return info.Env().Null();
+    }
+    Napi::Object stats = eventChannel->getStats(info.Env());
+    addEventFilterStats(info.Env(), stats);
+    return stats;
+  });
+}
+
 Napi::Value napi_ConnectToJabraApplication(const Napi::CallbackInfo& info)
 {
   const char * const functionName = __func__;
@@ -964,7 +1238,7 @@ Napi::Value napi_ConnectToJabraApplication(const Napi::CallbackInfo& info)
     const std::string softphoneName = info[1].As<Napi::String>();    
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<bool, Napi::Boolean>(
+    util::QueueOnExecutor(new util::JAsyncWorker<bool, Napi::Boolean>(
       functionName, 
       javascriptResultCallback,
       [functionName, guid, softphoneName](){              
@@ -973,7 +1247,7 @@ Napi::Value napi_ConnectToJabraApplication(const Napi::CallbackInfo& info)
       [](const Napi::Env& env, const bool result) {
         return Napi::Boolean::New(env, result);
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -1002,13 +1276,13 @@ Napi::Value napi_SetSoftphoneReady(const Napi::CallbackInfo& info)
     const bool isReady = info[0].As<Napi::Boolean>().ToBoolean();
     Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnExecutor(new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, isReady](){              
         Jabra_SetSoftphoneReady(isReady);
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -1036,7 +1310,7 @@ Napi::Value napi_GetErrorString(const Napi::CallbackInfo& info)
     const Jabra_ReturnCode errorCode = (Jabra_ReturnCode)info[0].As<Napi::Number>().Uint32Value();  
     Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-    (new util::JAsyncWorker<const char *, Napi::String>(
+    util::QueueOnExecutor(new util::JAsyncWorker<const char *, Napi::String>(
       functionName,
       javascriptResultCallback,
       [functionName, errorCode](){              
@@ -1058,7 +1332,7 @@ Napi::Value napi_GetErrorString(const Napi::CallbackInfo& info)
       [](const char * result) {
         // Assume error strings does not need to be freed.
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -1086,7 +1360,7 @@ Napi::Value napi_PreloadDeviceInfo(const Napi::CallbackInfo& info) {
     const std::string zipFilename = info[0].As<Napi::String>();  
     Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();  
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnExecutor(new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, zipFilename](){ 
@@ -1096,7 +1370,7 @@ Napi::Value napi_PreloadDeviceInfo(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, Jabra_ReturnCode::FileWrite_Fail);
         } 
       }
-    ))->Queue();
+    ));
   }
   return env.Undefined();
 }
@@ -4,6 +4,7 @@
 
 Napi::Value napi_Initialize(const Napi::CallbackInfo& info);
 Napi::Value napi_UnInitialize(const Napi::CallbackInfo& info);
+Napi::Value napi_GetEventChannelStatsSync(const Napi::CallbackInfo& info);
 
 Napi::Value napi_ConnectToJabraApplication(const Napi::CallbackInfo& info);
 Napi::Value napi_DisconnectFromJabraApplication(const Napi::CallbackInfo& info);
@@ -18,12 +19,16 @@ Napi::Value napi_SyncExperiment(const Napi::CallbackInfo& info);
 
 /*
 * This class holds callback functions for usage in other compile units.
-* This class can access state_Jabra_Initialize where the pointers to the
-* thread safe callbacks are located in order to forward callback execution.
+* This class can access state_Jabra_Initialize where the event channel
+* is located in order to forward callback execution.
 */
 class internalCallbackManager
 {
 public:
     internalCallbackManager() = delete;
     static LinkQualityStatusListener& getLinkQualityCallback();
+    static SettingsListener& getSettingsChangeCallback();
+    static HeadDetectionStatusListener& getHeadDetectionStatusCallback();
+    static JackConnectorStatusListener& getJackConnectorStatusCallback();
+    static LinkConnectionStatusListener& getLinkConnectionStatusCallback();
 };
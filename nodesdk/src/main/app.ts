@@ -22,8 +22,9 @@ if (isNodeJs()) {
     events = require('events');
 } 
 
-import { DeviceInfo, RCCStatus, ConfigInfo, ConfigParamsCloud, GenericConfigParams, DeviceCatalogueParams,
-         FirmwareInfoType, SettingType, DeviceSettings } from './core-types';
+import { DeviceInfo, RCCStatus, ConfigInfo, ConfigParamsCloud, GenericConfigParams, EventDeliveryParams, DeviceCatalogueParams,
+         FirmwareInfoType, SettingType, DeviceSettings, ExecutorStats, EventChannelStats, PerfStats, EventTiming,
+         HeadDetectionStatus, LinkConnectionStatus, EventFilter } from './core-types';
 
 import { enumAPIReturnCode, enumDeviceErrorStatus, enumDeviceBtnType, enumDeviceConnectionType,
          enumSettingDataType, enumSettingCtrlType, enumSettingLoadMode, enumFirmwareEventStatus,
@@ -53,14 +54,18 @@ let jabraAppID: string | null = null;
  * @param appID The user should first register the app on [Jabra developer site](https://developer.jabra.com/) to get application id.
  * @param configCloudParams Optional configuration parameters for the sdk.
  * @param nonJabraDeviceDectection If true non Jabra and Jabra devices will be detected, false by default.
+ * @param eventDelivery Optional batching/coalescing of device events for high event rates.
  */
-export function createJabraApplication(appID: string, configCloudParams: ConfigParamsCloud = {}, nonJabraDeviceDectection: boolean = false): Promise<JabraType> {
+export function createJabraApplication(appID: string, configCloudParams: ConfigParamsCloud = {}, nonJabraDeviceDectection: boolean = false, eventDelivery?: EventDeliveryParams): Promise<JabraType> {
     if (!isNodeJs()) {
         return Promise.reject(new Error("This createJabraApplication() function needs to run under NodeJs and not in a browser"));
     }
 
     let options = configCloudParams ? JSON.parse(JSON.stringify(configCloudParams)) : {};
     options!.nonJabraDeviceDectection = nonJabraDeviceDectection;
+    if (eventDelivery) {
+        options!.eventDelivery = eventDelivery;
+    }
 
     if (!jabraApp) {
         _JabraNativeAddonLog(AddonLogSeverity.info, "createJabraApplication", "Init - Creating new jabraApp");
@@ -86,11 +91,12 @@ export namespace JabraTypeCallbacks {
     export type attach = (device: DeviceType) => void;
     export type detach = (device: DeviceType) => void;
     export type firstScanDone = () => void;
+    export type eventTiming = (timing: EventTiming) => void;
 }
 
-export type JabraTypeEvents = 'attach' | 'detach' | 'firstScanDone';
+export type JabraTypeEvents = 'attach' | 'detach' | 'firstScanDone' | 'eventTiming';
 
-export const JabraEventsList: JabraTypeEvents[] = ['attach', 'detach', 'firstScanDone'];
+export const JabraEventsList: JabraTypeEvents[] = ['attach', 'detach', 'firstScanDone', 'eventTiming'];
 
 /** 
  * Main API class return by createJabraApplication.   
@@ -129,6 +135,19 @@ export class JabraType implements MetaApi {
     
         this.deviceTypes = new Map<number, DeviceType>();
 
+        // In batched mode native code passes an array of argument lists per call - unpack them so handlers stay unchanged.
+        // With timing native code appends the event timing to the arguments - emit it once the event has been handled:
+        const batched = !!(configParams.eventDelivery && configParams.eventDelivery.batched);
+        const timing = !!(configParams.eventDelivery && configParams.eventDelivery.timing);
+        const deliver = <T extends (...args: any[]) => void>(handler: T): T => {
+            const timed = timing ? ((...args: any[]) => {
+                const eventTiming = args.pop() as EventTiming;
+                handler(...args);
+                this.eventEmitter.emit('eventTiming', eventTiming);
+            }) : handler;
+            return batched ? ((events: any[][]) => events.forEach((args) => timed(...args))) as T : timed as T;
+        };
+
         this.firstScanForDevicesDonePromise = new Promise<void>(( firstScanForDevicesDoneResolve, firstScanForDevicesDoneReject ) => {
             sdkIntegration.Initialize( appID, (err : JabraError, success: any) => {
                 try {
@@ -145,7 +164,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::success callback", err);
                 }
-            }, (event_time_ms : number) => {
+            }, deliver((event_time_ms : number) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::firstScanDone", (() =>`firstScanDone event received from native sdk with event_time_ms=${event_time_ms}`));
                     this.eventEmitter.emit('firstScanDone', undefined);
@@ -154,7 +173,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::firstScanDone callback", err);
                 }
-            }, (deviceData : DeviceInfo, event_time_ms : number) => {
+            }), deliver((deviceData : DeviceInfo, event_time_ms : number) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::attach", (() =>`attach event received from native sdk with deviceData=${JSON.stringify(deviceData, null, 3)}, event_time_ms=${event_time_ms}`));
                     let deviceType = new DeviceType(deviceData, event_time_ms);
@@ -164,7 +183,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::attach callback", err);
                 }
-            }, (deviceId : number, event_time_ms : number) => {
+            }), deliver((deviceId : number, event_time_ms : number) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::detach", (() =>`detach event received from native sdk with deviceId=${deviceId}, event_time_ms=${event_time_ms}`));
                     let deviceType = this.deviceTypes.get(deviceId);
@@ -180,7 +199,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::detach callback", err);
                 }
-            }, (deviceId : number, translatedInData : enumDeviceBtnType, buttonInData : boolean) => {
+            }), deliver((deviceId : number, translatedInData : enumDeviceBtnType, buttonInData : boolean) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::buttonInDataTranslated", (() => `buttonInDataTranslated event received from native sdk with translatedInData=${translatedInData}, buttonInData=${buttonInData}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -193,7 +212,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::buttonInDataTranslated callback", err)
                 }
-            }, (deviceId : number, jsonData : string) => {
+            }), deliver((deviceId : number, jsonData : string) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onDevLogEvent", (() => `onDevLogEvent event received from native sdk with jsonData=${jsonData}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -207,7 +226,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onDevLogEvent callback", err)
                 }
-            }, (deviceId : number) => {
+            }), deliver((deviceId : number) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onDiagLogEvent", (() => `onDiagLogEvent event received from native sdk`));
                     let device = this.deviceTypes.get(deviceId);
@@ -220,7 +239,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onDiagLogEvent callback", err);
                 }
-            }, (deviceId : number, levelInPercent : number, isCharging : boolean, isBatteryLow : boolean) => {
+            }), deliver((deviceId : number, levelInPercent : number, isCharging : boolean, isBatteryLow : boolean) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onBatteryStatusUpdate", (() => `onBatteryStatusUpdate event received from native sdk with levelInPercent=${levelInPercent}, isCharging=${isCharging}, isBatteryLow=${isBatteryLow}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -233,7 +252,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onBatteryStatusUpdate callback", err)
                 }
-            }, (deviceId : number, type : enumRemoteMmiType, input : enumRemoteMmiInput) => {
+            }), deliver((deviceId : number, type : enumRemoteMmiType, input : enumRemoteMmiInput) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onRemoteMmiEvent", (() => `onRemoteMmiEvent event received from native sdk with type=${type}, input=${input}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -246,7 +265,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onRemoteMmiEvent callback", err)
                 }
-            }, (deviceId : number, status : boolean) => {
+            }), deliver((deviceId : number, status : boolean) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onxpressConnectionStatusEvent", (() => `onxpressConnectionStatusEvent event received from native sdk with status=${status}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -259,7 +278,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onxpressConnectionStatusEvent callback", err)
                 } 
-            }, (deviceId : number, type : enumFirmwareEventType, status : enumFirmwareEventStatus, dwnFirmPercentage : number) => {
+            }), deliver((deviceId : number, type : enumFirmwareEventType, status : enumFirmwareEventStatus, dwnFirmPercentage : number) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::downloadFirmwareProgress", (() => `downloadFirmwareProgress event received from native sdk with type=${type}, status=${status}, dwnFirmPercentage=${dwnFirmPercentage}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -272,7 +291,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::downloadFirmwareProgress callback", err)
                 }                
-            }, (deviceId : number, status : enumUploadEventStatus, percentage : number) => {
+            }), deliver((deviceId : number, status : enumUploadEventStatus, percentage : number) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onUploadProgress", (() => `onUploadProgress event received from native sdk with status ${status}, percentage ${percentage}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -285,7 +304,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onUploadProgress callback", err)
                 }
-            }, (deviceId : number, pairedListInfo : PairedListInfo) => {
+            }), deliver((deviceId : number, pairedListInfo : PairedListInfo) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onBTParingListChange", (() => `onBTParingListChange event received from native sdk with pairedListInfo ${JSON.stringify(pairedListInfo, null, 3)}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -298,7 +317,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onBTParingListChange callback", err)
                 }
-            }, (deviceId : number, buttonEvents : Array<{ buttonTypeKey: number, buttonTypeValue: string, buttonEventType: Array<{ key: number, value: string }> }>) => {
+            }), deliver((deviceId : number, buttonEvents : Array<{ buttonTypeKey: number, buttonTypeValue: string, buttonEventType: Array<{ key: number, value: string }> }>) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onGNPBtnEvent", (() => `onGNPBtnEvent event received from native sdk with buttonEvents=${buttonEvents}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -311,7 +330,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onGNPBtnEventChange callback", err)
                 }
-            }, (deviceId : number, dectInfo : DectInfo) => {
+            }), deliver((deviceId : number, dectInfo : DectInfo) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onDectInfoEvent", (() => `onDectInfoEvent event received from native sdk with dectInfo=${dectInfo}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -324,7 +343,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onDectInfoEvent callback", err);
                 }
-            }, (deviceId : number, status : boolean) => {
+            }), deliver((deviceId : number, status : boolean) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onCameraStatusEvent", (() => `onCameraStatusEvent event received from native sdk with cameraStatus=${status}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -337,7 +356,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onCameraStatusEvent callback", err);
                 }
-            }, (deviceId : number, linkQuality : enumBTLinkQuality) => {
+            }), deliver((deviceId : number, linkQuality : enumBTLinkQuality) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onBluetoothLinkQualityChangeEvent", (() => `onBluetoothLinkQualityChangeEvent event received from native sdk with linkQuality=${linkQuality}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -350,7 +369,7 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onBluetoothLinkQualityChangeEvent callback", err);
                 }
-            }, (deviceId : number, PHY : enumNetworkInterface, status : enumNetworkInterfaceStatus) => {
+            }), deliver((deviceId : number, PHY : enumNetworkInterface, status : enumNetworkInterfaceStatus) => {
                 try {
                     _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onNetworkStatusChangedEvent", (() => `onNetworkStatusChangedEvent event received from native sdk with interface=${PHY} and status=${status}`));
                     let device = this.deviceTypes.get(deviceId);
@@ -363,7 +382,59 @@ export class JabraType implements MetaApi {
                     // Log but do not propagate js errors into native caller (or node process will be aborted):
                     _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onNetworkStatusChangedEvent callback", err);
                 }
-            },
+            }), deliver((deviceId : number, guids : string[]) => {
+                try {
+                    _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onSettingsChanged", (() => `onSettingsChanged event received from native sdk with guids=${JSON.stringify(guids)}`));
+                    let device = this.deviceTypes.get(deviceId);
+                    if (device) {
+                        device._eventEmitter.emit('onSettingsChanged', guids);
+                    } else {
+                        _JabraNativeAddonLog(AddonLogSeverity.error, "onSettingsChanged callback", "Could not lookup device with id " + deviceId);
+                    }
+                } catch (err) {
+                    // Log but do not propagate js errors into native caller (or node process will be aborted):
+                    _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onSettingsChanged callback", err);
+                }
+            }), deliver((deviceId : number, status : HeadDetectionStatus) => {
+                try {
+                    _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onHeadDetectionStatusEvent", (() => `onHeadDetectionStatusEvent event received from native sdk with leftOn=${status.leftOn} and rightOn=${status.rightOn}`));
+                    let device = this.deviceTypes.get(deviceId);
+                    if (device) {
+                        device._eventEmitter.emit('onHeadDetectionStatusEvent', status);
+                    } else {
+                        _JabraNativeAddonLog(AddonLogSeverity.error, "onHeadDetectionStatusEvent callback", "Could not lookup device with id " + deviceId);
+                    }
+                } catch (err) {
+                    // Log but do not propagate js errors into native caller (or node process will be aborted):
+                    _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onHeadDetectionStatusEvent callback", err);
+                }
+            }), deliver((deviceId : number, inserted : boolean) => {
+                try {
+                    _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onJackConnectorStatusEvent", (() => `onJackConnectorStatusEvent event received from native sdk with inserted=${inserted}`));
+                    let device = this.deviceTypes.get(deviceId);
+                    if (device) {
+                        device._eventEmitter.emit('onJackConnectorStatusEvent', inserted);
+                    } else {
+                        _JabraNativeAddonLog(AddonLogSeverity.error, "onJackConnectorStatusEvent callback", "Could not lookup device with id " + deviceId);
+                    }
+                } catch (err) {
+                    // Log but do not propagate js errors into native caller (or node process will be aborted):
+                    _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onJackConnectorStatusEvent callback", err);
+                }
+            }), deliver((deviceId : number, status : LinkConnectionStatus) => {
+                try {
+                    _JabraNativeAddonLog(AddonLogSeverity.verbose, "JabraType::constructor::onLinkConnectionStatusEvent", (() => `onLinkConnectionStatusEvent event received from native sdk with open=${status.open} and component=${status.component}`));
+                    let device = this.deviceTypes.get(deviceId);
+                    if (device) {
+                        device._eventEmitter.emit('onLinkConnectionStatusEvent', status);
+                    } else {
+                        _JabraNativeAddonLog(AddonLogSeverity.error, "onLinkConnectionStatusEvent callback", "Could not lookup device with id " + deviceId);
+                    }
+                } catch (err) {
+                    // Log but do not propagate js errors into native caller (or node process will be aborted):
+                    _JabraNativeAddonLog(AddonLogSeverity.error, "JabraType::constructor::onLinkConnectionStatusEvent callback", err);
+                }
+            }),
             configParams);  
         });
     }
@@ -502,6 +573,64 @@ export class JabraType implements MetaApi {
         });
     }
 
+    /**
+     * Get queue depth and wait-time statistics for the native executor that runs all
+     * async calls. Calls for the same device are serialized, while calls for different
+     * devices run in parallel on a bounded thread pool.
+     * @returns {ExecutorStats} - Current executor statistics.
+     */
+    getExecutorStats(): ExecutorStats {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getExecutorStats.name, "called");
+        const result = sdkIntegration.GetExecutorStatsSync();
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getExecutorStats.name, "returned with", result);
+        return result;
+    }
+
+    /**
+     * Get latency percentiles (p50, p90, p99 and max) per native function, split into time
+     * queued, time running the Jabra SDK call, time mapping the result and time in the callback.
+     * Use this to find slow device calls.
+     * @returns {PerfStats} - Latency statistics since startup or the last resetPerfStats call.
+     */
+    getPerfStats(): PerfStats {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getPerfStats.name, "called");
+        const result = sdkIntegration.GetPerfStatsSync();
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getPerfStats.name, "returned with", result);
+        return result;
+    }
+
+    /**
+     * Restart the latency statistics returned by getPerfStats.
+     */
+    resetPerfStats(): void {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.resetPerfStats.name, "called");
+        sdkIntegration.ResetPerfStats();
+    }
+
+    /**
+     * Get queue depth and per event delivered/dropped counters for the bounded native
+     * channel that delivers all device events to javascript.
+     * @returns {EventChannelStats | null} - Current event channel statistics or null if not initialized.
+     */
+    getEventChannelStats(): EventChannelStats | null {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getEventChannelStats.name, "called");
+        const result = sdkIntegration.GetEventChannelStatsSync();
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getEventChannelStats.name, "returned with", result);
+        return result;
+    }
+
+    /**
+     * Drop device events natively by device, event type and rate before they are copied or
+     * queued for javascript. Replaces any previous filter - call with an empty filter to pass
+     * all events again. Dropped events are counted in getEventChannelStats.
+     * @param {EventFilter} filter - Devices, device event names and minimum intervals to pass.
+     */
+    setEventFilter(filter: EventFilter): void {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.setEventFilter.name, "called with", filter);
+        sdkIntegration.SetEventFilter(filter);
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.setEventFilter.name, "returned");
+    }
+
     /** 
      * Internal function for N-API experimentation only - it may be removed/changed at 
      * any time without warning - do not call.
@@ -561,14 +690,22 @@ export class JabraType implements MetaApi {
     on(event: 'firstScanDone', listener: JabraTypeCallbacks.firstScanDone): this;
 
     /**
-     * Add event handler for attach, detach or firstScanDone device events. The attach event is 
+     * Add event handler for the timing of device events through the native sdk. Only emitted if
+     * createJabraApplication was called with eventDelivery.timing set.
+     * 
+     * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
+     */
+    on(event: 'eventTiming', listener: JabraTypeCallbacks.eventTiming): this;
+
+    /**
+     * Add event handler for attach, detach, firstScanDone or eventTiming events. The attach event is 
      * particulary important, since this callback is where you get a reference to a DeviceType
      * object with detailed API for the device.
      * 
      * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
      */
     on(event: JabraTypeEvents,
-        listener: JabraTypeCallbacks.attach | JabraTypeCallbacks.detach | JabraTypeCallbacks.firstScanDone): this {
+        listener: JabraTypeCallbacks.attach | JabraTypeCallbacks.detach | JabraTypeCallbacks.firstScanDone | JabraTypeCallbacks.eventTiming): this {
 
         _JabraNativeAddonLog(AddonLogSeverity.verbose, this.on.name, "called with", event, "<listener>"); 
 
@@ -601,12 +738,19 @@ export class JabraType implements MetaApi {
     off(event: 'firstScanDone', listener: JabraTypeCallbacks.firstScanDone): this;
 
     /**
-     * Remove previosly setup event handler for attach, detach or firstScanDone device events.
+     * Remove previosly setup event handler for eventTiming events.
+     * 
+     * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
+     */
+    off(event: 'eventTiming', listener: JabraTypeCallbacks.eventTiming): this;
+
+    /**
+     * Remove previosly setup event handler for attach, detach, firstScanDone or eventTiming events.
      * 
      * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
      */
     off(event: JabraTypeEvents,
-        listener: JabraTypeCallbacks.attach | JabraTypeCallbacks.detach | JabraTypeCallbacks.firstScanDone): this {
+        listener: JabraTypeCallbacks.attach | JabraTypeCallbacks.detach | JabraTypeCallbacks.firstScanDone | JabraTypeCallbacks.eventTiming): this {
 
         _JabraNativeAddonLog(AddonLogSeverity.verbose, this.off.name, "called with", event, "<listener>"); 
 
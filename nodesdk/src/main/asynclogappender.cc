@@ -0,0 +1,372 @@
+#include "asynclogappender.h"
+
+#include <plog/Converters/UTF8Converter.h>
+#include <plog/Formatters/TxtFormatter.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// Upper bound on records per write call, so a flood of records still gets written in steps.
+const size_t MAX_BATCH_RECORDS = 1024;
+
+// Slot strings keep their capacity for reuse - except after unusually long messages.
+const size_t MAX_RETAINED_MESSAGE = 4096;
+
+// Producers do not take the lock to wake the writer, so a wake-up can be missed. The writer
+// never sleeps longer than this.
+const std::chrono::milliseconds MAX_IDLE_WAIT(100);
+
+/**
+ * Record as captured on the logging thread, presented to the encoder on the writer thread.
+ */
+class QueuedRecord : public plog::Record
+{
+  public:
+    QueuedRecord(const plog::Severity severity, const plog::util::Time& time, const unsigned int tid, const size_t line,
+                 const void* object, const char* file, const std::string& func, const plog::util::nstring& message)
+      : plog::Record(severity, nullptr, line, file, object), time(time), tid(tid), func(func), message(message) {}
+
+    const plog::util::Time& getTime() const override { return time; }
+    unsigned int getTid() const override { return tid; }
+    const char* getFunc() const override { return func.c_str(); }
+    const plog::util::nchar* getMessage() const override { return message.c_str(); }
+
+  private:
+    const plog::util::Time& time;
+    const unsigned int tid;
+    const std::string& func;
+    const plog::util::nstring& message;
+};
+
+} // namespace
+
+std::string TxtLogEncoder::header() {
+  return plog::UTF8Converter::convert(plog::TxtFormatter::header());
+}
+
+void TxtLogEncoder::encode(const plog::Record& record, std::string& out) {
+  out += plog::UTF8Converter::convert(plog::TxtFormatter::format(record));
+}
+
+AsyncLogAppender::AsyncLogAppender(const plog::util::nchar* fileName, size_t maxFileSize, int maxFiles, std::unique_ptr<LogEncoder> encoder, size_t capacity)
+  : encoder(std::move(encoder)),
+    capacity([capacity]() { size_t c = 64; while (c < capacity) c <<= 1; return c; }()),
+    ring(new Slot[this->capacity]),
+    enqueuePos(0),
+    dequeuePos(0),
+    written(0),
+    dropped(0),
+    batches(0),
+    writerIdle(false),
+    stopping(false),
+    direct(false),
+    fileSize(0),
+    maxFileSize((std::max)(static_cast<off_t>(maxFileSize), static_cast<off_t>(1000))), // same lower limit as plog
+    lastFileNumber((std::max)(maxFiles - 1, 0)),
+    firstWrite(true) {
+  for (size_t i = 0; i < this->capacity; ++i) {
+    ring[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  plog::util::splitFileName(fileName, fileNameNoExt, fileExt);
+
+  writer = std::thread(&AsyncLogAppender::run, this);
+}
+
+AsyncLogAppender::~AsyncLogAppender() {
+  stop();
+}
+
+void AsyncLogAppender::stop() {
+  std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex);
+  if (!writer.joinable()) {
+    return;
+  }
+
+  flush();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wakeUp.notify_one();
+  progress.notify_all();
+  writer.join();
+
+  {
+    std::lock_guard<std::mutex> lock(directMutex);
+    direct = true;
+  }
+
+  // Records published while the writer was shutting down.
+  writeDirect();
+}
+
+void AsyncLogAppender::start() {
+  std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex);
+  if (writer.joinable()) {
+    return;
+  }
+
+  // Taking directMutex waits for logging threads still writing directly.
+  std::lock_guard<std::mutex> directLock(directMutex);
+  direct = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = false;
+  }
+  writer = std::thread(&AsyncLogAppender::run, this);
+}
+
+void AsyncLogAppender::write(const plog::Record& record) {
+  const plog::Severity severity = record.getSeverity();
+  uint64_t pos;
+  Slot* slot = claim(severity, pos);
+  if (!slot) {
+    return;
+  }
+
+  Entry& entry = slot->entry;
+  entry.severity = severity;
+  entry.time = record.getTime();
+  entry.tid = record.getTid();
+  entry.line = record.getLine();
+  entry.object = record.getObject();
+  entry.file = record.getFile();
+  entry.func.assign(record.getFunc());
+  entry.message.assign(record.getMessage());
+  publish(severity, slot, pos);
+}
+
+void AsyncLogAppender::enqueue(plog::Severity severity, const std::string& func, const std::string& message) {
+  // Cached per thread - looking up the thread id is a system call on some platforms.
+  static thread_local const unsigned int tid = plog::util::gettid();
+
+  uint64_t pos;
+  Slot* slot = claim(severity, pos);
+  if (!slot) {
+    return;
+  }
+
+  Entry& entry = slot->entry;
+  entry.severity = severity;
+  plog::util::ftime(&entry.time);
+  entry.tid = tid;
+  entry.line = 0;
+  entry.object = nullptr;
+  entry.file = nullptr;
+  entry.func.assign(func);
+#ifdef _WIN32
+  entry.message = plog::util::toWide(message.c_str());
+#else
+  entry.message.assign(message);
+#endif
+  publish(severity, slot, pos);
+}
+
+AsyncLogAppender::Slot* AsyncLogAppender::claim(plog::Severity severity, uint64_t& pos) {
+  pos = enqueuePos.load(std::memory_order_relaxed);
+  while (true) {
+    Slot* slot = &ring[pos & (capacity - 1)];
+    const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const int64_t diff = (int64_t)sequence - (int64_t)pos;
+    if (diff == 0) {
+      if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        return slot;
+      }
+    } else if (diff < 0) {
+      // Full - never hold up the caller for anything but fatal records.
+      if (severity != plog::fatal) {
+        ++dropped;
+        return nullptr;
+      }
+      if (direct) {
+        writeDirect();
+      } else {
+        wakeUp.notify_one();
+      }
+      std::this_thread::yield();
+      pos = enqueuePos.load(std::memory_order_relaxed);
+    } else {
+      pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void AsyncLogAppender::publish(plog::Severity severity, Slot* slot, uint64_t pos) {
+  slot->sequence.store(pos + 1, std::memory_order_release);
+
+  if (direct) {
+    writeDirect();
+    return;
+  }
+
+  if (writerIdle.load()) {
+    wakeUp.notify_one();
+  }
+
+  if (severity == plog::fatal) {
+    flush();
+  }
+}
+
+void AsyncLogAppender::flush() {
+  const uint64_t target = enqueuePos.load();
+  wakeUp.notify_one();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  progress.wait(lock, [this, target]() { return stopping || written.load() >= target; });
+}
+
+AsyncLogStats AsyncLogAppender::getStats() const {
+  AsyncLogStats stats;
+  stats.capacity = capacity;
+  stats.written = written.load();
+  stats.queued = enqueuePos.load() - stats.written;
+  stats.dropped = dropped.load();
+  stats.batches = batches.load();
+  return stats;
+}
+
+// Only called on the writer thread (or under directMutex while it is stopped). Encodes the next
+// published record into batch.
+bool AsyncLogAppender::tryPop(std::string& batch, std::string& scratch) {
+  Slot& slot = ring[dequeuePos & (capacity - 1)];
+  const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+  if ((int64_t)sequence - (int64_t)(dequeuePos + 1) < 0) {
+    return false; // Empty or next record not yet published.
+  }
+
+  Entry& entry = slot.entry;
+  scratch.clear();
+  encoder->encode(QueuedRecord(entry.severity, entry.time, entry.tid, entry.line, entry.object, entry.file, entry.func, entry.message), scratch);
+  batch += scratch;
+
+  if (entry.message.capacity() > MAX_RETAINED_MESSAGE) {
+    plog::util::nstring().swap(entry.message);
+  }
+
+  slot.sequence.store(dequeuePos + capacity, std::memory_order_release);
+  ++dequeuePos;
+  return true;
+}
+
+// Write the next batch of published records - returns the number of records written.
+size_t AsyncLogAppender::writeNext(std::string& batch, std::string& scratch) {
+  batch.clear();
+  size_t count = 0;
+
+  if (firstWrite && enqueuePos.load() != dequeuePos) {
+    openLogFile();
+    firstWrite = false;
+  }
+
+  while (count < MAX_BATCH_RECORDS) {
+    // Roll before the record that would be written to a full file. Flush what is already
+    // encoded first, as encoders may keep per file state.
+    if (lastFileNumber > 0 && -1 != fileSize && fileSize + (off_t)batch.size() > maxFileSize && enqueuePos.load() != dequeuePos) {
+      if (!batch.empty()) {
+        break;
+      }
+      rollLogFiles();
+    }
+
+    if (!tryPop(batch, scratch)) {
+      break;
+    }
+    ++count;
+  }
+
+  if (count > 0) {
+    writeBatch(batch);
+    ++batches;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      written += count;
+    }
+    progress.notify_all();
+  }
+  return count;
+}
+
+// Called on logging threads while the writer thread is stopped.
+void AsyncLogAppender::writeDirect() {
+  std::lock_guard<std::mutex> lock(directMutex);
+  if (!direct) {
+    return; // Restarted meanwhile - the writer thread picks the records up.
+  }
+
+  std::string batch;
+  std::string scratch;
+  while (writeNext(batch, scratch) > 0) {
+  }
+}
+
+void AsyncLogAppender::run() {
+  std::string batch;
+  std::string scratch;
+
+  while (true) {
+    if (writeNext(batch, scratch) > 0) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (stopping) {
+      break;
+    }
+    writerIdle = true;
+    wakeUp.wait_for(lock, MAX_IDLE_WAIT, [this]() {
+      return stopping || (int64_t)ring[dequeuePos & (capacity - 1)].sequence.load(std::memory_order_acquire) - (int64_t)(dequeuePos + 1) >= 0;
+    });
+    writerIdle = false;
+  }
+}
+
+void AsyncLogAppender::writeBatch(const std::string& batch) {
+  const int bytesWritten = logFile.write(batch.data(), batch.size());
+  if (bytesWritten > 0) {
+    fileSize += bytesWritten;
+  }
+}
+
+void AsyncLogAppender::openLogFile() {
+  encoder->reset();
+
+  const plog::util::nstring fileName = buildFileName();
+  fileSize = logFile.open(fileName.c_str());
+
+  if (0 == fileSize) {
+    writeBatch(encoder->header());
+  }
+}
+
+void AsyncLogAppender::rollLogFiles() {
+  logFile.close();
+
+  const plog::util::nstring lastFileName = buildFileName(lastFileNumber);
+  plog::util::File::unlink(lastFileName.c_str());
+
+  for (int fileNumber = lastFileNumber - 1; fileNumber >= 0; --fileNumber) {
+    const plog::util::nstring currentFileName = buildFileName(fileNumber);
+    const plog::util::nstring nextFileName = buildFileName(fileNumber + 1);
+    plog::util::File::rename(currentFileName.c_str(), nextFileName.c_str());
+  }
+
+  openLogFile();
+}
+
+plog::util::nstring AsyncLogAppender::buildFileName(int fileNumber) const {
+  plog::util::nostringstream ss;
+  ss << fileNameNoExt;
+
+  if (fileNumber > 0) {
+    ss << '.' << fileNumber;
+  }
+
+  if (!fileExt.empty()) {
+    ss << '.' << fileExt;
+  }
+
+  return ss.str();
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <plog/Appenders/IAppender.h>
+#include <plog/Record.h>
+#include <plog/Util.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Turns log records into the bytes written to the log file. Only used on the writer thread.
+ */
+class LogEncoder
+{
+  public:
+    virtual ~LogEncoder() {}
+
+    /**
+     * Bytes written at the start of every new (empty) log file.
+     */
+    virtual std::string header() = 0;
+
+    /**
+     * Append the encoded record to out.
+     */
+    virtual void encode(const plog::Record& record, std::string& out) = 0;
+
+    /**
+     * Called when a new log file is started (encoders keeping per file state must reset it).
+     */
+    virtual void reset() {}
+};
+
+/**
+ * Plain text lines like plog's default TxtFormatter.
+ */
+class TxtLogEncoder : public LogEncoder
+{
+  public:
+    std::string header() override;
+    void encode(const plog::Record& record, std::string& out) override;
+};
+
+/**
+ * Counters for the async appender - see AsyncLogAppender::getStats.
+ */
+struct AsyncLogStats {
+  size_t capacity;
+  uint64_t queued;
+  uint64_t written;
+  uint64_t dropped;
+  uint64_t batches;
+};
+
+/**
+ * plog appender that keeps formatting and file I/O off the logging threads.
+ *
+ * write() copies the record into a preallocated lock-free multi-producer/single-consumer ring
+ * and returns. A single writer thread encodes everything queued and writes it to a rolling log
+ * file (same naming and rolling as plog's RollingFileAppender) with one write call per batch.
+ * When the ring is full records are dropped and counted instead of blocking the caller - except
+ * fatal records, which wait until they have been written.
+ *
+ * The writer thread is stopped explicitly with stop() (f.x. when the environment is torn down)
+ * rather than joined by a static destructor at process exit. While it is stopped, every logging
+ * thread writes the queued records itself under a lock, so nothing logged late is lost.
+ */
+class AsyncLogAppender : public plog::IAppender
+{
+  public:
+    AsyncLogAppender(const plog::util::nchar* fileName, size_t maxFileSize, int maxFiles, std::unique_ptr<LogEncoder> encoder, size_t capacity);
+    ~AsyncLogAppender();
+
+    AsyncLogAppender(const AsyncLogAppender&) = delete;
+    AsyncLogAppender& operator=(const AsyncLogAppender&) = delete;
+
+    void write(const plog::Record& record) override;
+
+    /**
+     * Queue a message without building a plog::Record first (used for messages logged from
+     * javascript). The caller must have checked the severity against the logger.
+     */
+    void enqueue(plog::Severity severity, const std::string& func, const std::string& message);
+
+    /**
+     * Wait until all records queued before the call have been written. Must not be called
+     * from the writer thread.
+     */
+    void flush();
+
+    /**
+     * Write everything queued and stop the writer thread. Records logged after that are written
+     * on the logging thread until start() is called. Must not be called from the writer thread.
+     */
+    void stop();
+
+    /**
+     * Restart the writer thread after stop().
+     */
+    void start();
+
+    AsyncLogStats getStats() const;
+
+  private:
+    struct Entry {
+      plog::Severity severity;
+      plog::util::Time time;
+      unsigned int tid;
+      size_t line;
+      const void* object;
+      const char* file;
+      std::string func;
+      plog::util::nstring message;
+    };
+
+    struct Slot {
+      std::atomic<uint64_t> sequence;
+      Entry entry;
+    };
+
+    Slot* claim(plog::Severity severity, uint64_t& pos);
+    void publish(plog::Severity severity, Slot* slot, uint64_t pos);
+    bool tryPop(std::string& batch, std::string& scratch);
+    size_t writeNext(std::string& batch, std::string& scratch);
+    void writeDirect();
+    void run();
+    void writeBatch(const std::string& batch);
+    void openLogFile();
+    void rollLogFiles();
+    plog::util::nstring buildFileName(int fileNumber = 0) const;
+
+    std::unique_ptr<LogEncoder> encoder;
+
+    // Ring (producers: any thread, consumer: writer thread).
+    const size_t capacity;
+    std::unique_ptr<Slot[]> ring;
+    std::atomic<uint64_t> enqueuePos;
+    uint64_t dequeuePos;
+
+    std::atomic<uint64_t> written;
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> batches;
+    std::atomic<bool> writerIdle;
+    std::atomic<bool> stopping;
+
+    // Set while the writer thread is stopped - logging threads then write under directMutex.
+    std::atomic<bool> direct;
+    std::mutex directMutex;
+
+    // Serializes stop() and start().
+    std::mutex lifecycleMutex;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable progress;
+
+    // Rolling file - only touched by the writer thread (or under directMutex while it is stopped).
+    plog::util::File logFile;
+    off_t fileSize;
+    const off_t maxFileSize;
+    const int lastFileNumber;
+    bool firstWrite;
+    plog::util::nstring fileNameNoExt;
+    plog::util::nstring fileExt;
+
+    std::thread writer;
+};
@@ -0,0 +1,94 @@
+#include "binarylogencoder.h"
+#include "binarylogformat.h"
+
+#include <plog/Converters/UTF8Converter.h>
+
+namespace {
+
+// Bounds for the per file string table. Only short messages are worth deduplicating - longer
+// ones nearly always carry variable data.
+const size_t MAX_STRINGS = 65536;
+const size_t MAX_DEDUP_MESSAGE = 128;
+
+} // namespace
+
+BinaryLogEncoder::BinaryLogEncoder() : lastTime(0), resetPending(true) {}
+
+std::string BinaryLogEncoder::header() {
+  std::string result(binarylog::MAGIC, binarylog::MAGIC_SIZE);
+  result += static_cast<char>(binarylog::VERSION);
+  return result;
+}
+
+void BinaryLogEncoder::reset() {
+  strings.clear();
+  seenMessages.clear();
+  lastTime = 0;
+  resetPending = true;
+}
+
+void BinaryLogEncoder::encode(const plog::Record& record, std::string& out) {
+  if (resetPending) {
+    putRecord(out, binarylog::RECORD_RESET, std::string());
+    resetPending = false;
+  }
+
+  const uint64_t callerId = stringId(record.getFunc(), out);
+
+  // Messages are only given an id once they repeat, so one-off messages do not fill the table.
+  utf8 = plog::UTF8Converter::convert(record.getMessage());
+  uint64_t messageId = 0;
+  if (utf8.size() <= MAX_DEDUP_MESSAGE) {
+    auto it = strings.find(utf8);
+    if (it != strings.end()) {
+      messageId = it->second;
+    } else if (!seenMessages.insert(std::hash<std::string>()(utf8)).second) {
+      messageId = stringId(utf8, out);
+    } else if (seenMessages.size() > MAX_STRINGS) {
+      seenMessages.clear();
+    }
+  }
+
+  const plog::util::Time& time = record.getTime();
+  const int64_t timeMs = static_cast<int64_t>(time.time) * 1000 + time.millitm;
+
+  payload.clear();
+  payload += static_cast<char>(record.getSeverity());
+  binarylog::putZigzag(payload, timeMs - lastTime);
+  binarylog::putVarint(payload, record.getTid());
+  binarylog::putVarint(payload, callerId);
+  binarylog::putVarint(payload, record.getLine());
+  binarylog::putVarint(payload, messageId);
+  if (messageId == 0) {
+    payload += utf8;
+  }
+  putRecord(out, binarylog::RECORD_LOG, payload);
+
+  lastTime = timeMs;
+}
+
+uint64_t BinaryLogEncoder::stringId(const std::string& str, std::string& out) {
+  auto it = strings.find(str);
+  if (it != strings.end()) {
+    return it->second;
+  }
+
+  if (strings.size() >= MAX_STRINGS) {
+    return 0;
+  }
+
+  const uint64_t id = strings.size() + 1;
+  strings.emplace(str, id);
+
+  std::string definition;
+  binarylog::putVarint(definition, id);
+  definition += str;
+  putRecord(out, binarylog::RECORD_STRING, definition);
+  return id;
+}
+
+void BinaryLogEncoder::putRecord(std::string& out, uint8_t type, const std::string& payload) {
+  out += static_cast<char>(type);
+  binarylog::putVarint(out, payload.size());
+  out += payload;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "asynclogappender.h"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * Encodes log records in the compact binary format described in binarylogformat.h. Caller names
+ * and repeated short messages are written once per file and referenced by id after that.
+ * Decode files with the jabra-log-decode tool.
+ */
+class BinaryLogEncoder : public LogEncoder
+{
+  public:
+    BinaryLogEncoder();
+
+    std::string header() override;
+    void encode(const plog::Record& record, std::string& out) override;
+    void reset() override;
+
+  private:
+    // Returns the id of str, emitting a STRING record for it first if it is new. Returns 0 if
+    // the string table is full.
+    uint64_t stringId(const std::string& str, std::string& out);
+    void putRecord(std::string& out, uint8_t type, const std::string& payload);
+
+    std::unordered_map<std::string, uint64_t> strings;
+    std::unordered_set<size_t> seenMessages;
+    int64_t lastTime;
+    bool resetPending;
+    std::string payload;
+    std::string utf8;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Compact binary format for the native log file (selected with LIBJABRA_NODE_LOG_FORMAT=binary).
+ * Shared between the binary log encoder and the jabra-log-decode tool, so it must not depend on
+ * node or plog.
+ *
+ * A file starts with the magic "JNBLOG" and a version byte, followed by records:
+ *
+ *   type (1 byte) | payload length (varint) | payload
+ *
+ * Record types:
+ * - RESET:  (empty) Forget all string definitions and the previous timestamp. Written whenever
+ *           logging (re)starts in a file.
+ * - STRING: id (varint) | bytes. Defines a string referenced by later log records.
+ * - LOG:    severity (1 byte) | time delta in ms from previous LOG record (zigzag varint) |
+ *           thread id (varint) | caller string id (varint, 0 = unknown) | line (varint) |
+ *           message string id (varint, 0 = message text follows) | message text
+ *
+ * The time of the first LOG record after a RESET is relative to the unix epoch. String ids start
+ * at 1. Decoders must skip record types they do not know.
+ */
+namespace binarylog {
+
+const char MAGIC[] = { 'J', 'N', 'B', 'L', 'O', 'G' };
+const size_t MAGIC_SIZE = sizeof(MAGIC);
+const uint8_t VERSION = 1;
+
+enum RecordType : uint8_t {
+  RECORD_RESET = 0,
+  RECORD_STRING = 1,
+  RECORD_LOG = 2
+};
+
+inline void putVarint(std::string& out, uint64_t value) {
+  while (value >= 0x80) {
+    out += static_cast<char>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  out += static_cast<char>(value);
+}
+
+inline void putZigzag(std::string& out, int64_t value) {
+  putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+/**
+ * Read a varint at pos (advanced past it). Returns false if the data ends before the varint does.
+ */
+inline bool getVarint(const char* data, size_t size, size_t& pos, uint64_t& value) {
+  value = 0;
+  for (unsigned int shift = 0; pos < size && shift < 64; shift += 7) {
+    const uint8_t byte = static_cast<uint8_t>(data[pos++]);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline bool getZigzag(const char* data, size_t size, size_t& pos, int64_t& value) {
+  uint64_t raw;
+  if (!getVarint(data, size, pos, raw)) {
+    return false;
+  }
+  value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+  return true;
+}
+
+} // namespace binarylog
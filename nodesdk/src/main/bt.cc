@@ -1,5 +1,6 @@
 #include "bt.h"
 #include "app.h"
+#include "deviceregistry.h"
 #include <stdlib.h>
 
 // Utility that coverts a hex string to a hex array for BT.
@@ -32,7 +33,7 @@ Napi::Value napi_ConnectNewDevice(const Napi::CallbackInfo& info) {
     const bool isConnected = info[3].As<Napi::Boolean>().ToBoolean();
     const Napi::Function javascriptResultCallback = info[4].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, deviceName, deviceBTAddr, isConnected](){ 
@@ -46,7 +47,7 @@ Napi::Value napi_ConnectNewDevice(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -63,7 +64,7 @@ Napi::Value napi_ConnectPairedDevice(const Napi::CallbackInfo& info) {
     bool isConnected = info[3].As<Napi::Boolean>().ToBoolean();
     Napi::Function javascriptResultCallback = info[4].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, deviceName, deviceBTAddr, isConnected](){ 
@@ -77,7 +78,7 @@ Napi::Value napi_ConnectPairedDevice(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -105,7 +106,7 @@ Napi::Value napi_DisconnectPairedDevice(const Napi::CallbackInfo& info) {
     bool isConnected = info[3].As<Napi::Boolean>().ToBoolean();
     Napi::Function javascriptResultCallback = info[4].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, deviceName, deviceBTAddr, isConnected](){ 
@@ -119,7 +120,7 @@ Napi::Value napi_DisconnectPairedDevice(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -153,7 +154,7 @@ Napi::Value napi_IsPairingListSupported(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(functionName, info, 
     [functionName](unsigned short deviceId) {
-      bool pairingListSupported = Jabra_IsPairingListSupported(deviceId);
+      bool pairingListSupported = isCapabilitySupported(deviceId, CAPABILITY_PAIRING_LIST, &Jabra_IsPairingListSupported);
       return pairingListSupported;
     }, 
     [](const Napi::Env& env, const bool cppResult) { 
@@ -274,7 +275,7 @@ Napi::Value napi_ClearPairedDevice(const Napi::CallbackInfo& info) {
     const bool isConnected = info[3].As<Napi::Boolean>().ToBoolean();
     const Napi::Function javascriptResultCallback = info[4].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, deviceName, deviceBTAddr, isConnected](){ 
@@ -288,7 +289,7 @@ Napi::Value napi_ClearPairedDevice(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -4,7 +4,7 @@
  */
 
 import { enumNetworkInterface, enumNetworkInterfaceStatus } from '.';
-import { enumDeviceConnectionType, enumSettingCtrlType, enumSettingDataType, enumAPIReturnCode, enumBTPairedListType, enumRemoteMmiSequence, enumAutoWhiteBalance, enumPanDirection, enumTiltDirection, enumZoomDirection, enumProxyType, enumRegion } from './jabra-enums';
+import { enumDeviceConnectionType, enumDeviceFeature, enumSettingCtrlType, enumSettingDataType, enumAPIReturnCode, enumBTPairedListType, enumRemoteMmiSequence, enumLinkStatusComponent, enumAutoWhiteBalance, enumPanDirection, enumTiltDirection, enumZoomDirection, enumProxyType, enumRegion } from './jabra-enums';
 
 /**
  * The type of error returned from rejected Jabra API promises.
@@ -42,8 +42,191 @@ export declare interface NativeAddonLogConfig
     maxSeverity: AddonLogSeverity;
     maxSeverityString: AddonLogSeverity;
     configuredLogPath: string;
+    /** Format of the native log file - "binary" files can be read with the jabra-log-decode tool. */
+    logFormat: "text" | "binary";
+    /** Background log writer counters - only present if the native log is written asynchronously. */
+    asyncLogging?: AsyncLoggingStats;
+    /** Severity and sampling of each native log category. */
+    categories: { [category in NativeAddonLogCategory]: NativeAddonLogCategoryConfig };
 };
 
+/**
+ * Native log categories - each has its own max severity. Javascript log entries go to "app".
+ */
+export declare type NativeAddonLogCategory = "app" | "device" | "settings" | "fwu" | "bt" | "dect" | "callbacks";
+
+/**
+ * Configuration of a native log category.
+ */
+export declare interface NativeAddonLogCategoryConfig
+{
+    maxSeverity: AddonLogSeverity;
+    /** Only 1 of every sampleEvery high frequency messages (events, async calls) is logged. */
+    sampleEvery: number;
+};
+
+/**
+ * Counters of the background writer used for the native log file.
+ */
+export declare interface AsyncLoggingStats
+{
+    /** Number of records that can be buffered. */
+    capacity: number;
+    /** Records waiting to be written. */
+    queued: number;
+    written: number;
+    /** Records dropped because the buffer was full. */
+    dropped: number;
+    /** Number of file write calls used for the written records. */
+    batches: number;
+};
+
+/**
+ * Bit flags selecting the fields to read with `DeviceType.getSnapshotAsync`.
+ */
+export declare const enum DeviceSnapshotField {
+    firmwareVersion = 1 << 0,
+    esn = 1 << 1,
+    serialNumber = 1 << 2,
+    batteryStatus = 1 << 3,
+    supportedFeatures = 1 << 4,
+    isCertifiedForSkypeForBusiness = 1 << 5,
+    isRingerSupported = 1 << 6,
+    isOffHookSupported = 1 << 7,
+    isOnlineSupported = 1 << 8,
+    isMuteSupported = 1 << 9,
+    isHoldSupported = 1 << 10,
+    isBusyLightSupported = 1 << 11,
+    isEqualizerSupported = 1 << 12,
+    isSetDateTimeSupported = 1 << 13,
+    all = (1 << 14) - 1
+};
+
+/**
+ * Device properties read in a single native call. Only requested fields that could be
+ * read are present - failures are reported per field in `errors`.
+ */
+export declare interface DeviceSnapshot {
+    firmwareVersion?: string;
+    esn?: string;
+    serialNumber?: string;
+    batteryStatus?: { levelInPercent: number, charging: boolean, batteryLow: boolean };
+    supportedFeatures?: Array<enumDeviceFeature>;
+    isCertifiedForSkypeForBusiness?: boolean;
+    isRingerSupported?: boolean;
+    isOffHookSupported?: boolean;
+    isOnlineSupported?: boolean;
+    isMuteSupported?: boolean;
+    isHoldSupported?: boolean;
+    isBusyLightSupported?: boolean;
+    isEqualizerSupported?: boolean;
+    isSetDateTimeSupported?: boolean;
+    /** Errors for requested fields that could not be read, keyed by field name. */
+    errors: { [field: string]: { message: string, code?: number } };
+};
+
+/**
+ * Capability bits as cached natively when a device is attached. Must match DeviceCapability in deviceregistry.h.
+ */
+export declare const enum DeviceCapability {
+    isRingerSupported = 1 << 0,
+    isOffHookSupported = 1 << 1,
+    isOnlineSupported = 1 << 2,
+    isMuteSupported = 1 << 3,
+    isHoldSupported = 1 << 4,
+    isBusyLightSupported = 1 << 5,
+    isEqualizerSupported = 1 << 6,
+    isSetDateTimeSupported = 1 << 7,
+    isGnHidStdHidSupported = 1 << 8,
+    isCertifiedForSkypeForBusiness = 1 << 9,
+    isPairingListSupported = 1 << 10,
+    isUploadImageSupported = 1 << 11,
+    isUploadRingtoneSupported = 1 << 12,
+    isFactoryResetSupported = 1 << 13
+};
+
+/**
+ * All capabilities of a device read once on attach.
+ */
+export declare interface DeviceCapabilities {
+    /** Combination of `DeviceCapability` flags for the supported capabilities. */
+    mask: number;
+    isRingerSupported: boolean;
+    isOffHookSupported: boolean;
+    isOnlineSupported: boolean;
+    isMuteSupported: boolean;
+    isHoldSupported: boolean;
+    isBusyLightSupported: boolean;
+    isEqualizerSupported: boolean;
+    isSetDateTimeSupported: boolean;
+    isGnHidStdHidSupported: boolean;
+    isCertifiedForSkypeForBusiness: boolean;
+    isPairingListSupported: boolean;
+    isUploadImageSupported: boolean;
+    isUploadRingtoneSupported: boolean;
+    isFactoryResetSupported: boolean;
+};
+
+/**
+ * Statistics for the native executor running all async calls. Calls for the same
+ * device are serialized, while calls for different devices run in parallel.
+ */
+export declare interface ExecutorStats
+{
+    /** Number of threads in the executor pool. */
+    threads: number;
+    /** Number of threads currently running a call. */
+    busyThreads: number;
+    /** Number of calls waiting to run. */
+    queueDepth: number;
+    /** Highest number of calls that have been waiting at the same time. */
+    maxQueueDepth: number;
+    /** Total number of calls queued since startup. */
+    queuedTotal: number;
+    /** Total number of calls completed since startup. */
+    completedTotal: number;
+    /** Average time in microseconds a call waited before it started running. */
+    avgWaitTimeUs: number;
+    /** Longest time in microseconds a call waited before it started running. */
+    maxWaitTimeUs: number;
+    /** Number of calls waiting per device id (devices with no pending calls are omitted). */
+    deviceQueueDepths: { [deviceId: number]: number };
+};
+
+/**
+ * Latency of one phase of the calls to a native function since startup (or the last reset).
+ * Percentiles are approximate (within ~6%).
+ */
+export declare interface PerfPhaseStats
+{
+    count: number;
+    meanUs: number;
+    p50Us: number;
+    p90Us: number;
+    p99Us: number;
+    maxUs: number;
+};
+
+/**
+ * Latency per phase of the calls to a native function. Phases not seen yet are omitted:
+ * - queue: Time an async call waited in the executor before it started running.
+ * - execute: Time running the Jabra SDK call (the whole call for sync functions).
+ * - mapping: Time converting the result of an async call to javascript values.
+ * - callback: Time spent in the javascript callback of an async call.
+ */
+export declare interface FunctionPerfStats
+{
+    queue?: PerfPhaseStats;
+    execute?: PerfPhaseStats;
+    mapping?: PerfPhaseStats;
+    callback?: PerfPhaseStats;
+};
+
+/**
+ * Latency statistics per native function (by exported function name).
+ */
+export declare type PerfStats = { [functionName: string]: FunctionPerfStats };
+
 /**
  * @param blockAllNetworkAccess - if true, all network access is blocked
  * @param baseUrl_capabilities -
@@ -73,8 +256,141 @@ export interface ConfigParamsCloud {
  **/
 export interface GenericConfigParams {
     nonJabraDeviceDectection: boolean,
+    eventDelivery?: EventDeliveryParams,
+}
+
+/**
+ * Options for how device events are delivered from the native sdk threads to javascript.
+ */
+export interface EventDeliveryParams {
+    /**
+     * If true, all pending events of a type are passed from native code to javascript in a
+     * single call per event loop tick instead of one call per event. Events are still emitted
+     * individually on the device, so this is transparent to listeners.
+     */
+    batched?: boolean,
+    /**
+     * Events for which only the newest pending value per device is delivered (keep-latest).
+     * Supported events are 'onBatteryStatusUpdate', 'onxpressConnectionStatusEvent', 'onDectInfoEvent' (per kind),
+     * 'onCameraStatusEvent', 'onBluetoothLinkQualityChangeEvent', 'onNetworkStatusChangedEvent' (per interface),
+     * 'onHeadDetectionStatusEvent', 'onJackConnectorStatusEvent' and 'onLinkConnectionStatusEvent' (per component).
+     */
+    coalesce?: string[],
+    /**
+     * Maximum number of events waiting for javascript to pick them up (default 4096).
+     * Events beyond this are handled according to the overflow policy of the event.
+     */
+    maxQueueSize?: number,
+    /**
+     * Overflow policy per event name as used with on() (e.g. 'attach' or 'onBatteryStatusUpdate'):
+     * 'block' waits (bounded) on the sdk thread for room, 'dropOldest' drops the oldest pending
+     * event of the same type and 'coalesce' keeps the latest value only (coalescable events only).
+     * Frequent status and log events default to 'dropOldest', all other events to 'block'.
+     */
+    overflowPolicy?: { [eventName: string]: 'block' | 'dropOldest' | 'coalesce' },
+    /**
+     * If true, an 'eventTiming' event with an EventTiming is emitted on the JabraType after each
+     * device event has been handled. Latency statistics are kept in EventChannelStats regardless.
+     */
+    timing?: boolean,
 }
 
+/**
+ * Timing of a single device event through the native event channel. Times are in microseconds
+ * since the native sdk callback fired (monotonic clock).
+ */
+export declare interface EventTiming
+{
+    /** Native event name (see EventChannelStats.events). */
+    event: string;
+    /** Posting order of the event. */
+    seq: number;
+    /** When the event was queued for javascript. */
+    queuedUs: number;
+    /** When the event was passed to javascript. */
+    deliveredUs: number;
+};
+
+/**
+ * Latency of the events of a type through the native event channel.
+ */
+export declare interface EventLatencyStats
+{
+    /** From the native sdk callback until the event was queued. */
+    callbackToQueue: PerfPhaseStats;
+    /** From queued until the event was passed to javascript. */
+    queueToDelivery: PerfPhaseStats;
+    /** From the native sdk callback until the event was passed to javascript. */
+    callbackToDelivery: PerfPhaseStats;
+};
+
+/**
+ * Counters for a single event type in the native event channel.
+ */
+export declare interface EventChannelCounters
+{
+    /** Number of events passed to javascript. */
+    delivered: number;
+    /** Number of events dropped because the queue was full. */
+    dropped: number;
+    /** Number of events replaced by a newer value before delivery. */
+    coalesced: number;
+    /** Number of times an sdk thread had to wait for room in the queue. */
+    blocked: number;
+    /** Number of events of the type currently pending (ring and queue). */
+    depth: number;
+    /** Highest number of events of the type that have been pending at the same time. */
+    maxDepth: number;
+    /** Number of events dropped natively by the event filter (see JabraType.setEventFilter). */
+    filtered: number;
+    /** Number of state events dropped natively because a newer one arrived within the minimum interval of the filter. */
+    throttled: number;
+    /** Latency through the channel - only present once an event of the type has been delivered. */
+    latency?: EventLatencyStats;
+};
+
+/**
+ * Native filter for device events, applied before an event is copied or queued. Omitted
+ * members do not filter. Device attach/detach events are never filtered.
+ */
+export declare interface EventFilter
+{
+    /** Only pass events from these devices (an empty list blocks all device events). */
+    deviceIds?: number[];
+    /** Only pass these device events, named as in DeviceType.on (e.g. "onBatteryStatusUpdate"). */
+    eventTypes?: string[];
+    /**
+     * Pass at most one state event (battery, link quality, head detection, network status etc.)
+     * per device and event type within this many milliseconds - either for all state events or per
+     * state event name. Only the latest event arriving within the interval is kept and delivered
+     * when the interval expires - or right away when the filter is replaced. Naming any other
+     * device event throws a TypeError, as dropping e.g. button presses or firmware progress would
+     * lose information.
+     */
+    minIntervalMs?: number | { [eventName: string]: number };
+};
+
+/**
+ * Statistics for the native event channel delivering all events to javascript.
+ */
+export declare interface EventChannelStats
+{
+    /** Configured maximum number of pending events in the ring and the queue together. */
+    maxQueueSize: number;
+    /** Number of events currently pending in the queue. */
+    queueDepth: number;
+    /** Highest number of events that have been pending in the ring and the queue at the same time. */
+    maxQueueDepth: number;
+    /** Number of slots in the lock-free ring used for fixed size events. */
+    ringCapacity: number;
+    /** Number of events currently pending in the ring. */
+    ringDepth: number;
+    /** Number of fixed size events that went through the queue because the ring or its string arena was full. */
+    ringFallbacks: number;
+    /** Counters per native event name. */
+    events: { [eventName: string]: EventChannelCounters };
+};
+
 export interface DeviceCatalogueParams {
     preloadZipFile: string,
     delayInSecondsBeforeStartingRefresh: number,
@@ -153,6 +469,16 @@ export interface DeviceInfo {
     parentDeviceId?: number; // Exists only for child devices
 }
 
+/**
+ * Device info as cached natively when the device was attached.
+ */
+export interface CachedDeviceInfo extends DeviceInfo {
+    /** Firmware version read after attach (not available until read or in firmware update mode). */
+    firmwareVersion?: string;
+    /** Features supported by the device read after attach (not available until read or in firmware update mode). */
+    supportedFeatures?: Array<enumDeviceFeature>;
+}
+
 /** 
  * Device attach/detach timing information.
  **/
@@ -227,6 +553,42 @@ export interface DeviceSettings {
   settingInfo: Array<SettingType>;
 };
 
+/**
+ * The static part of the settings (all but `currValue`), shared by all devices with the same
+ * product id and firmware version. The same frozen object is returned for all such devices.
+ */
+export interface SettingsSchema {
+    /** Schema identifier (product id, firmware version and a hash of the setting guids). */
+    readonly id: string;
+    readonly settingInfo: ReadonlyArray<Readonly<Omit<SettingType, "currValue">>>;
+}
+
+/**
+ * Current setting values in schema order - `values[i]` is the `currValue` of `schema.settingInfo[i]`.
+ */
+export interface SchemaSettingValues {
+    /** Identifier of the schema the values belong to. */
+    schemaId: string;
+    values: Array<number | string | null>;
+}
+
+/**
+ * Current setting values keyed by setting GUID. Byte settings are numbers and string
+ * settings are strings (like `currValue`).
+ */
+export interface SettingValues {
+    [guid: string]: number | string;
+}
+
+/**
+ * Setting values changed since an earlier version (all values for version 0).
+ */
+export interface SettingsDelta {
+    /** Version to pass to the next delta request. */
+    version: number;
+    values: SettingValues;
+}
+
 export interface PairedListInfo  { 
     listType: enumBTPairedListType;
     pairedDevice: Array<{ deviceName: string, deviceBTAddr: string, isConnected: boolean }>;
@@ -347,6 +709,22 @@ export interface DectInfoErrorCount extends DectInfoCommon {
     handoversCount: number; /* Handover count.*/
 }
 
+/**
+ * On-head detection status of a headset (not supported by all devices).
+ */
+export interface HeadDetectionStatus {
+    leftOn: boolean;    /* True if the left earcup is on the head. */
+    rightOn: boolean;   /* True if the right earcup is on the head. */
+}
+
+/**
+ * Link connection status of a single component e.g. an earbud (not supported by all devices).
+ */
+export interface LinkConnectionStatus {
+    open: boolean;
+    component: enumLinkStatusComponent;
+}
+
 export interface Point2D {
     x: number;  /* X coordinate of the point */
     y: number;  /* y coordinate of the point */
@@ -455,3 +833,8 @@ export interface LanguagePackStats
     configuredLanguage: string;
     activeLanguage: string;
 }
+
+/**
+ * Return value for getConstantsTreeAsync() - a constant value, list or struct.
+ */
+export type DeviceConstantTree = number | string | boolean | DeviceConstantTree[] | { [field: string]: DeviceConstantTree };
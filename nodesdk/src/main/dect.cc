@@ -14,7 +14,7 @@ Napi::Value napi_GetConnectedHeadsetNames(const Napi::CallbackInfo& info) {
     readMask |= ((unsigned int)util::getObjBooleanOrDefault(whichNamesToRead, "secondary3", false)) << 3;
     const Napi::Function javascriptResultCallback = info[3].As<Napi::Function>();
 
-    (new util::JAsyncWorker<std::vector<std::string>, Napi::Object>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<std::vector<std::string>, Napi::Object>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, getAssetNames, readMask]() {
@@ -45,7 +45,7 @@ Napi::Value napi_GetConnectedHeadsetNames(const Napi::CallbackInfo& info) {
         jNames.Set("secondary3", Napi::String::New(env, headsetNames[3]));
         return jNames;
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -60,7 +60,7 @@ Napi::Value napi_TriggerDECTPairing(const Napi::CallbackInfo& info) {
     const unsigned short devicePairingType = (unsigned short)(info[1].As<Napi::Number>().Int32Value());
     const Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, devicePairingType]() {
@@ -71,7 +71,7 @@ Napi::Value napi_TriggerDECTPairing(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -85,7 +85,7 @@ Napi::Value napi_TriggerDECTSecurePairing(const Napi::CallbackInfo& info) {
     const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
     const Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId]() {
@@ -95,7 +95,7 @@ Napi::Value napi_TriggerDECTSecurePairing(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -127,7 +127,7 @@ Napi::Value napi_SetDECTPairingKey(const Napi::CallbackInfo& info) {
     const uint32_t pairingKey = info[1].As<Napi::Number>().Uint32Value();
     const Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, pairingKey]() {
@@ -137,7 +137,7 @@ Napi::Value napi_SetDECTPairingKey(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -1,9 +1,11 @@
 #include "device.h"
 #include "app.h"
 #include "napiutil.h"
+#include "deviceregistry.h"
 #include <string.h>
 #include <ctime>
 #include <cstring>
+#include <map>
 
 // ----------------------------------------- Helper functions ------------------------------------------------
 
@@ -14,6 +16,78 @@ static Napi::Object makePoint2D(const Napi::Env& env, const uint16_t x, const ui
     return point2D;
 };
 
+/**
+ * Bit values for the fieldMask argument of GetDeviceSnapshot - must match DeviceSnapshotField in core-types.ts.
+ */
+enum DeviceSnapshotField : uint32_t {
+  SNAPSHOT_FIRMWARE_VERSION      = 1 << 0,
+  SNAPSHOT_ESN                   = 1 << 1,
+  SNAPSHOT_SERIAL_NUMBER         = 1 << 2,
+  SNAPSHOT_BATTERY_STATUS        = 1 << 3,
+  SNAPSHOT_SUPPORTED_FEATURES    = 1 << 4,
+  SNAPSHOT_SKYPE_CERTIFIED       = 1 << 5,
+  SNAPSHOT_RINGER_SUPPORTED      = 1 << 6,
+  SNAPSHOT_OFFHOOK_SUPPORTED     = 1 << 7,
+  SNAPSHOT_ONLINE_SUPPORTED      = 1 << 8,
+  SNAPSHOT_MUTE_SUPPORTED        = 1 << 9,
+  SNAPSHOT_HOLD_SUPPORTED        = 1 << 10,
+  SNAPSHOT_BUSYLIGHT_SUPPORTED   = 1 << 11,
+  SNAPSHOT_EQUALIZER_SUPPORTED   = 1 << 12,
+  SNAPSHOT_SETDATETIME_SUPPORTED = 1 << 13
+};
+
+/**
+ * Memory managed result of a device snapshot. Only fields requested (and succeeding) are present,
+ * failures are recorded per field in errors instead.
+ */
+struct DeviceSnapshotDto {
+  struct FieldError {
+    std::string message;
+    Jabra_ReturnCode code;
+  };
+
+  std::map<std::string, std::string> strings;
+  std::map<std::string, bool> booleans;
+  bool hasBatteryStatus = false;
+  int batteryLevelInPercent = 0;
+  bool batteryCharging = false;
+  bool batteryLow = false;
+  bool hasSupportedFeatures = false;
+  std::vector<DeviceFeature> supportedFeatures;
+  std::map<std::string, FieldError> errors;
+};
+
+/**
+ * Run a single snapshot getter if requested by the mask, recording any failure for that field only.
+ */
+static void snapshotField(DeviceSnapshotDto& dto, const uint32_t fieldMask, const DeviceSnapshotField field, const char * const fieldName, const std::function<void()>& getter) {
+  if ((fieldMask & field) == 0) {
+    return;
+  }
+
+  try {
+    getter();
+  } catch (const util::JabraReturnCodeException& e) {
+    dto.errors[fieldName] = { e.what(), e.getJabraApiReturnCode() };
+  } catch (const std::exception& e) {
+    dto.errors[fieldName] = { e.what(), Return_Ok };
+  } catch (...) {
+    dto.errors[fieldName] = { "unknown failure", Return_Ok };
+  }
+}
+
+/**
+ * Read a string through a Jabra getter taking a buffer and a buffer size.
+ */
+static std::string snapshotString(const char * const functionName, const std::function<Jabra_ReturnCode(char * const, int)>& getter) {
+  char buf[128];
+  const Jabra_ReturnCode retv = getter(&buf[0], sizeof(buf));
+  if (retv != Return_Ok) {
+    throw util::JabraReturnCodeException(functionName, retv);
+  }
+  return std::string(buf);
+}
+
 // ----------------------------------------- Napi functions  ------------------------------------------------
 
 Napi::Value napi_GetDeviceImagePath(const Napi::CallbackInfo& info) {
@@ -49,7 +123,7 @@ Napi::Value napi_GetDeviceImageThumbnailPath(const Napi::CallbackInfo& info) {
 Napi::Value napi_IsGnHidStdHidSupported(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(functionName, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsGnHidStdHidSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_GNHID_STDHID, &Jabra_IsGnHidStdHidSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) {  return Napi::Boolean::New(env, cppResult); });
 }
@@ -77,7 +151,7 @@ Napi::Value napi_SetHidWorkingState(const Napi::CallbackInfo& info) {
     const Jabra_HidState state = (Jabra_HidState)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, state](){ 
@@ -86,7 +160,7 @@ Napi::Value napi_SetHidWorkingState(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -101,7 +175,7 @@ Napi::Value napi_SetVideoMode(const Napi::CallbackInfo& info) {
     const Jabra_VideoMode mode = (Jabra_VideoMode)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, mode](){ 
@@ -110,7 +184,7 @@ Napi::Value napi_SetVideoMode(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -227,7 +301,7 @@ Napi::Value napi_IsCertifiedForSkypeForBusiness(const Napi::CallbackInfo& info)
     return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(
         functionName, info,
         [functionName](unsigned short deviceId) {
-            bool certified = Jabra_IsCertifiedForSkypeForBusiness(deviceId);
+            bool certified = isCapabilitySupported(deviceId, CAPABILITY_SKYPE_CERTIFIED, &Jabra_IsCertifiedForSkypeForBusiness);
             return certified;
         },
         Napi::Boolean::New
@@ -243,7 +317,7 @@ Napi::Value napi_GetLock(const Napi::CallbackInfo& info) {
         const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
         Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId](){
@@ -252,7 +326,7 @@ Napi::Value napi_GetLock(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
     }
 
   return env.Undefined();
@@ -267,7 +341,7 @@ Napi::Value napi_ReleaseLock(const Napi::CallbackInfo& info) {
         const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
         Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId](){
@@ -276,7 +350,7 @@ Napi::Value napi_ReleaseLock(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
     }
 
   return env.Undefined();
@@ -291,7 +365,7 @@ Napi::Value napi_IsLocked(const Napi::CallbackInfo& info) {
         const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
         Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-        (new util::JAsyncWorker<bool, Napi::Boolean>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<bool, Napi::Boolean>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId](){
@@ -301,7 +375,7 @@ Napi::Value napi_IsLocked(const Napi::CallbackInfo& info) {
             [](const Napi::Env& env, bool isLocked){
               return Napi::Boolean::New(env, isLocked);
             }
-        ))->Queue();
+        ));
     }
 
   return env.Undefined();
@@ -310,7 +384,7 @@ Napi::Value napi_IsLocked(const Napi::CallbackInfo& info) {
 Napi::Value napi_IsRingerSupported(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(functionName, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsRingerSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_RINGER, &Jabra_IsRingerSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) {  return Napi::Boolean::New(env, cppResult); });
 }
@@ -328,7 +402,7 @@ Napi::Value napi_SetRinger(const Napi::CallbackInfo& info) {
 Napi::Value napi_IsOffHookSupported(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(functionName, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsOffHookSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_OFFHOOK, &Jabra_IsOffHookSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) {  return Napi::Boolean::New(env, cppResult); });
 }
@@ -347,7 +421,7 @@ Napi::Value napi_SetOffHook(const Napi::CallbackInfo& info) {
 Napi::Value napi_IsOnlineSupported(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(__func__, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsOnlineSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_ONLINE, &Jabra_IsOnlineSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) {  return Napi::Boolean::New(env, cppResult); });
 }
@@ -355,7 +429,7 @@ Napi::Value napi_IsOnlineSupported(const Napi::CallbackInfo& info) {
 Napi::Value napi_IsMuteSupported(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(__func__, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsMuteSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_MUTE, &Jabra_IsMuteSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) {  return Napi::Boolean::New(env, cppResult); });
 }
@@ -363,7 +437,7 @@ Napi::Value napi_IsMuteSupported(const Napi::CallbackInfo& info) {
 Napi::Value napi_IsHoldSupported(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(__func__, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsHoldSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_HOLD, &Jabra_IsHoldSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) {  return Napi::Boolean::New(env, cppResult); });
 }
@@ -371,7 +445,7 @@ Napi::Value napi_IsHoldSupported(const Napi::CallbackInfo& info) {
 Napi::Value napi_IsBusyLightSupported(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(__func__, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsBusylightSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_BUSYLIGHT, &Jabra_IsBusylightSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) {  return Napi::Boolean::New(env, cppResult); });
 }
@@ -385,7 +459,7 @@ Napi::Value napi_UploadRingtone(const Napi::CallbackInfo& info) {
     const std::string fileName = info[1].As<Napi::String>();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, fileName](){ 
@@ -394,7 +468,7 @@ Napi::Value napi_UploadRingtone(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -409,7 +483,7 @@ Napi::Value napi_UploadWavRingtone(const Napi::CallbackInfo& info) {
     const std::string fileName = info[1].As<Napi::String>();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, fileName](){ 
@@ -418,7 +492,7 @@ Napi::Value napi_UploadWavRingtone(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -433,7 +507,7 @@ Napi::Value napi_UploadImage(const Napi::CallbackInfo& info) {
     const std::string fileName = info[1].As<Napi::String>();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, fileName](){ 
@@ -442,7 +516,7 @@ Napi::Value napi_UploadImage(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -457,7 +531,7 @@ Napi::Value napi_GetNamedAsset(const Napi::CallbackInfo& info) {
     const std::string assetName = info[1].As<Napi::String>();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<CNamedAsset*, Napi::Object>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<CNamedAsset*, Napi::Object>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, assetName](){ 
@@ -505,7 +579,7 @@ Napi::Value napi_GetNamedAsset(const Napi::CallbackInfo& info) {
           Jabra_FreeAsset(asset);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -519,7 +593,7 @@ Napi::Value napi_GetSupportedButtonEvents(const Napi::CallbackInfo& info) {
     const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-    (new util::JAsyncWorker<ButtonEvent*, Napi::Object>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<ButtonEvent*, Napi::Object>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId](){ 
@@ -557,7 +631,7 @@ Napi::Value napi_GetSupportedButtonEvents(const Napi::CallbackInfo& info) {
           Jabra_FreeButtonEvents(buttonEvent);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -577,7 +651,7 @@ Napi::Value napi_SetMute(const Napi::CallbackInfo& info) {
 Napi::Value napi_IsSetDateTimeSupported(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(__func__, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsSetDateTimeSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_SETDATETIME, &Jabra_IsSetDateTimeSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) {  return Napi::Boolean::New(env, cppResult); });
 }
@@ -591,7 +665,7 @@ Napi::Value napi_IsFeatureSupported(const Napi::CallbackInfo& info) {
     const DeviceFeature feature = (DeviceFeature)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<bool, Napi::Boolean>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<bool, Napi::Boolean>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, feature](){ 
@@ -600,7 +674,7 @@ Napi::Value napi_IsFeatureSupported(const Napi::CallbackInfo& info) {
       [](const Napi::Env& env, const bool result) {
         return Napi::Boolean::New(env, result);
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -609,7 +683,7 @@ Napi::Value napi_IsFeatureSupported(const Napi::CallbackInfo& info) {
 Napi::Value napi_IsEqualizerSupported(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(__func__, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsEqualizerSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_EQUALIZER, &Jabra_IsEqualizerSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) {  return Napi::Boolean::New(env, cppResult); });
 }
@@ -648,7 +722,7 @@ Napi::Value napi_SetEqualizerParameters(const Napi::CallbackInfo& info) {
 
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, managedBands](){ 
@@ -659,7 +733,7 @@ Napi::Value napi_SetEqualizerParameters(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -674,7 +748,7 @@ Napi::Value napi_SetTimestamp(const Napi::CallbackInfo& info) {
     const uint32_t newTime = (unsigned int)(info[1].As<Napi::Number>().Int32Value());//Int64Value() should be used once Jabra sdk supports it.
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName,deviceId,newTime](){ 
@@ -683,7 +757,7 @@ Napi::Value napi_SetTimestamp(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -699,7 +773,7 @@ Napi::Value napi_PlayRingTone(const Napi::CallbackInfo& info) {
     const uint8_t type = (unsigned short)(info[2].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[3].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName,deviceId,level,type](){ 
@@ -708,7 +782,7 @@ Napi::Value napi_PlayRingTone(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -739,7 +813,7 @@ Napi::Value napi_GetTimestamp(const Napi::CallbackInfo& info) {
     const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-    (new util::JAsyncWorker<uint32_t, Napi::Number>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<uint32_t, Napi::Number>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId](){ 
@@ -753,7 +827,7 @@ Napi::Value napi_GetTimestamp(const Napi::CallbackInfo& info) {
       [](const Napi::Env& env, const uint32_t cppResult) {  
         return Napi::Number::New(env, cppResult); 
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -825,7 +899,7 @@ Napi::Value napi_SetWizardMode(const Napi::CallbackInfo& info) {
     const WizardModes modes = (WizardModes)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId,modes](){ 
@@ -834,7 +908,7 @@ Napi::Value napi_SetWizardMode(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -849,7 +923,7 @@ Napi::Value napi_SetIntelligentZoomLatency(const Napi::CallbackInfo& info) {
     const int latency = info[1].As<Napi::Number>().Int32Value();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, latency](){ 
@@ -858,7 +932,7 @@ Napi::Value napi_SetIntelligentZoomLatency(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -957,7 +1031,7 @@ Napi::Value doGetReleaseButtonFocus(const Napi::CallbackInfo& info, const char *
 
     ButtonEvent *rawButtonEvent = toButtonEventCType(btnEvents);
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName,
       javascriptResultCallback,
       [functionName, deviceId, rawButtonEvent, getOrRelease](){
@@ -978,7 +1052,7 @@ Napi::Value doGetReleaseButtonFocus(const Napi::CallbackInfo& info, const char *
           Custom_FreeButtonEvent(rawButtonEvent);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -1021,7 +1095,7 @@ Napi::Value napi_SetDatetime(const Napi::CallbackInfo& info) {
       dateTime.year==0 &&
       dateTime.wday==0;
     
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName,
       javascriptResultCallback,
       [functionName, deviceId, dateTime, setCurrentTime](){ 
@@ -1033,7 +1107,7 @@ Napi::Value napi_SetDatetime(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -1072,7 +1146,7 @@ Napi::Value napi_GetSupportedFeatures(const Napi::CallbackInfo& info) {
     const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-    (new util::JAsyncWorker<FeatureListCountPair, Napi::Array>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<FeatureListCountPair, Napi::Array>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId](){
@@ -1098,7 +1172,136 @@ Napi::Value napi_GetSupportedFeatures(const Napi::CallbackInfo& info) {
           Jabra_FreeSupportedFeatures(flcPair.featureList);
         }
       }
-    ))->Queue();
+    ));
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value napi_GetDeviceSnapshot(const Napi::CallbackInfo& info) {
+  const char * const functionName = __func__;
+  Napi::Env env = info.Env();
+
+  if (util::verifyArguments(functionName, info, {util::NUMBER, util::NUMBER, util::FUNCTION})) {
+    const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
+    const uint32_t fieldMask = info[1].As<Napi::Number>().Uint32Value();
+    Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
+
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<DeviceSnapshotDto, Napi::Object>(
+      functionName,
+      javascriptResultCallback,
+      [functionName, deviceId, fieldMask](){
+        DeviceSnapshotDto dto;
+
+        // Firmware version, features and capabilities are answered from the registry once read.
+        CachedDeviceDetails cached;
+        const bool isCached = getCachedDeviceDetails(deviceId, cached);
+
+        snapshotField(dto, fieldMask, SNAPSHOT_FIRMWARE_VERSION, "firmwareVersion", [&]() {
+          if (isCached && cached.hasFirmwareVersion) {
+            dto.strings["firmwareVersion"] = cached.firmwareVersion;
+            return;
+          }
+          dto.strings["firmwareVersion"] = snapshotString(functionName, [deviceId](char * const buf, int count) { return Jabra_GetFirmwareVersion(deviceId, buf, count); });
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_ESN, "esn", [&]() {
+          dto.strings["esn"] = snapshotString(functionName, [deviceId](char * const buf, int count) { return Jabra_GetESN(deviceId, buf, count); });
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_SERIAL_NUMBER, "serialNumber", [&]() {
+          dto.strings["serialNumber"] = snapshotString(functionName, [deviceId](char * const buf, int count) { return Jabra_GetSerialNumber(deviceId, buf, count); });
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_BATTERY_STATUS, "batteryStatus", [&]() {
+          const Jabra_ReturnCode retv = Jabra_GetBatteryStatus(deviceId, &dto.batteryLevelInPercent, &dto.batteryCharging, &dto.batteryLow);
+          if (retv != Return_Ok) {
+            throw util::JabraReturnCodeException(functionName, retv);
+          }
+          dto.hasBatteryStatus = true;
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_SUPPORTED_FEATURES, "supportedFeatures", [&]() {
+          if (isCached) {
+            dto.supportedFeatures = cached.supportedFeatures;
+            dto.hasSupportedFeatures = true;
+            return;
+          }
+          unsigned int featureCount = 0;
+          const DeviceFeature* featureList = Jabra_GetSupportedFeatures(deviceId, &featureCount);
+          if (featureList != nullptr) {
+            dto.supportedFeatures.assign(featureList, featureList + featureCount);
+            Jabra_FreeSupportedFeatures(featureList);
+          }
+          dto.hasSupportedFeatures = true;
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_SKYPE_CERTIFIED, "isCertifiedForSkypeForBusiness", [&]() {
+          dto.booleans["isCertifiedForSkypeForBusiness"] = isCached ? (cached.capabilities & CAPABILITY_SKYPE_CERTIFIED) != 0 : Jabra_IsCertifiedForSkypeForBusiness(deviceId);
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_RINGER_SUPPORTED, "isRingerSupported", [&]() {
+          dto.booleans["isRingerSupported"] = isCached ? (cached.capabilities & CAPABILITY_RINGER) != 0 : Jabra_IsRingerSupported(deviceId);
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_OFFHOOK_SUPPORTED, "isOffHookSupported", [&]() {
+          dto.booleans["isOffHookSupported"] = isCached ? (cached.capabilities & CAPABILITY_OFFHOOK) != 0 : Jabra_IsOffHookSupported(deviceId);
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_ONLINE_SUPPORTED, "isOnlineSupported", [&]() {
+          dto.booleans["isOnlineSupported"] = isCached ? (cached.capabilities & CAPABILITY_ONLINE) != 0 : Jabra_IsOnlineSupported(deviceId);
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_MUTE_SUPPORTED, "isMuteSupported", [&]() {
+          dto.booleans["isMuteSupported"] = isCached ? (cached.capabilities & CAPABILITY_MUTE) != 0 : Jabra_IsMuteSupported(deviceId);
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_HOLD_SUPPORTED, "isHoldSupported", [&]() {
+          dto.booleans["isHoldSupported"] = isCached ? (cached.capabilities & CAPABILITY_HOLD) != 0 : Jabra_IsHoldSupported(deviceId);
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_BUSYLIGHT_SUPPORTED, "isBusyLightSupported", [&]() {
+          dto.booleans["isBusyLightSupported"] = isCached ? (cached.capabilities & CAPABILITY_BUSYLIGHT) != 0 : Jabra_IsBusylightSupported(deviceId);
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_EQUALIZER_SUPPORTED, "isEqualizerSupported", [&]() {
+          dto.booleans["isEqualizerSupported"] = isCached ? (cached.capabilities & CAPABILITY_EQUALIZER) != 0 : Jabra_IsEqualizerSupported(deviceId);
+        });
+        snapshotField(dto, fieldMask, SNAPSHOT_SETDATETIME_SUPPORTED, "isSetDateTimeSupported", [&]() {
+          dto.booleans["isSetDateTimeSupported"] = isCached ? (cached.capabilities & CAPABILITY_SETDATETIME) != 0 : Jabra_IsSetDateTimeSupported(deviceId);
+        });
+
+        return dto;
+      },
+      [](const Napi::Env& env, const DeviceSnapshotDto& dto) {
+        Napi::Object result = Napi::Object::New(env);
+
+        for (const auto& entry : dto.strings) {
+          result.Set(Napi::String::New(env, entry.first), Napi::String::New(env, entry.second));
+        }
+
+        for (const auto& entry : dto.booleans) {
+          result.Set(Napi::String::New(env, entry.first), Napi::Boolean::New(env, entry.second));
+        }
+
+        if (dto.hasBatteryStatus) {
+          Napi::Object batteryStatus = Napi::Object::New(env);
+          batteryStatus.Set(Napi::String::New(env, "levelInPercent"), Napi::Number::New(env, dto.batteryLevelInPercent));
+          batteryStatus.Set(Napi::String::New(env, "charging"), Napi::Boolean::New(env, dto.batteryCharging));
+          batteryStatus.Set(Napi::String::New(env, "batteryLow"), Napi::Boolean::New(env, dto.batteryLow));
+          result.Set(Napi::String::New(env, "batteryStatus"), batteryStatus);
+        }
+
+        if (dto.hasSupportedFeatures) {
+          Napi::Array features = Napi::Array::New(env, dto.supportedFeatures.size());
+          for (size_t i = 0; i < dto.supportedFeatures.size(); ++i) {
+            features.Set(i, Napi::Number::New(env, (uint32_t)dto.supportedFeatures[i]));
+          }
+          result.Set(Napi::String::New(env, "supportedFeatures"), features);
+        }
+
+        Napi::Object errors = Napi::Object::New(env);
+        for (const auto& entry : dto.errors) {
+          Napi::Object error = Napi::Object::New(env);
+          error.Set(Napi::String::New(env, "message"), Napi::String::New(env, entry.second.message));
+          if (entry.second.code != Return_Ok) {
+            error.Set(Napi::String::New(env, "code"), Napi::Number::New(env, (int)entry.second.code));
+          }
+          errors.Set(Napi::String::New(env, entry.first), error);
+        }
+        result.Set(Napi::String::New(env, "errors"), errors);
+
+        return result;
+      }
+    ));
   }
 
   return env.Undefined();
@@ -1113,7 +1316,7 @@ Napi::Value napi_GetEqualizerParameters(const Napi::CallbackInfo& info) {
 	  const unsigned int maxNbands = (unsigned short)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<EqualizerBandsListCountPair, Napi::Array>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<EqualizerBandsListCountPair, Napi::Array>(
       functionName,
       javascriptResultCallback,
       [functionName, deviceId, maxNbands](){
@@ -1145,7 +1348,7 @@ Napi::Value napi_GetEqualizerParameters(const Napi::CallbackInfo& info) {
       }, [](const EqualizerBandsListCountPair& pair) {
         delete[] pair.bands;
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -1163,7 +1366,7 @@ Napi::Value napi_GetRemoteMmiFocus(const Napi::CallbackInfo& info) {
     const RemoteMmiPriority prio = (RemoteMmiPriority)(info[3].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[4].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, type, input, prio](){ 
@@ -1173,7 +1376,7 @@ Napi::Value napi_GetRemoteMmiFocus(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         } 
       }
-    ))->Queue();     
+    ));     
   } 
 
   return env.Undefined();
@@ -1189,7 +1392,7 @@ Napi::Value napi_ReleaseRemoteMmiFocus(const Napi::CallbackInfo& info) {
     const RemoteMmiType type = (RemoteMmiType)(info[1].As<Napi::Number>().Int32Value());  
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();  
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, type](){ 
@@ -1199,7 +1402,7 @@ Napi::Value napi_ReleaseRemoteMmiFocus(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         } 
       }
-    ))->Queue();         
+    ));         
   }
 
   return env.Undefined();
@@ -1215,7 +1418,7 @@ Napi::Value napi_IsRemoteMmiInFocus(const Napi::CallbackInfo& info) {
     const RemoteMmiType type = (RemoteMmiType)(info[1].As<Napi::Number>().Int32Value());  
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();  
 
-    (new util::JAsyncWorker<bool, Napi::Boolean>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<bool, Napi::Boolean>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, type](){ 
@@ -1231,7 +1434,7 @@ Napi::Value napi_IsRemoteMmiInFocus(const Napi::CallbackInfo& info) {
       }, [](const Napi::Env& env, bool isInFocus){
         return Napi::Boolean::New(env, isInFocus);
       }     
-    ))->Queue();         
+    ));         
   }
 
   return env.Undefined();
@@ -1254,7 +1457,7 @@ Napi::Value napi_SetRemoteMmiAction(const Napi::CallbackInfo& info) {
     actionOutput.blue = util::getObjInt32OrDefault(actionOutputArgs, "blue", 0);
     actionOutput.sequence = util::getObjEnumValueOrDefault<RemoteMmiSequence>(actionOutputArgs, "sequence", RemoteMmiSequence::MMI_LED_SEQUENCE_OFF);   
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, type, actionOutput](){         
@@ -1264,7 +1467,7 @@ Napi::Value napi_SetRemoteMmiAction(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         } 
       }     
-    ))->Queue();         
+    ));         
   }
 
   return env.Undefined();
@@ -1295,7 +1498,7 @@ Napi::Value napi_EnableRemoteManagement(const Napi::CallbackInfo& info) {
         const unsigned int timeout = info[2].As<Napi::Number>().Int32Value();
         Napi::Function javascriptResultCallback = info[3].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId, enable, timeout](){
@@ -1304,7 +1507,7 @@ Napi::Value napi_EnableRemoteManagement(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
     }
     return env.Undefined();
 }
@@ -1319,7 +1522,7 @@ Napi::Value napi_SetXpressUrl(const Napi::CallbackInfo& info) {
         const unsigned int timeout = info[2].As<Napi::Number>().Int32Value();
         Napi::Function javascriptResultCallback = info[3].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId, url, timeout](){
@@ -1328,7 +1531,7 @@ Napi::Value napi_SetXpressUrl(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
   }
 
   return env.Undefined();
@@ -1352,7 +1555,7 @@ Napi::Value napi_ConfigureXpressManagement(const Napi::CallbackInfo& info) {
         const unsigned short proxyport = (unsigned short)util::getObjInt32OrDefault(proxy, "port", 0);
         const auto proxytype = util::getObjEnumValueOrDefault<ProxySettings::_ProxyType>(proxy, "type", ProxySettings::PROXY_HTTP);
         
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId, xpressurl, timeout,
@@ -1378,7 +1581,7 @@ Napi::Value napi_ConfigureXpressManagement(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
   }
   return env.Undefined();
 }
@@ -1413,7 +1616,7 @@ Napi::Value napi_PreloadAttachedDeviceInfo(const Napi::CallbackInfo& info) {
     const std::string zipFilename = info[1].As<Napi::String>();  
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();  
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, zipFilename](){ 
@@ -1423,7 +1626,7 @@ Napi::Value napi_PreloadAttachedDeviceInfo(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         } 
       }
-    ))->Queue();
+    ));
   }
   return env.Undefined();
 }
@@ -1472,7 +1675,7 @@ Napi::Value napi_GetDiagnosticLogFile(const Napi::CallbackInfo& info) {
         const std::string filename = info[1].As<Napi::String>();
         Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId, filename](){
@@ -1481,7 +1684,7 @@ Napi::Value napi_GetDiagnosticLogFile(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
     }
 
   return env.Undefined();
@@ -1496,7 +1699,7 @@ Napi::Value napi_TriggerDiagnosticLogGeneration(const Napi::CallbackInfo& info)
         const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
         Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId](){
@@ -1505,7 +1708,7 @@ Napi::Value napi_TriggerDiagnosticLogGeneration(const Napi::CallbackInfo& info)
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
     }
 
   return env.Undefined();
@@ -1520,7 +1723,7 @@ Napi::Value napi_RestoreVideoRoomDefaults(const Napi::CallbackInfo& info) {
         const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
         Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId](){
@@ -1529,7 +1732,7 @@ Napi::Value napi_RestoreVideoRoomDefaults(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
     }
 
   return env.Undefined();
@@ -1544,7 +1747,7 @@ Napi::Value napi_ResetPanTiltZoom(const Napi::CallbackInfo& info) {
         const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
         Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId](){
@@ -1553,7 +1756,7 @@ Napi::Value napi_ResetPanTiltZoom(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
     }
 
   return env.Undefined();
@@ -1568,7 +1771,7 @@ Napi::Value napi_ResetImageQualityControls(const Napi::CallbackInfo& info) {
         const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
         Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId](){
@@ -1577,7 +1780,7 @@ Napi::Value napi_ResetImageQualityControls(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
     }
 
   return env.Undefined();
@@ -1592,7 +1795,7 @@ Napi::Value napi_SetPasswordProvisioning(const Napi::CallbackInfo& info) {
         const std::string password = info[1].As<Napi::String>();
         Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId, password](){
@@ -1601,7 +1804,7 @@ Napi::Value napi_SetPasswordProvisioning(const Napi::CallbackInfo& info) {
                   util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
   }
 
   return env.Undefined();
@@ -1644,7 +1847,7 @@ Napi::Value napi_GetWhiteboardPosition(const Napi::CallbackInfo& info) {
     const uint8_t whiteboardId = (uint8_t)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<Jabra_WhiteboardPosition, Napi::Object>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<Jabra_WhiteboardPosition, Napi::Object>(
         functionName,
         javascriptResultCallback,
         [functionName, deviceId, whiteboardId]() {
@@ -1673,7 +1876,7 @@ Napi::Value napi_GetWhiteboardPosition(const Napi::CallbackInfo& info) {
 
             return jsWhiteboard;
         }
-    ))->Queue();
+    ));
 
     return env.Undefined();
 }
@@ -1706,7 +1909,7 @@ Napi::Value napi_SetWhiteboardPosition(const Napi::CallbackInfo& info) {
     whiteboardPosition.upperLeftCornerX = (uint16_t) util::getObjInt32OrDefault(upperLeftCorner, "x", 0);
     whiteboardPosition.upperLeftCornerY = (uint16_t) util::getObjInt32OrDefault(upperLeftCorner, "y", 0);
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
         functionName,
         javascriptResultCallback,
         [functionName, deviceId, whiteboardId, whiteboardPosition]() {
@@ -1718,7 +1921,7 @@ Napi::Value napi_SetWhiteboardPosition(const Napi::CallbackInfo& info) {
                     retCode);
             }
         }
-    ))->Queue();
+    ));
 
     return env.Undefined();
 }
@@ -1756,7 +1959,7 @@ Napi::Value napi_SetZoom(const Napi::CallbackInfo& info) {
     uint16_t zoom = (uint16_t) info[1].As<Napi::Number>().Int32Value();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
         functionName,
         javascriptResultCallback,
         [functionName, deviceId, zoom]() {
@@ -1767,7 +1970,7 @@ Napi::Value napi_SetZoom(const Napi::CallbackInfo& info) {
                     retCode);
             }
         }
-    ))->Queue();
+    ));
 
     return env.Undefined();
 }
@@ -1816,7 +2019,7 @@ Napi::Value napi_SetZoomRelativeAction(const Napi::CallbackInfo& info) {
     zoom.ZoomDirection = static_cast<enumZoomDirection>(util::getObjInt32OrDefault(jsAction, "direction", 0));
     zoom.ZoomSpeed = util::getObjInt32OrDefault(jsAction, "speed", 0);
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
         functionName,
         javascriptResultCallback,
         [functionName, deviceId, zoom]() {
@@ -1826,7 +2029,7 @@ Napi::Value napi_SetZoomRelativeAction(const Napi::CallbackInfo& info) {
                     retCode);
             }
         }
-    ))->Queue();
+    ));
 
     return env.Undefined();
 }
@@ -2042,7 +2245,7 @@ Napi::Value napi_SetPanTilt(const Napi::CallbackInfo& info) {
     int32_t pan = util::getObjInt32OrDefault(jsPanTilt, "pan", 0);
     int32_t tilt = util::getObjInt32OrDefault(jsPanTilt, "tilt", 0);
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
         functionName,
         javascriptResultCallback,
         [functionName, deviceId, pan, tilt]() {
@@ -2054,7 +2257,7 @@ Napi::Value napi_SetPanTilt(const Napi::CallbackInfo& info) {
                     retCode);
             }
         }
-    ))->Queue();
+    ));
 
     return env.Undefined();
 }
@@ -2109,7 +2312,7 @@ Napi::Value napi_SetPanTiltRelativeAction(const Napi::CallbackInfo& info) {
     pantilt.TiltDirection = static_cast<enumTiltDirection>(util::getObjInt32OrDefault(jsAction, "tiltDirection", 0));
     pantilt.TiltSpeed = util::getObjInt32OrDefault(jsAction, "tiltSpeed", 0);
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
         functionName,
         javascriptResultCallback,
         [functionName, deviceId, pantilt]() {
@@ -2119,7 +2322,7 @@ Napi::Value napi_SetPanTiltRelativeAction(const Napi::CallbackInfo& info) {
                     retCode);
             }
         }
-    ))->Queue();
+    ));
 
     return env.Undefined();
 }
@@ -2191,7 +2394,7 @@ Napi::Value napi_SetContrastLevel(const Napi::CallbackInfo& info) {
         const int level = info[1].As<Napi::Number>().Int32Value();
         Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId, level](){
@@ -2200,7 +2403,7 @@ Napi::Value napi_SetContrastLevel(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
   }
   return env.Undefined();
 }
@@ -2235,7 +2438,7 @@ Napi::Value napi_SetSharpnessLevel(const Napi::CallbackInfo& info) {
         const int level = info[1].As<Napi::Number>().Int32Value();
         Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId, level](){
@@ -2244,7 +2447,7 @@ Napi::Value napi_SetSharpnessLevel(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
   }
   return env.Undefined();
 }
@@ -2279,7 +2482,7 @@ Napi::Value napi_SetBrightnessLevel(const Napi::CallbackInfo& info) {
         const int level = info[1].As<Napi::Number>().Int32Value();
         Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId, level](){
@@ -2288,7 +2491,7 @@ Napi::Value napi_SetBrightnessLevel(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
   }
   return env.Undefined();
 }
@@ -2323,7 +2526,7 @@ Napi::Value napi_SetSaturationLevel(const Napi::CallbackInfo& info) {
         const int level = info[1].As<Napi::Number>().Int32Value();
         Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId, level](){
@@ -2332,7 +2535,7 @@ Napi::Value napi_SetSaturationLevel(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
   }
   return env.Undefined();
 }
@@ -2369,7 +2572,7 @@ Napi::Value napi_SetWhiteBalance(const Napi::CallbackInfo& info) {
         const Jabra_AutoWhiteBalance autoWB = static_cast<Jabra_AutoWhiteBalance>(util::getObjInt32OrDefault(jsWhiteBalance, "autoWB", 0));
         Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId, value, autoWB](){
@@ -2378,7 +2581,7 @@ Napi::Value napi_SetWhiteBalance(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
   }
   return env.Undefined();
 }
@@ -2418,7 +2621,7 @@ Napi::Value napi_SetRoomCapacity(const Napi::CallbackInfo& info) {
         const int16_t capacity = info[1].As<Napi::Number>().Int32Value();
         Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-        (new util::JAsyncWorker<void, void>(
+        util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
             functionName,
             javascriptResultCallback,
             [functionName, deviceId, capacity](){
@@ -2427,7 +2630,7 @@ Napi::Value napi_SetRoomCapacity(const Napi::CallbackInfo& info) {
                     util::JabraReturnCodeException::LogAndThrow(functionName, retCode);
                 }
             }
-        ))->Queue();
+        ));
   }
   return env.Undefined();
 }
@@ -2496,7 +2699,7 @@ Napi::Value napi_SetNotificationStyle(const Napi::CallbackInfo& info) {
     const Jabra_NotificationStyle style = (Jabra_NotificationStyle)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
         functionName,
         javascriptResultCallback,
         [functionName, deviceId, style]() {
@@ -2507,7 +2710,7 @@ Napi::Value napi_SetNotificationStyle(const Napi::CallbackInfo& info) {
                     retCode);
             }
         }
-    ))->Queue();
+    ));
 
     return env.Undefined();
 }
@@ -2545,7 +2748,7 @@ Napi::Value napi_SetNotificationUsage(const Napi::CallbackInfo& info) {
     const Jabra_NotificationUsage enable = (Jabra_NotificationUsage)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
         functionName,
         javascriptResultCallback,
         [functionName, deviceId, enable]() {
@@ -2556,7 +2759,7 @@ Napi::Value napi_SetNotificationUsage(const Napi::CallbackInfo& info) {
                     retCode);
             }
         }
-    ))->Queue();
+    ));
 
     return env.Undefined();
 }
@@ -2591,7 +2794,7 @@ Napi::Value napi_StoreColorControlPreset(const Napi::CallbackInfo& info) {
     const Jabra_ColorControlPreset preset = (Jabra_ColorControlPreset)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, preset](){ 
@@ -2600,7 +2803,7 @@ Napi::Value napi_StoreColorControlPreset(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -2615,7 +2818,7 @@ Napi::Value napi_ApplyColorControlPreset(const Napi::CallbackInfo& info) {
     const Jabra_ColorControlPreset preset = (Jabra_ColorControlPreset)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, preset](){ 
@@ -2624,7 +2827,7 @@ Napi::Value napi_ApplyColorControlPreset(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -2639,7 +2842,7 @@ Napi::Value napi_StorePTZPreset(const Napi::CallbackInfo& info) {
     const Jabra_PTZPreset preset = (Jabra_PTZPreset)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, preset](){ 
@@ -2648,7 +2851,7 @@ Napi::Value napi_StorePTZPreset(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -2663,7 +2866,7 @@ Napi::Value napi_ApplyPTZPreset(const Napi::CallbackInfo& info) {
     const Jabra_PTZPreset preset = (Jabra_PTZPreset)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, preset](){ 
@@ -2672,7 +2875,7 @@ Napi::Value napi_ApplyPTZPreset(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -2687,7 +2890,7 @@ Napi::Value napi_SetSecondVideoStream(const Napi::CallbackInfo& info) {
     const SecondaryStreamContent content = (SecondaryStreamContent)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, content](){ 
@@ -2696,7 +2899,7 @@ Napi::Value napi_SetSecondVideoStream(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -2731,7 +2934,7 @@ Napi::Value napi_SetVideoTransitionStyle(const Napi::CallbackInfo& info) {
     const Jabra_VideoTransitionStyle style = (Jabra_VideoTransitionStyle)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, style](){ 
@@ -2740,7 +2943,7 @@ Napi::Value napi_SetVideoTransitionStyle(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -2871,7 +3074,7 @@ Napi::Value napi_GetMACAddress(const Napi::CallbackInfo& info) {
 	  const NetworkInterface selectedInterface = (NetworkInterface)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<std::vector<uint8_t>, Napi::Array>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<std::vector<uint8_t>, Napi::Uint8Array>(
       functionName, javascriptResultCallback,
       [functionName, deviceId, selectedInterface](){
 
@@ -2881,17 +3084,10 @@ Napi::Value napi_GetMACAddress(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
         return MACaddress;
-      }, [](const Napi::Env& env, std::vector<uint8_t> MAC) {
-        Napi::Array result = Napi::Array::New(env);
-        int i = 0;
-        for (auto& element : MAC)
-        {
-          Napi::Number jElement = Napi::Number::New(env, element);
-          result.Set(i++, jElement);
-        }
-        return result;
+      }, [](const Napi::Env& env, const std::vector<uint8_t>& MAC) {
+        return util::newUint8Array(env, MAC.data(), MAC.size());
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -2906,7 +3102,7 @@ Napi::Value napi_GetNetworkAuthenticationMode(const Napi::CallbackInfo& info) {
 	  const NetworkInterface selectedInterface = (NetworkInterface)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<NetworkAuthMode, Napi::Number>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<NetworkAuthMode, Napi::Number>(
       functionName, javascriptResultCallback,
       [functionName, deviceId, selectedInterface](){
 
@@ -2919,7 +3115,7 @@ Napi::Value napi_GetNetworkAuthenticationMode(const Napi::CallbackInfo& info) {
       }, [](const Napi::Env& env, NetworkAuthMode authMode) {
         return Napi::Number::New(env, authMode);
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -2935,7 +3131,7 @@ Napi::Value napi_SetNetworkAuthenticationMode(const Napi::CallbackInfo& info) {
 	  const NetworkAuthMode authMode = (NetworkAuthMode)(info[2].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[3].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, selectedInterface, authMode](){ 
@@ -2944,7 +3140,7 @@ Napi::Value napi_SetNetworkAuthenticationMode(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -2961,7 +3157,7 @@ Napi::Value napi_SetNetworkAuthenticationIdentity(const Napi::CallbackInfo& info
 	  const std::string password = (info[3].As<Napi::String>());
     Napi::Function javascriptResultCallback = info[4].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, selectedInterface, username, password](){ 
@@ -2970,7 +3166,7 @@ Napi::Value napi_SetNetworkAuthenticationIdentity(const Napi::CallbackInfo& info
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -2995,7 +3191,7 @@ Napi::Value napi_GetLanguagePackInformation(const Napi::CallbackInfo& info) {
 	  const Jabra_LanguagePackType selectedLanguagePack = (Jabra_LanguagePackType)(info[1].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<LanguagePackStats*, Napi::Object>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<LanguagePackStats*, Napi::Object>(
       functionName, javascriptResultCallback,
       [functionName, deviceId, selectedLanguagePack](){
 
@@ -3020,7 +3216,7 @@ Napi::Value napi_GetLanguagePackInformation(const Napi::CallbackInfo& info) {
         Jabra_FreeLanguagePackStats(packStats);
         return result;
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -3036,7 +3232,7 @@ Napi::Value napi_GetSubDeviceProperty(const Napi::CallbackInfo& info) {
 	  const DeviceProperty property = (DeviceProperty)(info[2].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[3].As<Napi::Function>();
 
-    (new util::JAsyncWorker<std::string, Napi::String>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<std::string, Napi::String>(
       functionName, javascriptResultCallback,
       [functionName, deviceId, subdevice, property]
       {
@@ -3052,7 +3248,7 @@ Napi::Value napi_GetSubDeviceProperty(const Napi::CallbackInfo& info) {
       {
             return Napi::String::New(env, cppResult);
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -3066,7 +3262,7 @@ Napi::Value napi_GetUserDefinedDeviceName(const Napi::CallbackInfo& info) {
     const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-    (new util::JAsyncWorker<std::string, Napi::String>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<std::string, Napi::String>(
       functionName, javascriptResultCallback,
       [functionName, deviceId]
       {
@@ -3082,8 +3278,44 @@ Napi::Value napi_GetUserDefinedDeviceName(const Napi::CallbackInfo& info) {
       {
             return Napi::String::New(env, cppResult);
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
 }
+
+Napi::Value napi_HeadDetectionStatusEventEnabled(const Napi::CallbackInfo& info) {
+  const char * const functionName = __func__;
+  return util::SimpleDeviceAsyncBoolSetter(functionName, info, [functionName](unsigned short deviceId, bool enable)
+  {
+    HeadDetectionStatusListener callback = enable ? internalCallbackManager::getHeadDetectionStatusCallback() : nullptr;
+    const Jabra_ReturnCode result = Jabra_SetHeadDetectionStatusListener(deviceId, callback);
+    if (result != Return_Ok) {
+      util::JabraReturnCodeException::LogAndThrow(functionName, result);
+    }
+  });
+}
+
+Napi::Value napi_JackConnectorStatusEventEnabled(const Napi::CallbackInfo& info) {
+  const char * const functionName = __func__;
+  return util::SimpleDeviceAsyncBoolSetter(functionName, info, [functionName](unsigned short deviceId, bool enable)
+  {
+    JackConnectorStatusListener callback = enable ? internalCallbackManager::getJackConnectorStatusCallback() : nullptr;
+    const Jabra_ReturnCode result = Jabra_SetJackConnectorStatusListener(deviceId, callback);
+    if (result != Return_Ok) {
+      util::JabraReturnCodeException::LogAndThrow(functionName, result);
+    }
+  });
+}
+
+Napi::Value napi_LinkConnectionStatusEventEnabled(const Napi::CallbackInfo& info) {
+  const char * const functionName = __func__;
+  return util::SimpleDeviceAsyncBoolSetter(functionName, info, [functionName](unsigned short deviceId, bool enable)
+  {
+    LinkConnectionStatusListener callback = enable ? internalCallbackManager::getLinkConnectionStatusCallback() : nullptr;
+    const Jabra_ReturnCode result = Jabra_SetLinkConnectionStatusListener(deviceId, callback);
+    if (result != Return_Ok) {
+      util::JabraReturnCodeException::LogAndThrow(functionName, result);
+    }
+  });
+}
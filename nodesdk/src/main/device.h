@@ -36,6 +36,7 @@ Napi::Value napi_IsSetDateTimeSupported(const Napi::CallbackInfo& info);
 
 Napi::Value napi_IsFeatureSupported(const Napi::CallbackInfo& info);
 Napi::Value napi_GetSupportedFeatures(const Napi::CallbackInfo& info);
+Napi::Value napi_GetDeviceSnapshot(const Napi::CallbackInfo& info);
 
 Napi::Value napi_GetWizardMode(const Napi::CallbackInfo& info);
 Napi::Value napi_GetSecureConnectionMode(const Napi::CallbackInfo& info);
@@ -163,3 +164,7 @@ Napi::Value napi_GetMACAddress(const Napi::CallbackInfo& info);
 Napi::Value napi_GetLanguagePackInformation(const Napi::CallbackInfo& info);
 Napi::Value napi_GetSubDeviceProperty(const Napi::CallbackInfo& info);
 Napi::Value napi_GetUserDefinedDeviceName(const Napi::CallbackInfo& info);
+
+Napi::Value napi_HeadDetectionStatusEventEnabled(const Napi::CallbackInfo& info);
+Napi::Value napi_JackConnectorStatusEventEnabled(const Napi::CallbackInfo& info);
+Napi::Value napi_LinkConnectionStatusEventEnabled(const Napi::CallbackInfo& info);
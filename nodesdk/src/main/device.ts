@@ -4,8 +4,10 @@ import { AddonLogSeverity, DeviceTiming, DevLogData, AudioFileFormatEnum,
   WhiteBalance, DateTime, VideoLimits, IPv4Status, ZoomRelative,
   PanTiltRelative, VideoDeviceStreamingStatus, ProxySettings,
   libcurlError, whichHeadsetNamesToRead, dongleConnectedHeadsetName,
-  LanguagePackStats } from "./core-types";
-import { isNodeJs } from './util';
+  LanguagePackStats, DeviceSnapshot, DeviceSnapshotField, CachedDeviceInfo, DeviceCapabilities,
+  SettingValues, SettingsDelta, SettingsSchema, SchemaSettingValues,
+  DeviceConstantTree, HeadDetectionStatus, LinkConnectionStatus, JabraError } from "./core-types";
+import { isNodeJs, toHexString } from './util';
 import { _JabraNativeAddonLog } from './logger';
 
 // Browser friendly type-only import:
@@ -62,10 +64,27 @@ export namespace DeviceTypeCallbacks {
     export type onCameraStatusEvent = (status: boolean) => void;
     export type onBluetoothLinkQualityChangeEvent = (linkQuality: enumBTLinkQuality) => void;
     export type onNetworkStatusChangedEvent = (PHY: enumNetworkInterface, status: enumNetworkInterfaceStatus) => void;
+    export type onSettingsChanged = (guids: string[]) => void;
+    export type onHeadDetectionStatusEvent = (status: HeadDetectionStatus) => void;
+    export type onJackConnectorStatusEvent = (inserted: boolean) => void;
+    export type onLinkConnectionStatusEvent = (status: LinkConnectionStatus) => void;
 }
 
-export type DeviceTypeEvents = 'btnPress' | 'busyLightChange' | 'downloadFirmwareProgress' | 'onBTParingListChange' | 'onGNPBtnEvent' | 'onDevLogEvent' | 'onDiagLogEvent' | 'onBatteryStatusUpdate' | 'onRemoteMmiEvent'| 'onxpressConnectionStatusEvent' | 'onUploadProgress' | 'onDectInfoEvent' | 'onCameraStatusEvent' | 'onBluetoothLinkQualityChangeEvent' | 'onNetworkStatusChangedEvent';
-export const DeviceEventsList : DeviceTypeEvents[] = ['btnPress', 'busyLightChange', 'downloadFirmwareProgress', 'onBTParingListChange', 'onGNPBtnEvent', 'onDevLogEvent', 'onDiagLogEvent', 'onBatteryStatusUpdate', 'onRemoteMmiEvent', 'onxpressConnectionStatusEvent', 'onUploadProgress', 'onDectInfoEvent', 'onCameraStatusEvent', 'onBluetoothLinkQualityChangeEvent', 'onNetworkStatusChangedEvent'];
+export type DeviceTypeEvents = 'btnPress' | 'busyLightChange' | 'downloadFirmwareProgress' | 'onBTParingListChange' | 'onGNPBtnEvent' | 'onDevLogEvent' | 'onDiagLogEvent' | 'onBatteryStatusUpdate' | 'onRemoteMmiEvent'| 'onxpressConnectionStatusEvent' | 'onUploadProgress' | 'onDectInfoEvent' | 'onCameraStatusEvent' | 'onBluetoothLinkQualityChangeEvent' | 'onNetworkStatusChangedEvent' | 'onSettingsChanged' | 'onHeadDetectionStatusEvent' | 'onJackConnectorStatusEvent' | 'onLinkConnectionStatusEvent';
+export const DeviceEventsList : DeviceTypeEvents[] = ['btnPress', 'busyLightChange', 'downloadFirmwareProgress', 'onBTParingListChange', 'onGNPBtnEvent', 'onDevLogEvent', 'onDiagLogEvent', 'onBatteryStatusUpdate', 'onRemoteMmiEvent', 'onxpressConnectionStatusEvent', 'onUploadProgress', 'onDectInfoEvent', 'onCameraStatusEvent', 'onBluetoothLinkQualityChangeEvent', 'onNetworkStatusChangedEvent', 'onSettingsChanged', 'onHeadDetectionStatusEvent', 'onJackConnectorStatusEvent', 'onLinkConnectionStatusEvent'];
+
+/**
+ * Device events backed by a native per device listener and the native function (un)registering it.
+ * The listener is only registered while the event has javascript listeners, so devices nobody
+ * watches cost nothing.
+ * @internal
+ */
+const nativeListenerEvents: { [event: string]: 'SettingsChangeEventEnabled' | 'HeadDetectionStatusEventEnabled' | 'JackConnectorStatusEventEnabled' | 'LinkConnectionStatusEventEnabled' } = {
+    onSettingsChanged: 'SettingsChangeEventEnabled',
+    onHeadDetectionStatusEvent: 'HeadDetectionStatusEventEnabled',
+    onJackConnectorStatusEvent: 'JackConnectorStatusEventEnabled',
+    onLinkConnectionStatusEvent: 'LinkConnectionStatusEventEnabled'
+};
 
 /** 
  * Represents a concrete Jabra device and the operations that can be done on it.   
@@ -409,8 +428,7 @@ export class DeviceType implements DeviceInfo, DeviceTiming, MetaApi {
      */
      getMACAddressAsync(selectedInterface : enumNetworkInterface): Promise<Uint8Array> {
         _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getMACAddressAsync.name, "called with", this.deviceID); 
-        return util.promisify(sdkIntegration.GetMACAddress)(this.deviceID, selectedInterface).then((result) => {
-            let MAC = new Uint8Array(result);
+        return util.promisify(sdkIntegration.GetMACAddress)(this.deviceID, selectedInterface).then((MAC) => {
             _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getMACAddressAsync.name, "returned with " + MAC[0] + MAC[1] + MAC[2] + MAC[3] + MAC[4] + MAC[5]);
             return MAC;
         });
@@ -513,6 +531,32 @@ export class DeviceType implements DeviceInfo, DeviceTiming, MetaApi {
         });
     }
 
+    /**
+     * Gets the static settings schema (all settings details except current values). Devices with the
+     * same product id and firmware version share the same frozen schema object.
+     * @returns {Promise<SettingsSchema, JabraError>} - Resolve schema if successful otherwise Reject with `error`.
+     */
+    getSettingsSchemaAsync(): Promise<SettingsSchema> {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getSettingsSchemaAsync.name, "called with", this.deviceID); 
+        return util.promisify(sdkIntegration.GetSettingsSchema)(this.deviceID).then((result) => {
+            _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getSettingsSchemaAsync.name, "returned with schema", result.id);
+            return result;
+        });
+    }
+
+    /**
+     * Gets only the current setting values as a compact array in schema order.
+     * Use `getSettingsSchemaAsync` (once per `schemaId`) to get the details of each setting.
+     * @returns {Promise<SchemaSettingValues, JabraError>} - Resolve values if successful otherwise Reject with `error`.
+     */
+    getSettingValuesAsync(): Promise<SchemaSettingValues> {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getSettingValuesAsync.name, "called with", this.deviceID); 
+        return util.promisify(sdkIntegration.GetSettingValues)(this.deviceID).then((result) => {
+            _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getSettingValuesAsync.name, "returned with", result);
+            return result;
+        });
+    }
+
     /**
      * Gets the unique setting identified by a GUID of a device.
      * @param {string} guid - the unique setting identifier.
@@ -541,6 +585,31 @@ export class DeviceType implements DeviceInfo, DeviceTiming, MetaApi {
         });
     }
 
+    /**
+     * Sets only the given setting values, without a full settings round-trip.
+     * @param {SettingValues} values - new values keyed by setting GUID (integer from 0 to 255 for byte settings, string for string settings).
+     * @returns {Promise<void, JabraError>} - Resolve `void` if successful otherwise Reject with `error`, `reboot` etc.
+     */
+    setSettingValuesAsync(values: SettingValues): Promise<void> {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.setSettingValuesAsync.name, "called with", this.deviceID, values); 
+        return util.promisify(sdkIntegration.SetSettingValues)(this.deviceID, values).then(() => {
+            _JabraNativeAddonLog(AddonLogSeverity.verbose, this.setSettingValuesAsync.name, "returned");
+        });
+    }
+
+    /**
+     * Gets the setting values that changed since an earlier call.
+     * @param {number} sinceVersion - `version` returned by the previous call, or 0 to get all values.
+     * @returns {Promise<SettingsDelta, JabraError>} - Resolve changed values and the new version if successful otherwise Reject with `error`.
+     */
+    getSettingsDeltaAsync(sinceVersion: number = 0): Promise<SettingsDelta> {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getSettingsDeltaAsync.name, "called with", this.deviceID, sinceVersion); 
+        return util.promisify(sdkIntegration.GetSettingsDelta)(this.deviceID, sinceVersion).then((result) => {
+            _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getSettingsDeltaAsync.name, "returned with", result);
+            return result;
+        });
+    }
+
     /**
      * Gets the minimum time in seconds to stay with a participant before being allowed to change zoom/direction.
      * @returns {Promise<enumIntelligentZoomLatency, JabraError>}  - Resolve setting `enumIntelligentZoomLatency`
@@ -1261,12 +1330,26 @@ export class DeviceType implements DeviceInfo, DeviceTiming, MetaApi {
      */
     getPanicsAsync(): Promise<Array<string>> {
         _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getPanicsAsync.name, "called with", this.deviceID); 
-        return util.promisify(sdkIntegration.GetPanics)(this.deviceID).then((result) => {
+        return util.promisify(sdkIntegration.GetPanics)(this.deviceID).then((panics) => {
+            const result = panics.map(toHexString);
             _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getPanicsAsync.name, "returned with", result);
             return result;
         });
     }
 
+    /**  
+     * Get the panic list without hex formatting.
+     * @returns {Promise<Array<Uint8Array>, JabraError>} - Resolve raw panic codes if successful otherwise Reject with `error`.
+     * - use `toHexString` to format a panic code if needed.
+     */
+    getPanicsRawAsync(): Promise<Array<Uint8Array>> {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getPanicsRawAsync.name, "called with", this.deviceID); 
+        return util.promisify(sdkIntegration.GetPanics)(this.deviceID).then((result) => {
+            _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getPanicsRawAsync.name, "returned with", result.length, "panics");
+            return result;
+        });
+    }
+
     /**
      * Check if a feature is supported by a device.
      * @param {number} deviceFeature the feature to check, should be `enumDeviceFeature`
@@ -1304,7 +1387,49 @@ export class DeviceType implements DeviceInfo, DeviceTiming, MetaApi {
             return result;
         });
     }
+
+    /**
+     * Read several device properties in a single native call. Fields that fail are reported
+     * in the `errors` member of the result instead of failing the whole call.
+     * @param {number} fieldMask - Combination of `DeviceSnapshotField` flags selecting the fields to read (default all).
+     * @returns {Promise<DeviceSnapshot, JabraError>} - Resolve `DeviceSnapshot` if successful otherwise Reject with `error`.
+     */
+    getSnapshotAsync(fieldMask: number = DeviceSnapshotField.all): Promise<DeviceSnapshot> {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getSnapshotAsync.name, "called with", this.deviceID, fieldMask);
+        return util.promisify(sdkIntegration.GetDeviceSnapshot)(this.deviceID, fieldMask).then((result) => {
+            _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getSnapshotAsync.name, "returned with", result);
+            return result;
+        });
+    }
      
+    /**
+     * Get device info, firmware version and supported features as cached natively when
+     * the device was attached. Answers immediately without communicating with the device.
+     * Firmware version and supported features are read in the background after the attach
+     * event and are missing until then.
+     * @returns {CachedDeviceInfo | undefined} - Cached info or undefined if the device is no longer attached.
+     */
+    getCachedInfo(): CachedDeviceInfo | undefined {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getCachedInfo.name, "called with", this.deviceID);
+        const result = sdkIntegration.GetCachedDeviceInfoSync(this.deviceID);
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getCachedInfo.name, "returned with", result);
+        return result;
+    }
+
+    /**
+     * Get all `isXxxSupported` capabilities of the device at once as cached natively when the
+     * device was attached. Answers immediately without communicating with the device once the
+     * capabilities are read in the background after the attach event - until then the device is
+     * asked directly and the answers are cached.
+     * @returns {DeviceCapabilities} - Capabilities of the device.
+     */
+    getCapabilities(): DeviceCapabilities {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getCapabilities.name, "called with", this.deviceID);
+        const result = sdkIntegration.GetCapabilitiesSync(this.deviceID);
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getCapabilities.name, "returned with", result);
+        return result;
+    }
+
     /**
      * Sets the HID working state to either standard HID (usb.org HID specification) or GN HID.
      * @param {number} hidState - state HID working state (`enumHidState`)
@@ -2531,6 +2656,22 @@ export class DeviceType implements DeviceInfo, DeviceTiming, MetaApi {
         });
     }
 
+    /**
+    * Enables or disables push notifications of changed device settings (onSettingsChanged), replacing
+    * the need to poll the settings. Only settings whose value actually changed are reported.
+    *
+    * Nb. Not needed anymore - notifications are enabled while there are onSettingsChanged listeners
+    * and disabled when the last one is removed, which also overrides what is set here.
+    * @returns {Promise<void, JabraError>} - Resolves to `void` on success,
+    *    rejects with `JabraError` on error.
+    */
+    setSettingsChangeEventsEnabledAsync(enable: boolean) : Promise<void> {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.setSettingsChangeEventsEnabledAsync.name, "called with", this.deviceID, enable);
+        return util.promisify(sdkIntegration.SettingsChangeEventEnabled)(this.deviceID, enable).then(() => {
+          _JabraNativeAddonLog(AddonLogSeverity.verbose, this.setSettingsChangeEventsEnabledAsync.name, "returned");
+        });
+    }
+
     /**
     * Get DeviceConstants object to be used for acquiring device constants.
     * @returns {Promise<DeviceConstants, Error>} - Resolve `DeviceConstants` if successful
@@ -2547,6 +2688,31 @@ export class DeviceType implements DeviceInfo, DeviceTiming, MetaApi {
                 return reject(new Error("Unable to get valid DeviceConstants object"));
         });
     }
+
+    /**
+    * Get the device constants below a root key as one (frozen) object in a single native call.
+    * The SDK can not enumerate struct fields, so struct members are only included if their
+    * names are listed in `fields`. Lists are always included.
+    *
+    * `fields` is required if the tree contains structs - the promise is rejected with a
+    * `TypeError` if a struct is reached while `fields` is empty.
+    * @param {string} rootKey - Name of the root constant.
+    * @param {number} maxDepth - Number of list/struct levels to include below the root.
+    * @param {string[]} fields - Field names to look up in structs (required for trees with structs).
+    * @returns {Promise<DeviceConstantTree, Error>} - Resolve the constants if successful
+    * otherwise Reject with `Error`.
+    */
+    getConstantsTreeAsync(rootKey: string, maxDepth: number = 8, fields: string[] = []): Promise<DeviceConstantTree> {
+        _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getConstantsTreeAsync.name, "called with", this.deviceID, rootKey, maxDepth, fields);
+        return new Promise<DeviceConstantTree>((resolve, reject) => {
+            const tree = sdkIntegration.GetConstTreeSync(this.deviceID, rootKey, maxDepth, fields);
+            _JabraNativeAddonLog(AddonLogSeverity.verbose, this.getConstantsTreeAsync.name, "returned", tree);
+            if (tree !== undefined)
+                return resolve(tree);
+            else
+                return reject(new Error("Unable to get device constants for " + rootKey));
+        });
+    }
     
    /**
    * Get meta information about methods, properties etc. that can be used 
@@ -2669,6 +2835,35 @@ export class DeviceType implements DeviceInfo, DeviceTiming, MetaApi {
    */
     on(event: 'onNetworkStatusChangedEvent', listener: DeviceTypeCallbacks.onNetworkStatusChangedEvent): this;
 
+    /**
+   * Add event handler for onSettingsChanged device events. The device only reports changed
+   * settings while there are listeners for this event.
+   *
+   * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
+   */
+    on(event: 'onSettingsChanged', listener: DeviceTypeCallbacks.onSettingsChanged): this;
+
+    /**
+   * Add event handler for onHeadDetectionStatusEvent device events (not supported by all devices).
+   *
+   * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
+   */
+    on(event: 'onHeadDetectionStatusEvent', listener: DeviceTypeCallbacks.onHeadDetectionStatusEvent): this;
+
+    /**
+   * Add event handler for onJackConnectorStatusEvent device events (not supported by all devices).
+   *
+   * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
+   */
+    on(event: 'onJackConnectorStatusEvent', listener: DeviceTypeCallbacks.onJackConnectorStatusEvent): this;
+
+    /**
+   * Add event handler for onLinkConnectionStatusEvent device events (not supported by all devices).
+   *
+   * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
+   */
+    on(event: 'onLinkConnectionStatusEvent', listener: DeviceTypeCallbacks.onLinkConnectionStatusEvent): this;
+
     /**
      * Add event handler for one of the different device events.
      * 
@@ -2678,11 +2873,18 @@ export class DeviceType implements DeviceInfo, DeviceTiming, MetaApi {
       listener: DeviceTypeCallbacks.btnPress | DeviceTypeCallbacks.busyLightChange | DeviceTypeCallbacks.downloadFirmwareProgress | DeviceTypeCallbacks.onBTParingListChange |
                 DeviceTypeCallbacks.onGNPBtnEvent | DeviceTypeCallbacks.onDevLogEvent | DeviceTypeCallbacks.onDiagLogEvent | DeviceTypeCallbacks.onBatteryStatusUpdate | DeviceTypeCallbacks.onRemoteMmiEvent |
                 DeviceTypeCallbacks.onxpressConnectionStatusEvent | DeviceTypeCallbacks.onUploadProgress | DeviceTypeCallbacks.onDectInfoEvent | DeviceTypeCallbacks.onCameraStatusEvent |
-                DeviceTypeCallbacks.onNetworkStatusChangedEvent | DeviceTypeCallbacks.onBluetoothLinkQualityChangeEvent): this {
+                DeviceTypeCallbacks.onNetworkStatusChangedEvent | DeviceTypeCallbacks.onBluetoothLinkQualityChangeEvent | DeviceTypeCallbacks.onSettingsChanged |
+                DeviceTypeCallbacks.onHeadDetectionStatusEvent | DeviceTypeCallbacks.onJackConnectorStatusEvent | DeviceTypeCallbacks.onLinkConnectionStatusEvent): this {
 
       _JabraNativeAddonLog(AddonLogSeverity.verbose, this.on.name, "called with", this.deviceID, event, "<listener>"); 
 
+      const firstListener = this._eventEmitter.listenerCount(event) === 0;
       this._eventEmitter.on(event, listener);
+      // Native code only copies and queues events of devices and event types with subscribers.
+      sdkIntegration.SubscribeEventSync(this.deviceID, event);
+      if (firstListener) {
+        this._setNativeListener(event, true);
+      }
 
       _JabraNativeAddonLog(AddonLogSeverity.verbose, this.on.name, "returned"); 
 
@@ -2785,6 +2987,34 @@ export class DeviceType implements DeviceInfo, DeviceTiming, MetaApi {
     */
     off(event: 'onNetworkStatusChangedEvent', listener: DeviceTypeCallbacks.onNetworkStatusChangedEvent): this;
 
+    /**
+    * Remove event handler for previosly setup onSettingsChanged device events.
+    *
+    * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
+    */
+    off(event: 'onSettingsChanged', listener: DeviceTypeCallbacks.onSettingsChanged): this;
+
+    /**
+    * Remove event handler for previosly setup onHeadDetectionStatusEvent device events.
+    *
+    * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
+    */
+    off(event: 'onHeadDetectionStatusEvent', listener: DeviceTypeCallbacks.onHeadDetectionStatusEvent): this;
+
+    /**
+    * Remove event handler for previosly setup onJackConnectorStatusEvent device events.
+    *
+    * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
+    */
+    off(event: 'onJackConnectorStatusEvent', listener: DeviceTypeCallbacks.onJackConnectorStatusEvent): this;
+
+    /**
+    * Remove event handler for previosly setup onLinkConnectionStatusEvent device events.
+    *
+    * *Please make sure your callback arguments matches the event type or you will get a misleading typescript error. See also {@link https://github.com/microsoft/TypeScript/issues/30843 30843}*
+    */
+    off(event: 'onLinkConnectionStatusEvent', listener: DeviceTypeCallbacks.onLinkConnectionStatusEvent): this;
+
     /**
     * Remove event handler for previosly setup onBluetoothLinkQualityChangeEvent device events.
     *
@@ -2801,14 +3031,40 @@ export class DeviceType implements DeviceInfo, DeviceTiming, MetaApi {
         listener: DeviceTypeCallbacks.btnPress | DeviceTypeCallbacks.busyLightChange | DeviceTypeCallbacks.downloadFirmwareProgress | DeviceTypeCallbacks.onBTParingListChange |
         DeviceTypeCallbacks.onGNPBtnEvent | DeviceTypeCallbacks.onDevLogEvent | DeviceTypeCallbacks.onDiagLogEvent | DeviceTypeCallbacks.onBatteryStatusUpdate | DeviceTypeCallbacks.onRemoteMmiEvent |
         DeviceTypeCallbacks.onxpressConnectionStatusEvent | DeviceTypeCallbacks.onUploadProgress | DeviceTypeCallbacks.onDectInfoEvent | DeviceTypeCallbacks.onCameraStatusEvent |
-        DeviceTypeCallbacks.onNetworkStatusChangedEvent | DeviceTypeCallbacks.onBluetoothLinkQualityChangeEvent): this {
+        DeviceTypeCallbacks.onNetworkStatusChangedEvent | DeviceTypeCallbacks.onBluetoothLinkQualityChangeEvent | DeviceTypeCallbacks.onSettingsChanged |
+                DeviceTypeCallbacks.onHeadDetectionStatusEvent | DeviceTypeCallbacks.onJackConnectorStatusEvent | DeviceTypeCallbacks.onLinkConnectionStatusEvent): this {
 
       _JabraNativeAddonLog(AddonLogSeverity.verbose, this.off.name, "called with", this.deviceID, event, "<listener>"); 
 
+      const listenerCount = this._eventEmitter.listenerCount(event);
       this._eventEmitter.off(event, listener);
+      const remainingListeners = this._eventEmitter.listenerCount(event);
+      if (remainingListeners < listenerCount) {
+        sdkIntegration.UnsubscribeEventSync(this.deviceID, event);
+        if (remainingListeners === 0) {
+          this._setNativeListener(event, false);
+        }
+      }
 
       _JabraNativeAddonLog(AddonLogSeverity.verbose, this.off.name, "returned"); 
 
       return this;
    }
+
+   /**
+    * Register or cancel the native listener behind an event (if any). Calls are queued on the
+    * device in order, so quick on/off sequences end up in the right state.
+    * @internal
+    * @hidden
+    */
+   private _setNativeListener(event: DeviceTypeEvents, enable: boolean): void {
+      const nativeFunctionName = nativeListenerEvents[event];
+      if (nativeFunctionName) {
+        sdkIntegration[nativeFunctionName](this.deviceID, enable, (error: JabraError) => {
+          if (error) {
+            _JabraNativeAddonLog(AddonLogSeverity.warning, this._setNativeListener.name, "could not " + (enable ? "register" : "cancel") + " native listener for " + event + " on device " + this.deviceID, error);
+          }
+        });
+      }
+   }
 }
@@ -1,50 +1,155 @@
 #include "deviceconstants.h"
 #include "Common.h"
-#include <map>
+#include <array>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <mutex>
+#include <string>
+#include <vector>
 
 /*
 Every deviceID is associated with exactly one Jabra_Constants* and zero to multiple Jabra_Const.
 When the device is removed, the map entry is removed, freeing the associated Jabra_Constants* and in turn, removing all Jabra_Const so they can no longer be indexed.
+
+The Jabra_Const seen for a device are kept in a dense vector (the refKey handed to javascript is the
+index into it) with an open addressing hash index from pointer to refKey, so lookups stay constant
+time no matter how many nodes have been visited. Devices are spread over a fixed number of shards
+and each device has its own lock, so lookups for different devices do not contend.
 */
 typedef std::unique_ptr<Jabra_Constants, std::function<void(Jabra_Constants*)>> ConstantsPtr;
-static std::map<int /*deviceID*/, std::pair<ConstantsPtr /*Jabra_Constants*/, std::vector<Jabra_Const>>> ConstantsMap;
-static std::mutex ConstantsMutex;
+
+namespace {
+
+const size_t INITIAL_SLOTS = 64;
+const int32_t EMPTY = -1;
+const size_t MAX_INDEX_DIGITS = 9;
+
+class DeviceConstantsEntry
+{
+    public:
+    explicit DeviceConstantsEntry(ConstantsPtr root) : root(std::move(root)), slots(INITIAL_SLOTS, EMPTY) {}
+
+    std::mutex mutex;
+    const ConstantsPtr root;
+
+    // Must be called with mutex held.
+    int32_t indexOf(const Jabra_Const val)
+    {
+        size_t slot = slotOf(val);
+        while (slots[slot] != EMPTY)
+        {
+            if (consts[slots[slot]] == val)
+                return slots[slot];
+            slot = (slot + 1) & (slots.size() - 1);
+        }
+
+        const int32_t idx = static_cast<int32_t>(consts.size());
+        consts.push_back(val);
+        slots[slot] = idx;
+
+        // Keep the load factor below 1/2 so probe sequences stay short.
+        if (consts.size() * 2 > slots.size())
+            rehash(slots.size() * 2);
+
+        return idx;
+    }
+
+    // Must be called with mutex held.
+    Jabra_Const at(const int32_t idx) const
+    {
+        if (idx < 0 || static_cast<size_t>(idx) >= consts.size())
+            return nullptr;
+        return consts[idx];
+    }
+
+    private:
+    size_t slotOf(const Jabra_Const val) const
+    {
+        // Fibonacci hashing of the pointer - the low bits are mostly alignment.
+        const uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(val)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h >> 32) & (slots.size() - 1);
+    }
+
+    void rehash(size_t newSize)
+    {
+        slots.assign(newSize, EMPTY);
+        for (size_t idx = 0; idx < consts.size(); ++idx)
+        {
+            size_t slot = slotOf(consts[idx]);
+            while (slots[slot] != EMPTY)
+                slot = (slot + 1) & (slots.size() - 1);
+            slots[slot] = static_cast<int32_t>(idx);
+        }
+    }
+
+    std::vector<Jabra_Const> consts;
+    std::vector<int32_t> slots;
+};
+
+struct ConstantsShard
+{
+    std::mutex mutex;
+    std::unordered_map<unsigned short /*deviceID*/, std::shared_ptr<DeviceConstantsEntry>> devices;
+};
+
+const size_t SHARD_COUNT = 16;
+std::array<ConstantsShard, SHARD_COUNT> ConstantsShards;
+
+ConstantsShard& shardOf(const unsigned short deviceId)
+{
+    return ConstantsShards[deviceId % SHARD_COUNT];
+}
+
+std::shared_ptr<DeviceConstantsEntry> findEntry(const unsigned short deviceId)
+{
+    ConstantsShard& shard = shardOf(deviceId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.devices.find(deviceId);
+    return it != shard.devices.end() ? it->second : nullptr;
+}
+
+// If there is no entry for this device, we create a new Jabra_Constants* and insert it
+std::shared_ptr<DeviceConstantsEntry> findOrCreateEntry(const unsigned short deviceId)
+{
+    auto existing = findEntry(deviceId);
+    if (existing) return existing;
+
+    // Fetched without holding the shard lock, so lookups for the other devices of the shard do not wait for the sdk.
+    // We create a unique_ptr with a custom deleter so it will be freed automatically when the entry is deleted
+    ConstantsPtr ptr(Jabra_GetConstants(deviceId), Jabra_ReleaseConst);
+    if (!ptr) return nullptr;
+
+    auto entry = std::make_shared<DeviceConstantsEntry>(std::move(ptr));
+
+    // Another thread may have inserted an entry meanwhile - keep that one and release ours.
+    ConstantsShard& shard = shardOf(deviceId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.devices.emplace(deviceId, entry).first->second;
+}
+
+} // namespace
 
 int32_t FindJabraConst(const unsigned short deviceId, const Jabra_Const val)
 {
     if (!val) return -1;
 
-    std::lock_guard<std::mutex> lock(ConstantsMutex);
-    if (ConstantsMap.count(deviceId) == 0)
-        return -1;
-
-    auto& ConstPtrs = ConstantsMap[deviceId].second;
+    auto entry = findEntry(deviceId);
+    if (!entry) return -1;
 
-    if (std::find(ConstPtrs.cbegin(), ConstPtrs.cend(), val) == ConstPtrs.cend())
-        ConstPtrs.push_back(val);
-     
-     // We know for sure that it is present in the vector at this point
-    const auto idx = std::find(ConstPtrs.cbegin(), ConstPtrs.cend(), val) - ConstPtrs.cbegin();
-    return static_cast<int32_t>(idx);
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    return entry->indexOf(val);
 }
 
 Jabra_Const GetCachedJabraConst(const unsigned short deviceId, const int32_t idx)
 {
     if (idx == -1) return nullptr;
 
-    std::lock_guard<std::mutex> lock(ConstantsMutex);
-    if (ConstantsMap.count(deviceId) == 0)
-        return nullptr;
-
-    auto& ConstPtrs = ConstantsMap[deviceId].second;
-
-    if (static_cast<int32_t>(ConstPtrs.size()) - 1 < idx)
-        return nullptr;
+    auto entry = findEntry(deviceId);
+    if (!entry) return nullptr;
 
-    return ConstPtrs[idx];
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    return entry->at(idx);
 }
 
 // GetConstSync(deviceId: number, key: string): number | undefined;
@@ -56,37 +161,300 @@ Napi::Value napi_GetConstSync(const Napi::CallbackInfo& info)
     const unsigned short deviceId = static_cast<unsigned short>(info[0].As<Napi::Number>().Uint32Value());
     const std::string key = info[1].As<Napi::String>();
 
-    Jabra_Const val = nullptr;
+    auto entry = findOrCreateEntry(deviceId);
+    if (!entry) return info.Env().Undefined();
+
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    // Jabra_GetConst does not store/forward/free the provided root pointer so we can safely provide a raw ptr
+    Jabra_Const val = Jabra_GetConst(entry->root.get(), key.c_str());
+    if (!val) return info.Env().Undefined();
+
+    return Napi::Number::New(info.Env(), entry->indexOf(val));
+}
+
+// GetConstPathSync(deviceId: number, path: string, refKey?: number): number | undefined;
+Napi::Value napi_GetConstPathSync(const Napi::CallbackInfo& info)
+{
+    const bool relative = info.Length() == 3;
+    if (relative ? !util::verifyArguments(__func__, info, {util::NUMBER, util::STRING, util::NUMBER})
+                 : !util::verifyArguments(__func__, info, {util::NUMBER, util::STRING}))
+        return info.Env().Undefined();
+
+    const unsigned short deviceId = static_cast<unsigned short>(info[0].As<Napi::Number>().Uint32Value());
+    const std::string path = info[1].As<Napi::String>();
+
+    auto entry = relative ? findEntry(deviceId) : findOrCreateEntry(deviceId);
+    if (!entry) return info.Env().Undefined();
+
+    std::lock_guard<std::mutex> lock(entry->mutex);
+
+    // Path syntax: "name(.name|[index])*", f.x. "a.b[3].c". Relative paths start at refKey and
+    // may start with an index.
+    Jabra_Const node = relative ? entry->at(info[2].As<Napi::Number>().Int32Value()) : nullptr;
+    if (relative && !node) return info.Env().Undefined();
+
+    size_t pos = 0;
+    bool first = true;
+    while (pos < path.length())
     {
-        std::lock_guard<std::mutex> lock(ConstantsMutex);
-        // If map does not contain an element for this device, we create a new Jabra_Constants* and insert it
-        if (ConstantsMap.count(deviceId) == 0)
+        if (path[pos] == '[')
         {
-            // We create a unique_ptr with a custom deleter so it will be freed automatically when deleted from the map
-            ConstantsPtr ptr(Jabra_GetConstants(deviceId), Jabra_ReleaseConst);
-            if (!ptr) return info.Env().Undefined();
+            const size_t end = path.find(']', pos);
+            if (end == std::string::npos || end == pos + 1 || !node) return info.Env().Undefined();
+
+            // At most 9 digits, so the index can not overflow while it is accumulated.
+            if (end - pos - 1 > MAX_INDEX_DIGITS || !Jabra_IsList(node)) return info.Env().Undefined();
 
-            ConstantsMap.emplace(deviceId, std::make_pair(std::move(ptr), std::vector<Jabra_Const>()));
+            int32_t idx = 0;
+            for (size_t i = pos + 1; i < end; ++i)
+            {
+                if (path[i] < '0' || path[i] > '9') return info.Env().Undefined();
+                idx = idx * 10 + (path[i] - '0');
+            }
+
+            // Jabra_AsInt gives the length of a list
+            if (idx >= Jabra_AsInt(node)) return info.Env().Undefined();
+
+            node = Jabra_ListElement(node, idx);
+            pos = end + 1;
+        }
+        else
+        {
+            if (path[pos] == '.')
+            {
+                if (first) return info.Env().Undefined();
+                ++pos;
+            }
+
+            const size_t end = path.find_first_of(".[", pos);
+            const std::string name = path.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+            if (name.empty()) return info.Env().Undefined();
+
+            node = node ? Jabra_GetField(node, name.c_str()) : Jabra_GetConst(entry->root.get(), name.c_str());
+            pos = end == std::string::npos ? path.length() : end;
         }
-        auto& Constants = ConstantsMap[deviceId];
-        
-        // Jabra_GetConst does not store/forward/free the provided root pointer so we can safely provide a raw ptr
-        val = Jabra_GetConst(Constants.first.get(), key.c_str());
-        if (!val) return info.Env().Undefined();
+
+        if (!node) return info.Env().Undefined();
+        first = false;
     }
-    return Napi::Number::New(info.Env(), FindJabraConst(deviceId, val));
+
+    if (!node) return info.Env().Undefined();
+
+    return Napi::Number::New(info.Env(), entry->indexOf(node));
+}
+
+namespace {
+
+/*
+Materialized constant trees are plain (frozen) javascript objects, cached per environment, device
+and (rootKey, maxDepth, fields) request. The trees of an environment are only touched on its
+javascript thread and freed by an environment cleanup hook. Detaches happen on sdk threads, so
+they only queue the device for removal - the trees are dropped by the next request in the
+environment. A cache entry also remembers the constants entry it was built from, so trees built
+before a detach are never reused once the device comes back.
+*/
+struct ConstantTrees
+{
+    std::weak_ptr<DeviceConstantsEntry> source;
+    std::unordered_map<std::string, Napi::ObjectReference> trees;
+};
+
+struct EnvConstantTrees
+{
+    // Only accessed on the javascript thread of the environment.
+    std::unordered_map<unsigned short /*deviceID*/, ConstantTrees> devices;
+
+    // Guarded by ConstantTreeCachesMutex.
+    std::vector<unsigned short> detached;
+    bool dropAll = false;
+};
+
+std::unordered_map<napi_env, std::unique_ptr<EnvConstantTrees>> ConstantTreeCaches;
+std::mutex ConstantTreeCachesMutex;
+
+void freeConstantTrees(void * arg)
+{
+    napi_env env = static_cast<napi_env>(arg);
+
+    std::unique_ptr<EnvConstantTrees> cache;
+    {
+        std::lock_guard<std::mutex> lock(ConstantTreeCachesMutex);
+        auto it = ConstantTreeCaches.find(env);
+        if (it == ConstantTreeCaches.end()) return;
+        cache = std::move(it->second);
+        ConstantTreeCaches.erase(it);
+    }
+}
+
+// Get the trees of an environment with the trees of detached devices removed.
+EnvConstantTrees& constantTreesOf(napi_env env)
+{
+    std::vector<unsigned short> detached;
+    bool dropAll;
+    EnvConstantTrees * cache;
+    {
+        std::lock_guard<std::mutex> lock(ConstantTreeCachesMutex);
+        std::unique_ptr<EnvConstantTrees>& entry = ConstantTreeCaches[env];
+        if (!entry)
+        {
+            entry.reset(new EnvConstantTrees());
+            napi_status status = napi_add_env_cleanup_hook(env, &freeConstantTrees, env);
+            if (status != napi_ok)
+                LOG_ERROR_(LOGINSTANCE) << "Constant trees could not register cleanup hook: " << status;
+        }
+        cache = entry.get();
+        detached.swap(cache->detached);
+        dropAll = cache->dropAll;
+        cache->dropAll = false;
+    }
+
+    if (dropAll)
+        cache->devices.clear();
+    for (const unsigned short deviceId : detached)
+        cache->devices.erase(deviceId);
+
+    return *cache;
+}
+
+class ConstantTreeBuilder
+{
+    public:
+    ConstantTreeBuilder(Napi::Env env, const std::vector<std::string>& fields)
+        : env(env), fields(fields), freeze(env.Global().Get("Object").As<Napi::Object>().Get("freeze").As<Napi::Function>()) {}
+
+    // Returns an empty value if the node is null or deeper than allowed.
+    Napi::Value build(const Jabra_Const node, const int32_t depthLeft)
+    {
+        if (!node) return Napi::Value();
+
+        if (Jabra_IsInt(node)) return Napi::Number::New(env, Jabra_AsInt(node));
+        if (Jabra_IsBool(node)) return Napi::Boolean::New(env, Jabra_AsBool(node));
+        if (Jabra_IsString(node)) return Napi::String::New(env, Jabra_AsString(node));
+        if (depthLeft <= 0) return Napi::Value();
+
+        if (Jabra_IsList(node))
+        {
+            // Jabra_AsInt gives the length of a list
+            const int length = Jabra_AsInt(node);
+            Napi::Array result = Napi::Array::New(env, length);
+            for (int idx = 0; idx < length; ++idx)
+            {
+                Napi::Value element = build(Jabra_ListElement(node, idx), depthLeft - 1);
+                result.Set(idx, element.IsEmpty() ? env.Undefined() : element);
+            }
+            freeze.Call({ result });
+            return result;
+        }
+
+        if (Jabra_IsStruct(node))
+        {
+            // The SDK can not enumerate struct fields, so only the requested field names are probed.
+            // Without any there is nothing to probe and the struct would come back as an empty object.
+            if (fields.empty())
+                throw Napi::TypeError::New(env, "Constant tree contains a struct - fields must list the struct field names to include");
+
+            Napi::Object result = Napi::Object::New(env);
+            for (const std::string& field : fields)
+            {
+                Napi::Value value = build(Jabra_GetField(node, field.c_str()), depthLeft - 1);
+                if (!value.IsEmpty()) result.Set(field, value);
+            }
+            freeze.Call({ result });
+            return result;
+        }
+
+        return Napi::Value();
+    }
+
+    private:
+    Napi::Env env;
+    const std::vector<std::string>& fields;
+    Napi::Function freeze;
+};
+
+} // namespace
+
+// GetConstTreeSync(deviceId: number, rootKey: string, maxDepth: number, fields?: string[]): DeviceConstantTree | undefined;
+Napi::Value napi_GetConstTreeSync(const Napi::CallbackInfo& info)
+{
+    const bool hasFields = info.Length() == 4;
+    if (hasFields ? !util::verifyArguments(__func__, info, {util::NUMBER, util::STRING, util::NUMBER, util::ARRAY})
+                  : !util::verifyArguments(__func__, info, {util::NUMBER, util::STRING, util::NUMBER}))
+        return info.Env().Undefined();
+
+    Napi::Env env = info.Env();
+    const unsigned short deviceId = static_cast<unsigned short>(info[0].As<Napi::Number>().Uint32Value());
+    const std::string rootKey = info[1].As<Napi::String>();
+    const int32_t maxDepth = info[2].As<Napi::Number>().Int32Value();
+
+    std::vector<std::string> fields;
+    std::string cacheKey = rootKey + '\n' + std::to_string(maxDepth);
+    if (hasFields)
+    {
+        Napi::Array fieldArray = info[3].As<Napi::Array>();
+        for (uint32_t i = 0; i < fieldArray.Length(); ++i)
+        {
+            Napi::Value field = fieldArray.Get(i);
+            if (!field.IsString()) continue;
+            fields.push_back(field.As<Napi::String>());
+            cacheKey += '\n' + fields.back();
+        }
+    }
+
+    auto entry = findOrCreateEntry(deviceId);
+    if (!entry) return env.Undefined();
+
+    ConstantTrees& cached = constantTreesOf(env).devices[deviceId];
+    if (cached.source.lock() != entry)
+    {
+        cached.trees.clear();
+        cached.source = entry;
+    }
+
+    auto it = cached.trees.find(cacheKey);
+    if (it != cached.trees.end()) return it->second.Value();
+
+    Napi::Value tree;
+    {
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        tree = ConstantTreeBuilder(env, fields).build(Jabra_GetConst(entry->root.get(), rootKey.c_str()), maxDepth);
+    }
+    if (tree.IsEmpty()) return env.Undefined();
+
+    // Scalars can not be referenced with N-API v3, so only objects and arrays are cached.
+    if (tree.IsObject()) cached.trees.emplace(cacheKey, Napi::Persistent(tree.As<Napi::Object>()));
+    return tree;
 }
 
 void freeConstants(unsigned short deviceId)
 {
-    std::lock_guard<std::mutex> lock(ConstantsMutex);
-    ConstantsMap.erase(deviceId);
+    {
+        ConstantsShard& shard = shardOf(deviceId);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.devices.erase(deviceId);
+    }
+
+    std::lock_guard<std::mutex> lock(ConstantTreeCachesMutex);
+    for (auto& entry : ConstantTreeCaches)
+        entry.second->detached.push_back(deviceId);
 }
 
 void freeConstants()
 {
-    std::lock_guard<std::mutex> lock(ConstantsMutex);
-    ConstantsMap.clear();
+    {
+        std::lock_guard<std::mutex> lock(ConstantTreeCachesMutex);
+        for (auto& entry : ConstantTreeCaches)
+        {
+            entry.second->detached.clear();
+            entry.second->dropAll = true;
+        }
+    }
+
+    for (ConstantsShard& shard : ConstantsShards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.devices.clear();
+    }
 }
 
 // GetConstStringSync(deviceId: number, refKey: number): string | undefined;
@@ -101,7 +469,7 @@ Napi::Value napi_GetConstStringSync(const Napi::CallbackInfo& info)
     Jabra_Const val = GetCachedJabraConst(deviceId, refKey);
     if (!val || !Jabra_IsString(val))
         return info.Env().Undefined();
-    
+
     return Napi::String::New(info.Env(), std::string(Jabra_AsString(val)));
 }
 
@@ -117,7 +485,7 @@ Napi::Value napi_GetConstIntegerSync(const Napi::CallbackInfo& info)
     Jabra_Const val = GetCachedJabraConst(deviceId, refKey);
     if (!val || !Jabra_IsInt(val))
         return info.Env().Undefined();
-    
+
     return Napi::Number::New(info.Env(), Jabra_AsInt(val));
 }
 
@@ -133,7 +501,7 @@ Napi::Value napi_GetConstBooleanSync(const Napi::CallbackInfo& info)
     Jabra_Const val = GetCachedJabraConst(deviceId, refKey);
     if (!val || !Jabra_IsBool(val))
         return info.Env().Undefined();
-    
+
     return Napi::Boolean::New(info.Env(), Jabra_AsBool(val));
 }
 
@@ -149,7 +517,7 @@ Napi::Value napi_GetConstFieldSync(const Napi::CallbackInfo& info)
 
     auto node = GetCachedJabraConst(deviceId, refKey);
     if (!node) return info.Env().Undefined();
-    
+
     auto val = Jabra_GetField(node, id.c_str());
     if (!val) return info.Env().Undefined();
 
@@ -168,7 +536,7 @@ Napi::Value napi_GetConstListSync(const Napi::CallbackInfo& info)
 
     auto node = GetCachedJabraConst(deviceId, refKey);
     if (!node) return info.Env().Undefined();
-    
+
     auto val = Jabra_ListElement(node, idx);
     if (!val) return info.Env().Undefined();
 
@@ -6,5 +6,8 @@ Napi::Value napi_GetConstIntegerSync(const Napi::CallbackInfo& info);
 Napi::Value napi_GetConstBooleanSync(const Napi::CallbackInfo& info);
 Napi::Value napi_GetConstFieldSync(const Napi::CallbackInfo& info);
 Napi::Value napi_GetConstListSync(const Napi::CallbackInfo& info);
+Napi::Value napi_GetConstPathSync(const Napi::CallbackInfo& info);
+Napi::Value napi_GetConstTreeSync(const Napi::CallbackInfo& info);
+// Also queues the materialized constant trees of the device for removal - safe to call on any thread.
 void freeConstants(unsigned short deviceId);
 void freeConstants();
@@ -19,6 +19,14 @@ if (isNodeJs()) {
 // let c = new DeviceConstant(0, "video-resolution").get("width/sensor")?.get(1)?.asNumber();
 
 const invalidRefKey : number = -1;
+
+/**
+ * Can the element names be joined into a GetConstPathSync path (they must not contain path syntax)?
+ */
+function isPathSafe(elements : string[]) : boolean {
+    return elements.every(element => element.length > 0 && !/[.\[\]]/.test(element));
+}
+
 export class DeviceConstants
 {
     private refKey : number;
@@ -42,6 +50,13 @@ export class DeviceConstants
         }
 
         let elements : string[] = key.split(delimiter);
+        if (isPathSafe(elements))
+        {
+            // Resolve the full path in a single native call
+            this.refKey = sdkIntegration.GetConstPathSync(deviceID, elements.join(".")) ?? invalidRefKey;
+            return;
+        }
+
         this.refKey = sdkIntegration.GetConstSync(deviceID, elements[0]) ?? invalidRefKey; // root node
         if (elements.length > 1)
         {
@@ -116,6 +131,10 @@ export class DeviceConstants
         {
             key = sdkIntegration.GetConstListSync(this.deviceID, this.refKey, id);
         }
+        else if (isPathSafe(id.split(delimiter)))
+        {
+            key = this.isValid() ? sdkIntegration.GetConstPathSync(this.deviceID, id.split(delimiter).join("."), this.refKey) : undefined;
+        }
         else
         {
             key = this.refKey;
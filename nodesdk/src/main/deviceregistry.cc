@@ -0,0 +1,321 @@
+#include "stdafx.h"
+#include "deviceregistry.h"
+#include "propertykeys.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct DeviceRegistryEntry {
+  ManagedDeviceInfo deviceInfo;
+  bool hasFirmwareVersion = false;
+  std::string firmwareVersion;
+  bool hasSupportedFeatures = false;
+  std::vector<DeviceFeature> supportedFeatures;
+  // Capabilities are cached one by one, so a failed or pending details read can be filled in on demand.
+  uint32_t knownCapabilities = 0;
+  uint32_t capabilities = 0;
+};
+
+struct CapabilityQuery {
+  DeviceCapability capability;
+  PropertyKey key;
+  bool (*query)(unsigned short deviceId);
+};
+
+const CapabilityQuery capabilityQueries[] = {
+  { CAPABILITY_RINGER, PropertyKey::isRingerSupported, &Jabra_IsRingerSupported },
+  { CAPABILITY_OFFHOOK, PropertyKey::isOffHookSupported, &Jabra_IsOffHookSupported },
+  { CAPABILITY_ONLINE, PropertyKey::isOnlineSupported, &Jabra_IsOnlineSupported },
+  { CAPABILITY_MUTE, PropertyKey::isMuteSupported, &Jabra_IsMuteSupported },
+  { CAPABILITY_HOLD, PropertyKey::isHoldSupported, &Jabra_IsHoldSupported },
+  { CAPABILITY_BUSYLIGHT, PropertyKey::isBusyLightSupported, &Jabra_IsBusylightSupported },
+  { CAPABILITY_EQUALIZER, PropertyKey::isEqualizerSupported, &Jabra_IsEqualizerSupported },
+  { CAPABILITY_SETDATETIME, PropertyKey::isSetDateTimeSupported, &Jabra_IsSetDateTimeSupported },
+  { CAPABILITY_GNHID_STDHID, PropertyKey::isGnHidStdHidSupported, &Jabra_IsGnHidStdHidSupported },
+  { CAPABILITY_SKYPE_CERTIFIED, PropertyKey::isCertifiedForSkypeForBusiness, &Jabra_IsCertifiedForSkypeForBusiness },
+  { CAPABILITY_PAIRING_LIST, PropertyKey::isPairingListSupported, &Jabra_IsPairingListSupported },
+  { CAPABILITY_UPLOAD_IMAGE, PropertyKey::isUploadImageSupported, &Jabra_IsUploadImageSupported },
+  { CAPABILITY_UPLOAD_RINGTONE, PropertyKey::isUploadRingtoneSupported, &Jabra_IsUploadRingtoneSupported },
+  { CAPABILITY_FACTORY_RESET, PropertyKey::isFactoryResetSupported, &Jabra_IsFactoryResetSupported }
+};
+
+const uint32_t ALL_CAPABILITIES = (CAPABILITY_FACTORY_RESET << 1) - 1;
+
+std::unordered_map<unsigned short, DeviceRegistryEntry> DeviceRegistry;
+std::mutex DeviceRegistryMutex;
+
+// Runs on the device strand, so it does not delay the sdk thread that reported the attach.
+void readDeviceDetails(unsigned short deviceId, bool readEsn) {
+  char buf[128];
+
+  bool hasFirmwareVersion = false;
+  std::string firmwareVersion;
+  if (Jabra_GetFirmwareVersion(deviceId, buf, sizeof(buf)) == Return_Ok) {
+    firmwareVersion = buf;
+    hasFirmwareVersion = true;
+  }
+
+  std::string serialNumber;
+  if (readEsn && Jabra_GetESN(deviceId, buf, sizeof(buf)) == Return_Ok) {
+    serialNumber = buf;
+  }
+
+  std::vector<DeviceFeature> supportedFeatures;
+  unsigned int featureCount = 0;
+  const DeviceFeature* featureList = Jabra_GetSupportedFeatures(deviceId, &featureCount);
+  if (featureList != nullptr) {
+    supportedFeatures.assign(featureList, featureList + featureCount);
+    Jabra_FreeSupportedFeatures(featureList);
+  }
+
+  uint32_t capabilities = 0;
+  for (const CapabilityQuery& capabilityQuery : capabilityQueries) {
+    if (capabilityQuery.query(deviceId)) {
+      capabilities |= capabilityQuery.capability;
+    }
+  }
+
+  // The device may have been detached meanwhile.
+  std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+  auto it = DeviceRegistry.find(deviceId);
+  if (it == DeviceRegistry.end()) {
+    return;
+  }
+
+  DeviceRegistryEntry& entry = it->second;
+  entry.hasFirmwareVersion = hasFirmwareVersion;
+  entry.firmwareVersion = std::move(firmwareVersion);
+  if (!serialNumber.empty()) {
+    entry.deviceInfo.serialNumber = std::move(serialNumber);
+  }
+  entry.supportedFeatures = std::move(supportedFeatures);
+  entry.hasSupportedFeatures = true;
+  entry.capabilities = capabilities;
+  entry.knownCapabilities = ALL_CAPABILITIES;
+}
+
+} // namespace
+
+void registerDevice(const ManagedDeviceInfo& deviceInfo) {
+  DeviceRegistryEntry entry;
+  entry.deviceInfo = deviceInfo;
+
+  {
+    std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+    DeviceRegistry[deviceInfo.deviceID] = std::move(entry);
+  }
+
+  // Devices in firmware update mode only support firmware updating.
+  if (deviceInfo.isInFirmwareUpdateMode) {
+    return;
+  }
+
+  const unsigned short deviceId = deviceInfo.deviceID;
+  const bool readEsn = deviceInfo.serialNumber.empty();
+  util::QueueOnDevice(deviceId, [deviceId, readEsn]() {
+    readDeviceDetails(deviceId, readEsn);
+  });
+}
+
+void unregisterDevice(unsigned short deviceId) {
+  std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+  DeviceRegistry.erase(deviceId);
+}
+
+void unregisterDevices() {
+  std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+  DeviceRegistry.clear();
+}
+
+bool getDeviceModel(unsigned short deviceId, unsigned short& productId, std::string& firmwareVersion) {
+  std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+  auto it = DeviceRegistry.find(deviceId);
+  if (it == DeviceRegistry.end() || !it->second.hasFirmwareVersion) {
+    return false;
+  }
+
+  productId = it->second.deviceInfo.productID;
+  firmwareVersion = it->second.firmwareVersion;
+  return true;
+}
+
+bool readDeviceModel(unsigned short deviceId, unsigned short& productId, std::string& firmwareVersion) {
+  {
+    std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+    auto it = DeviceRegistry.find(deviceId);
+    if (it == DeviceRegistry.end()) {
+      return false;
+    }
+
+    productId = it->second.deviceInfo.productID;
+    if (it->second.hasFirmwareVersion) {
+      firmwareVersion = it->second.firmwareVersion;
+      return true;
+    }
+  }
+
+  // The details read is pending or failed - ask the device without holding the lock.
+  char buf[128];
+  if (Jabra_GetFirmwareVersion(deviceId, buf, sizeof(buf)) != Return_Ok) {
+    return false;
+  }
+  firmwareVersion = buf;
+
+  std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+  auto it = DeviceRegistry.find(deviceId);
+  if (it != DeviceRegistry.end() && !it->second.hasFirmwareVersion) {
+    it->second.firmwareVersion = firmwareVersion;
+    it->second.hasFirmwareVersion = true;
+  }
+  return true;
+}
+
+bool isCapabilitySupported(unsigned short deviceId, DeviceCapability capability, bool (*query)(unsigned short deviceId)) {
+  {
+    std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+    auto it = DeviceRegistry.find(deviceId);
+    if (it != DeviceRegistry.end() && (it->second.knownCapabilities & capability) != 0) {
+      return (it->second.capabilities & capability) != 0;
+    }
+  }
+
+  // Not read yet or the read failed - ask the device without holding the lock.
+  const bool supported = query(deviceId);
+
+  std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+  auto it = DeviceRegistry.find(deviceId);
+  if (it != DeviceRegistry.end()) {
+    DeviceRegistryEntry& entry = it->second;
+    entry.capabilities = supported ? (entry.capabilities | capability) : (entry.capabilities & ~(uint32_t)capability);
+    entry.knownCapabilities |= capability;
+  }
+
+  return supported;
+}
+
+bool getCachedDeviceDetails(unsigned short deviceId, CachedDeviceDetails& details) {
+  std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+  auto it = DeviceRegistry.find(deviceId);
+  // All details are stored at once, so the supported features tell if they have been read.
+  if (it == DeviceRegistry.end() || !it->second.hasSupportedFeatures) {
+    return false;
+  }
+
+  const DeviceRegistryEntry& entry = it->second;
+  details.hasFirmwareVersion = entry.hasFirmwareVersion;
+  details.firmwareVersion = entry.firmwareVersion;
+  details.supportedFeatures = entry.supportedFeatures;
+  details.capabilities = entry.capabilities;
+  return true;
+}
+
+Napi::Object makeDeviceInfoObject(Napi::Env env, const util::PropertyKeys& keys, const ManagedDeviceInfo& deviceInfo) {
+  util::ObjectBuilder result(env, keys);
+  result.set(PropertyKey::deviceID, Napi::Number::New(env, deviceInfo.deviceID));
+  result.set(PropertyKey::productID, Napi::Number::New(env, deviceInfo.productID));
+  result.set(PropertyKey::vendorID, Napi::Number::New(env, deviceInfo.vendorID));
+  result.set(PropertyKey::deviceName, Napi::String::New(env, deviceInfo.deviceName));
+
+  result.set(PropertyKey::usbDevicePath, Napi::String::New(env, deviceInfo.usbDevicePath));
+  result.set(PropertyKey::parentInstanceId, Napi::String::New(env, deviceInfo.parentInstanceId));
+
+  result.set(PropertyKey::errorStatus, Napi::Number::New(env, deviceInfo.errStatus));
+  result.set(PropertyKey::isDongleDevice, Napi::Boolean::New(env, deviceInfo.isDongle));
+  result.set(PropertyKey::dongleName, Napi::String::New(env, deviceInfo.dongleName));
+  result.set(PropertyKey::variant, Napi::String::New(env, deviceInfo.variant));
+  result.set(PropertyKey::ESN, Napi::String::New(env, deviceInfo.serialNumber));
+
+  result.set(PropertyKey::isInFirmwareUpdateMode, Napi::Boolean::New(env, deviceInfo.isInFirmwareUpdateMode));
+  result.set(PropertyKey::connectionType, Napi::Number::New(env, deviceInfo.deviceconnection));
+  // connectionId not set by native lib
+  if (deviceInfo.parentDeviceId != 65535) // 65535 (-1) means there is no parent
+    result.set(PropertyKey::parentDeviceId, Napi::Number::New(env, deviceInfo.parentDeviceId));
+
+  return result.build();
+}
+
+// GetCachedDeviceInfoSync(deviceId: number): CachedDeviceInfo | undefined;
+Napi::Value napi_GetCachedDeviceInfoSync(const Napi::CallbackInfo& info) {
+  return util::JSyncWrapper<Napi::Value>(__func__, info, [](const char * const functionName, const Napi::CallbackInfo& info) -> Napi::Value {
+    Napi::Env env = info.Env();
+
+    if (!util::verifyArguments(functionName, info, {util::NUMBER})) {
+      return env.Undefined();
+    }
+
+    const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
+
+    // Copy the entry, so the sdk threads attaching and detaching devices do not wait for us.
+    DeviceRegistryEntry entry;
+    {
+      std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+      auto it = DeviceRegistry.find(deviceId);
+      if (it == DeviceRegistry.end()) {
+        return env.Undefined();
+      }
+      entry = it->second;
+    }
+
+    const util::PropertyKeys keys(env);
+    Napi::Object result = makeDeviceInfoObject(env, keys, entry.deviceInfo);
+
+    if (entry.hasFirmwareVersion) {
+      result.Set(keys[PropertyKey::firmwareVersion], Napi::String::New(env, entry.firmwareVersion));
+    }
+
+    if (entry.hasSupportedFeatures) {
+      Napi::Array supportedFeatures = Napi::Array::New(env, entry.supportedFeatures.size());
+      for (size_t i = 0; i < entry.supportedFeatures.size(); ++i) {
+        supportedFeatures.Set(i, Napi::Number::New(env, (uint32_t)entry.supportedFeatures[i]));
+      }
+      result.Set(keys[PropertyKey::supportedFeatures], supportedFeatures);
+    }
+
+    return result;
+  });
+}
+
+// GetCapabilitiesSync(deviceId: number): DeviceCapabilities;
+Napi::Value napi_GetCapabilitiesSync(const Napi::CallbackInfo& info) {
+  return util::JSyncWrapper<Napi::Value>(__func__, info, [](const char * const functionName, const Napi::CallbackInfo& info) -> Napi::Value {
+    Napi::Env env = info.Env();
+
+    if (!util::verifyArguments(functionName, info, {util::NUMBER})) {
+      return env.Undefined();
+    }
+
+    const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
+
+    uint32_t knownCapabilities = 0;
+    uint32_t capabilities = 0;
+    {
+      std::lock_guard<std::mutex> lock(DeviceRegistryMutex);
+      auto it = DeviceRegistry.find(deviceId);
+      if (it != DeviceRegistry.end()) {
+        knownCapabilities = it->second.knownCapabilities;
+        capabilities = it->second.capabilities & knownCapabilities;
+      }
+    }
+
+    // Fill in what the details read has not (yet) cached by asking the device.
+    if (knownCapabilities != ALL_CAPABILITIES) {
+      for (const CapabilityQuery& capabilityQuery : capabilityQueries) {
+        if ((knownCapabilities & capabilityQuery.capability) == 0 && isCapabilitySupported(deviceId, capabilityQuery.capability, capabilityQuery.query)) {
+          capabilities |= capabilityQuery.capability;
+        }
+      }
+    }
+
+    const util::PropertyKeys keys(env);
+    util::ObjectBuilder result(env, keys);
+    result.set(PropertyKey::mask, Napi::Number::New(env, capabilities));
+    for (const CapabilityQuery& capabilityQuery : capabilityQueries) {
+      result.set(capabilityQuery.key, Napi::Boolean::New(env, (capabilities & capabilityQuery.capability) != 0));
+    }
+
+    return result.build();
+  });
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "stdafx.h"
+#include "propertykeys.h"
+
+#include <vector>
+
+/**
+ * Native registry of attached devices. Device info, supported features, capabilities, firmware
+ * version and ESN are read once when a device is attached and dropped again when it is detached,
+ * so they can be answered synchronously without queueing a worker.
+ *
+ * Only the device info is known when the attach event is posted. Everything read from the
+ * device is filled in on the device strand afterwards - whether or not the attach event is
+ * delivered to javascript - and reported as not (yet) cached until then.
+ */
+
+/**
+ * Capability bits - answers to the Jabra_IsXxxSupported functions that never change while the
+ * device stays attached. Must match DeviceCapability in core-types.ts.
+ */
+enum DeviceCapability : uint32_t {
+  CAPABILITY_RINGER = 1u << 0,
+  CAPABILITY_OFFHOOK = 1u << 1,
+  CAPABILITY_ONLINE = 1u << 2,
+  CAPABILITY_MUTE = 1u << 3,
+  CAPABILITY_HOLD = 1u << 4,
+  CAPABILITY_BUSYLIGHT = 1u << 5,
+  CAPABILITY_EQUALIZER = 1u << 6,
+  CAPABILITY_SETDATETIME = 1u << 7,
+  CAPABILITY_GNHID_STDHID = 1u << 8,
+  CAPABILITY_SKYPE_CERTIFIED = 1u << 9,
+  CAPABILITY_PAIRING_LIST = 1u << 10,
+  CAPABILITY_UPLOAD_IMAGE = 1u << 11,
+  CAPABILITY_UPLOAD_RINGTONE = 1u << 12,
+  CAPABILITY_FACTORY_RESET = 1u << 13
+};
+
+/**
+ * Cache the device info of a newly attached device and queue reading firmware version, ESN,
+ * supported features and capabilities on its device strand. Does not communicate with the device
+ * itself, so it is safe to call on the sdk thread that reported the attach.
+ */
+void registerDevice(const ManagedDeviceInfo& deviceInfo);
+
+/**
+ * Forget a detached device.
+ */
+void unregisterDevice(unsigned short deviceId);
+
+/**
+ * Forget all devices.
+ */
+void unregisterDevices();
+
+/**
+ * Get product id and firmware version of a registered device. Returns false if the device is
+ * unknown or its firmware version is not (yet) read.
+ */
+bool getDeviceModel(unsigned short deviceId, unsigned short& productId, std::string& firmwareVersion);
+
+/**
+ * Like getDeviceModel, but asks the device for its firmware version (and caches it) if it is not
+ * read yet. Communicates with the device, so it must be called on the device strand. Returns false
+ * if the device is unknown or the firmware version could not be read.
+ */
+bool readDeviceModel(unsigned short deviceId, unsigned short& productId, std::string& firmwareVersion);
+
+/**
+ * Answer a Jabra_IsXxxSupported query from the registry if the capability of the device is
+ * cached, otherwise ask the device with query and cache the answer while the device stays
+ * registered.
+ */
+bool isCapabilitySupported(unsigned short deviceId, DeviceCapability capability, bool (*query)(unsigned short deviceId));
+
+/**
+ * What is read from a device after it is attached.
+ */
+struct CachedDeviceDetails {
+  bool hasFirmwareVersion;
+  std::string firmwareVersion;
+  std::vector<DeviceFeature> supportedFeatures;
+  uint32_t capabilities;
+};
+
+/**
+ * Get the details read from a registered device. Returns false if the device is unknown or its
+ * details are not (yet) read.
+ */
+bool getCachedDeviceDetails(unsigned short deviceId, CachedDeviceDetails& details);
+
+/**
+ * Convert device info to the javascript object used for both attach events and the registry.
+ */
+Napi::Object makeDeviceInfoObject(Napi::Env env, const util::PropertyKeys& keys, const ManagedDeviceInfo& deviceInfo);
+
+Napi::Value napi_GetCachedDeviceInfoSync(const Napi::CallbackInfo& info);
+Napi::Value napi_GetCapabilitiesSync(const Napi::CallbackInfo& info);
@@ -0,0 +1,663 @@
+#include "stdafx.h"
+#include "eventchannel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <unordered_set>
+
+namespace {
+
+// Upper bound for how long a Block policy post may stall an SDK thread. Bounded so that a
+// javascript main thread waiting on the SDK (e.g. in UnInitialize) can not deadlock with it.
+const std::chrono::milliseconds MAX_BLOCK_TIME(1000);
+
+// Size of each of the two string arenas used by event records.
+const size_t ARENA_SIZE = 256 * 1024;
+
+const size_t MIN_RING_CAPACITY = 64;
+
+const uint64_t OUTSTANDING_MASK = 0xffffffffULL;
+
+const char * const eventTypeNames[] = {
+  "initialized",
+  "firstScanDone",
+  "attached",
+  "deAttached",
+  "buttonInDataTranslated",
+  "devLog",
+  "diagnosticLog",
+  "batteryStatus",
+  "remoteMmi",
+  "xpressConnectionStatus",
+  "downloadFirmwareProgress",
+  "uploadProgress",
+  "pairingList",
+  "gnpButton",
+  "dectInfo",
+  "cameraStatus",
+  "bluetoothLinkQuality",
+  "networkStatusChange",
+  "settingsChanged",
+  "headDetectionStatus",
+  "jackConnectorStatus",
+  "linkConnectionStatus"
+};
+
+static_assert(sizeof(eventTypeNames) / sizeof(eventTypeNames[0]) == (size_t)EventType::COUNT, "Missing event type name");
+
+// Names of the events as emitted to javascript listeners on JabraType and DeviceType (the
+// initialized event is internal).
+const char * const publicEventNames[] = {
+  "",
+  "firstScanDone",
+  "attach",
+  "detach",
+  "btnPress",
+  "onDevLogEvent",
+  "onDiagLogEvent",
+  "onBatteryStatusUpdate",
+  "onRemoteMmiEvent",
+  "onxpressConnectionStatusEvent",
+  "downloadFirmwareProgress",
+  "onUploadProgress",
+  "onBTParingListChange",
+  "onGNPBtnEvent",
+  "onDectInfoEvent",
+  "onCameraStatusEvent",
+  "onBluetoothLinkQualityChangeEvent",
+  "onNetworkStatusChangedEvent",
+  "onSettingsChanged",
+  "onHeadDetectionStatusEvent",
+  "onJackConnectorStatusEvent",
+  "onLinkConnectionStatusEvent"
+};
+
+static_assert(sizeof(publicEventNames) / sizeof(publicEventNames[0]) == (size_t)EventType::COUNT, "Missing public event name");
+
+size_t roundUpToPowerOfTwo(size_t value) {
+  size_t result = MIN_RING_CAPACITY;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+} // namespace
+
+std::shared_ptr<EventChannel> EventChannel::New(Napi::Env env, const std::vector<Napi::Function>& callbacks, size_t maxQueueSize) {
+  return std::shared_ptr<EventChannel>(new EventChannel(env, callbacks, maxQueueSize));
+}
+
+EventChannel::EventChannel(Napi::Env env, const std::vector<Napi::Function>& jsCallbacks, size_t maxQueueSize)
+  : maxQueueSize(std::max<size_t>(maxQueueSize, 1)), nextSeq(0), signalled(false), closed(false), activePosters(0), ringFallbacks(0),
+    ringCapacity(roundUpToPowerOfTwo(maxQueueSize)), ring(new RingSlot[ringCapacity]), enqueuePos(0), dequeuePos(0),
+    activeArena(0), pendingEvents(0), maxQueueDepth(0) {
+  if (jsCallbacks.size() != (size_t)EventType::COUNT) {
+    util::JabraException::LogAndThrow(__func__, "Wrong number of event callbacks");
+  }
+
+  for (const Napi::Function& callback : jsCallbacks) {
+    callbacks.push_back(Napi::Persistent(callback));
+  }
+
+  for (size_t i = 0; i < ringCapacity; ++i) {
+    ring[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  for (Arena& arena : arenas) {
+    arena.data.reset(new char[ARENA_SIZE]);
+  }
+
+  drained.reserve(ringCapacity);
+
+  // The thread safe function is only used to wake up the main thread - the events themselves are
+  // kept in our own bounded ring/queue. Unref'ed so pending events never keep the process alive.
+  wakeUp = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "JabraEventChannel", 0, 1);
+  wakeUp.Unref(env);
+}
+
+EventChannel::~EventChannel() {
+}
+
+const char * EventChannel::name(EventType type) {
+  return type < EventType::COUNT ? eventTypeNames[(size_t)type] : "unknown";
+}
+
+bool EventChannel::typeFromPublicName(const std::string& name, EventType& type) {
+  for (size_t i = 0; i < (size_t)EventType::COUNT; ++i) {
+    if (!name.empty() && name == publicEventNames[i]) {
+      type = (EventType)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool EventChannel::isStateEvent(EventType type) {
+  switch (type) {
+    case EventType::BatteryStatus:
+    case EventType::XpressConnectionStatus:
+    case EventType::DectInfo:
+    case EventType::CameraStatus:
+    case EventType::BluetoothLinkQuality:
+    case EventType::NetworkStatusChange:
+    case EventType::HeadDetectionStatus:
+    case EventType::JackConnectorStatus:
+    case EventType::LinkConnectionStatus:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void EventChannel::setBatched(EventType type, bool batched) {
+  types[(size_t)type].batched = batched;
+}
+
+void EventChannel::setPolicy(EventType type, OverflowPolicy policy) {
+  types[(size_t)type].policy = policy;
+}
+
+void EventChannel::setTiming(EventType type, bool timing) {
+  types[(size_t)type].timing = timing;
+}
+
+void EventChannel::post(EventType type, uint32_t key, const ArgFunc& argFunc) {
+  ++activePosters;
+  if (!closed) {
+    Event event = { 0, type, key, argFunc, false, EventRecord(), std::string() };
+    event.record.firedNs = eventClockNs();
+    postQueued(std::move(event));
+  }
+  --activePosters;
+}
+
+void EventChannel::post(EventType type, uint32_t key, const EventRecord& source, const char * text, size_t textLength) {
+  ++activePosters;
+  if (!closed) {
+    EventRecord record = source;
+    record.type = type;
+    record.key = key;
+    record.text = nullptr;
+    record.textLength = 0;
+    record.textArena = -1;
+    if (record.firedNs == 0) {
+      record.firedNs = eventClockNs();
+    }
+
+    // Blocking needs the lock anyway, so only non-blocking events take the lock-free path.
+    // A full channel is left to the overflow policy of the queue.
+    TypeState& typeState = types[(size_t)type];
+    bool posted = false;
+    if (typeState.policy != OverflowPolicy::Block && reservePending()) {
+      if (text == nullptr || allocateText(text, textLength, record)) {
+        // Counted before it is published, so the main thread never sees it drained first.
+        addDepth(typeState);
+        record.queuedNs = eventClockNs();
+        posted = tryPushRecord(record);
+        if (!posted) {
+          --typeState.depth;
+          releaseText(record);
+        }
+      }
+      if (!posted) {
+        --pendingEvents;
+        ++ringFallbacks;
+      }
+    }
+
+    if (posted) {
+      signal();
+    } else {
+      record.text = nullptr;
+      record.textArena = -1;
+      postQueued({ 0, type, key, ArgFunc(), true, record, text ? std::string(text, textLength) : std::string() });
+    }
+  }
+  --activePosters;
+}
+
+void EventChannel::postQueued(Event&& event) {
+  std::unique_lock<std::mutex> lock(mutex);
+  if (closed) {
+    return;
+  }
+
+  TypeState& typeState = types[(size_t)event.type];
+
+  if (typeState.policy == OverflowPolicy::Coalesce) {
+    auto pending = std::find_if(queue.begin(), queue.end(), [&event](const Event& queued) {
+      return queued.type == event.type && queued.key == event.key;
+    });
+    if (pending != queue.end()) {
+      // Keep-latest: Replace the payload in place so the event keeps its position in the queue.
+      pending->argFunc = std::move(event.argFunc);
+      pending->hasRecord = event.hasRecord;
+      pending->record = event.record;
+      pending->record.queuedNs = eventClockNs();
+      pending->text = std::move(event.text);
+      ++typeState.coalesced;
+      return;
+    }
+  }
+
+  if (pendingEvents >= maxQueueSize && !makeRoom(lock, event.type, typeState)) {
+    ++typeState.dropped;
+    return;
+  }
+
+  // Numbered when published, see tryPushRecord.
+  event.seq = nextSeq++;
+  event.record.seq = event.seq;
+  event.record.queuedNs = eventClockNs();
+  addDepth(typeState);
+  queue.push_back(std::move(event));
+  notePending(++pendingEvents);
+  signal();
+}
+
+// Ring records count against the same bound as the queue. Returns false if the channel is full.
+bool EventChannel::reservePending() {
+  size_t pending = pendingEvents.load();
+  do {
+    if (pending >= maxQueueSize) {
+      return false;
+    }
+  } while (!pendingEvents.compare_exchange_weak(pending, pending + 1));
+  notePending(pending + 1);
+  return true;
+}
+
+void EventChannel::notePending(size_t pending) {
+  size_t maxPending = maxQueueDepth.load();
+  while (pending > maxPending && !maxQueueDepth.compare_exchange_weak(maxPending, pending)) {
+  }
+}
+
+void EventChannel::addDepth(TypeState& typeState) {
+  const uint32_t depth = ++typeState.depth;
+  uint32_t maxDepth = typeState.maxDepth.load();
+  while (depth > maxDepth && !typeState.maxDepth.compare_exchange_weak(maxDepth, depth)) {
+  }
+}
+
+// Called with the lock held on a full queue. Returns false if the new event must be dropped.
+bool EventChannel::makeRoom(std::unique_lock<std::mutex>& lock, EventType type, TypeState& typeState) {
+  if (typeState.policy == OverflowPolicy::Block) {
+    ++typeState.blocked;
+    // Make sure the main thread is awake to drain the queue before we start waiting.
+    signal();
+    if (!spaceAvailable.wait_for(lock, MAX_BLOCK_TIME, [this] { return closed || pendingEvents < maxQueueSize; })) {
+      LOG_WARNING_(LOGINSTANCE) << "Dropping " << name(type) << " event as the event queue stayed full for " << MAX_BLOCK_TIME.count() << " ms";
+      return false;
+    }
+    return !closed;
+  }
+
+  auto oldest = std::find_if(queue.begin(), queue.end(), [type](const Event& event) {
+    return event.type == type;
+  });
+  if (oldest == queue.end()) {
+    return false;
+  }
+
+  queue.erase(oldest);
+  --pendingEvents;
+  ++typeState.dropped;
+  --typeState.depth;
+  return true;
+}
+
+// Bounded MPMC queue algorithm by Dmitry Vyukov, used with a single consumer. Each slot
+// sequence tells whether the slot is free for the producer at a position (== pos) or holds
+// a published record for the consumer (== pos + 1).
+bool EventChannel::tryPushRecord(const EventRecord& record) {
+  uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+  RingSlot* slot;
+  while (true) {
+    slot = &ring[pos & (ringCapacity - 1)];
+    const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const int64_t diff = (int64_t)sequence - (int64_t)pos;
+    if (diff == 0) {
+      if (enqueuePos.compare_exchange_weak(pos, pos + 1)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false; // Full.
+    } else {
+      pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Numbered after the slot is claimed (and queued events under the lock), so every record
+  // numbered before a queued event has a position below the high-water mark drain reads with
+  // the queue.
+  slot->record = record;
+  slot->record.seq = nextSeq++;
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+// Only called on the javascript main thread.
+bool EventChannel::tryPopRecord(EventRecord& record) {
+  RingSlot& slot = ring[dequeuePos & (ringCapacity - 1)];
+  const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+  if ((int64_t)sequence - (int64_t)(dequeuePos + 1) < 0) {
+    return false; // Empty or next record not yet published.
+  }
+
+  record = slot.record;
+  slot.sequence.store(dequeuePos + ringCapacity, std::memory_order_release);
+  ++dequeuePos;
+  return true;
+}
+
+// Copy text into the active arena. When it is full, switch to the other arena once all of its
+// strings have been consumed, so a steady stream of strings never stalls the reset.
+bool EventChannel::allocateText(const char * text, size_t textLength, EventRecord& record) {
+  if (textLength > ARENA_SIZE) {
+    return false;
+  }
+
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    const int index = activeArena.load();
+    Arena& arena = arenas[index];
+
+    uint64_t state = arena.state.load();
+    while (true) {
+      const uint64_t used = state >> 32;
+      const uint64_t outstanding = state & OUTSTANDING_MASK;
+      if (used + textLength > ARENA_SIZE) {
+        break;
+      }
+      if (arena.state.compare_exchange_weak(state, ((used + textLength) << 32) | (outstanding + 1))) {
+        std::memcpy(arena.data.get() + used, text, textLength);
+        record.text = arena.data.get() + used;
+        record.textLength = (uint32_t)textLength;
+        record.textArena = (int8_t)index;
+        return true;
+      }
+    }
+
+    if (arenas[1 - index].state.load() != 0) {
+      return false;
+    }
+    int expected = index;
+    activeArena.compare_exchange_strong(expected, 1 - index);
+  }
+
+  return false;
+}
+
+void EventChannel::releaseText(const EventRecord& record) {
+  if (record.textArena < 0) {
+    return;
+  }
+
+  std::atomic<uint64_t>& arenaState = arenas[record.textArena].state;
+  uint64_t state = arenaState.load();
+  while (true) {
+    const uint64_t outstanding = (state & OUTSTANDING_MASK) - 1;
+    // The last outstanding string resets the arena.
+    const uint64_t newState = outstanding == 0 ? 0 : ((state & ~OUTSTANDING_MASK) | outstanding);
+    if (arenaState.compare_exchange_weak(state, newState)) {
+      return;
+    }
+  }
+}
+
+void EventChannel::signal() {
+  if (signalled.exchange(true)) {
+    return;
+  }
+
+  auto self = shared_from_this();
+  if (wakeUp.NonBlockingCall([self](Napi::Env env, Napi::Function) { self->drain(env); }) != napi_ok) {
+    signalled = false;
+  }
+}
+
+void EventChannel::drain(Napi::Env env) {
+  // Reset before draining, so anything posted from now on signals again.
+  signalled = false;
+
+  // Take the queue together with the ring high-water mark and drain the ring exactly up to it:
+  // Records numbered before a queued event are below the mark, records beyond it may be numbered
+  // after a queued event that is not in this snapshot, so they wait for the next tick.
+  std::deque<Event> events;
+  uint64_t highWater;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.swap(queue);
+    highWater = enqueuePos.load();
+  }
+
+  drained.clear();
+  EventRecord record;
+  while (dequeuePos < highWater) {
+    if (tryPopRecord(record)) {
+      drained.push_back(record);
+    } else {
+      // Claimed by a producer that is still copying the record into the slot.
+      std::this_thread::yield();
+    }
+  }
+
+  // Under the lock, so blocked producers can not miss the room made.
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pendingEvents -= drained.size() + events.size();
+  }
+  spaceAvailable.notify_all();
+
+  if (!closed) {
+    deliver(env, events);
+  } else {
+    discard(events);
+  }
+
+  for (const EventRecord& drainedRecord : drained) {
+    releaseText(drainedRecord);
+  }
+}
+
+// Account for the drained records and queued events without delivering them.
+void EventChannel::discard(const std::deque<Event>& events) {
+  for (const EventRecord& drainedRecord : drained) {
+    --types[(size_t)drainedRecord.type].depth;
+  }
+  for (const Event& event : events) {
+    --types[(size_t)event.type].depth;
+  }
+}
+
+void EventChannel::deliver(Napi::Env env, std::deque<Event>& events) {
+  struct Pending {
+    uint64_t seq;
+    EventType type;
+    uint32_t key;
+    uint64_t firedNs;
+    uint64_t queuedNs;
+    const EventRecord* record;
+    const Event* event;
+    bool skip;
+  };
+
+  // Merge ring and queue back into posting order.
+  std::vector<Pending> pending;
+  pending.reserve(drained.size() + events.size());
+  for (const EventRecord& drainedRecord : drained) {
+    pending.push_back({ drainedRecord.seq, drainedRecord.type, drainedRecord.key, drainedRecord.firedNs, drainedRecord.queuedNs, &drainedRecord, nullptr, false });
+  }
+  for (Event& event : events) {
+    if (event.hasRecord && !event.text.empty()) {
+      event.record.text = event.text.data();
+      event.record.textLength = (uint32_t)event.text.size();
+    }
+    pending.push_back({ event.seq, event.type, event.key, event.record.firedNs, event.record.queuedNs, event.hasRecord ? &event.record : nullptr, &event, false });
+  }
+  std::sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b) { return a.seq < b.seq; });
+
+  // Keep-latest: Only the newest pending event per key is delivered for coalescing types.
+  std::unordered_set<uint64_t> latest;
+  for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+    TypeState& typeState = types[(size_t)it->type];
+    --typeState.depth;
+    if (typeState.policy == OverflowPolicy::Coalesce && !latest.insert(((uint64_t)it->type << 32) | it->key).second) {
+      it->skip = true;
+      ++typeState.coalesced;
+    }
+  }
+
+  Napi::HandleScope scope(env);
+  Napi::Object receiver = env.Global();
+  const util::PropertyKeys keys(env);
+
+  // Batched event types are collected per type and delivered after the unbatched ones.
+  std::array<Napi::Array, (size_t)EventType::COUNT> batches;
+
+  for (const Pending& entry : pending) {
+    if (entry.skip) {
+      continue;
+    }
+
+    const size_t index = (size_t)entry.type;
+    ++types[index].delivered;
+
+    const uint64_t deliveredNs = eventClockNs();
+    TypeLatency& latency = latencies[index];
+    latency.callbackToQueue.record(entry.queuedNs - entry.firedNs);
+    latency.queueToDelivery.record(deliveredNs - entry.queuedNs);
+    latency.callbackToDelivery.record(deliveredNs - entry.firedNs);
+
+    try {
+      std::vector<napi_value> args;
+      if (entry.record) {
+        entry.record->decode(env, keys, *entry.record, args);
+      } else {
+        entry.event->argFunc(env, keys, args);
+      }
+
+      if (types[index].timing) {
+        Napi::Object eventTiming = Napi::Object::New(env);
+        eventTiming.Set(Napi::String::New(env, "event"), Napi::String::New(env, eventTypeNames[index]));
+        eventTiming.Set(Napi::String::New(env, "seq"), Napi::Number::New(env, (double)entry.seq));
+        eventTiming.Set(Napi::String::New(env, "queuedUs"), Napi::Number::New(env, (entry.queuedNs - entry.firedNs) / 1000.0));
+        eventTiming.Set(Napi::String::New(env, "deliveredUs"), Napi::Number::New(env, (deliveredNs - entry.firedNs) / 1000.0));
+        args.push_back(eventTiming);
+      }
+
+      if (types[index].batched) {
+        if (batches[index].IsEmpty()) {
+          batches[index] = Napi::Array::New(env);
+        }
+        Napi::Array eventArgs = Napi::Array::New(env, args.size());
+        for (size_t i = 0; i < args.size(); ++i) {
+          eventArgs.Set(i, args[i]);
+        }
+        batches[index].Set(batches[index].Length(), eventArgs);
+      } else {
+        callbacks[index].MakeCallback(receiver, args);
+      }
+    } catch (const Napi::Error& e) {
+      reportUncaught(env, entry.type, e);
+    } catch (const std::exception& e) {
+      LOG_ERROR_(LOGINSTANCE) << "Delivery of " << name(entry.type) << " event failed with details " << e.what();
+    }
+  }
+
+  for (size_t index = 0; index < batches.size(); ++index) {
+    if (!batches[index].IsEmpty()) {
+      try {
+        callbacks[index].MakeCallback(receiver, { batches[index] });
+      } catch (const Napi::Error& e) {
+        reportUncaught(env, (EventType)index, e);
+      }
+    }
+  }
+}
+
+void EventChannel::reportUncaught(Napi::Env env, EventType type, const Napi::Error& error) {
+  // An exception thrown by a listener is reported as uncaught (process 'uncaughtException'), as
+  // it would be had the listener been called directly from the event loop. Delivery of the
+  // remaining events continues if the process survives it.
+  napi_status status = napi_fatal_exception(env, error.Value());
+  if (status != napi_ok) {
+    LOG_ERROR_(LOGINSTANCE) << "Delivery of " << name(type) << " event failed with details " << error.Message();
+  }
+}
+
+void EventChannel::close() {
+  std::deque<Event> events;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (closed) {
+      return;
+    }
+    closed = true;
+    events.swap(queue);
+  }
+  spaceAvailable.notify_all();
+
+  // Producers only touch the ring and the thread safe function between entering and leaving post.
+  while (activePosters != 0) {
+    std::this_thread::yield();
+  }
+
+  // Nothing is published anymore - release what is still pending, so the stats add up.
+  drained.clear();
+  EventRecord record;
+  while (tryPopRecord(record)) {
+    drained.push_back(record);
+  }
+  discard(events);
+  pendingEvents -= drained.size() + events.size();
+  for (const EventRecord& drainedRecord : drained) {
+    releaseText(drainedRecord);
+  }
+  drained.clear();
+
+  wakeUp.Release();
+
+  for (Napi::FunctionReference& callback : callbacks) {
+    callback.Reset();
+  }
+}
+
+Napi::Object EventChannel::getStats(Napi::Env env) {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set(Napi::String::New(env, "maxQueueSize"), Napi::Number::New(env, maxQueueSize));
+  result.Set(Napi::String::New(env, "queueDepth"), Napi::Number::New(env, queue.size()));
+  result.Set(Napi::String::New(env, "maxQueueDepth"), Napi::Number::New(env, (double)maxQueueDepth.load()));
+  result.Set(Napi::String::New(env, "ringCapacity"), Napi::Number::New(env, ringCapacity));
+  result.Set(Napi::String::New(env, "ringDepth"), Napi::Number::New(env, (double)(enqueuePos.load() - dequeuePos)));
+  result.Set(Napi::String::New(env, "ringFallbacks"), Napi::Number::New(env, (double)ringFallbacks.load()));
+
+  Napi::Object events = Napi::Object::New(env);
+  for (size_t i = 0; i < types.size(); ++i) {
+    const TypeState& typeState = types[i];
+    Napi::Object counters = Napi::Object::New(env);
+    counters.Set(Napi::String::New(env, "delivered"), Napi::Number::New(env, (double)typeState.delivered.load()));
+    counters.Set(Napi::String::New(env, "dropped"), Napi::Number::New(env, (double)typeState.dropped.load()));
+    counters.Set(Napi::String::New(env, "coalesced"), Napi::Number::New(env, (double)typeState.coalesced.load()));
+    counters.Set(Napi::String::New(env, "blocked"), Napi::Number::New(env, (double)typeState.blocked.load()));
+    counters.Set(Napi::String::New(env, "depth"), Napi::Number::New(env, typeState.depth.load()));
+    counters.Set(Napi::String::New(env, "maxDepth"), Napi::Number::New(env, typeState.maxDepth.load()));
+
+    const TypeLatency& latency = latencies[i];
+    if (latency.callbackToDelivery.total > 0) {
+      Napi::Object latencyStats = Napi::Object::New(env);
+      latencyStats.Set(Napi::String::New(env, "callbackToQueue"), latency.callbackToQueue.toNapi(env, 1000.0));
+      latencyStats.Set(Napi::String::New(env, "queueToDelivery"), latency.queueToDelivery.toNapi(env, 1000.0));
+      latencyStats.Set(Napi::String::New(env, "callbackToDelivery"), latency.callbackToDelivery.toNapi(env, 1000.0));
+      counters.Set(Napi::String::New(env, "latency"), latencyStats);
+    }
+    events.Set(Napi::String::New(env, eventTypeNames[i]), counters);
+  }
+  result.Set(Napi::String::New(env, "events"), events);
+
+  return result;
+}
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <napi.h>
+#include <Common.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "perfstats.h"
+#include "propertykeys.h"
+
+/**
+ * All event types delivered from Jabra SDK threads to javascript. The numeric value is the index
+ * of the javascript callback passed to the EventChannel.
+ */
+enum class EventType : uint8_t {
+  Initialized,
+  FirstScanDone,
+  Attached,
+  DeAttached,
+  ButtonInDataTranslated,
+  DevLog,
+  DiagnosticLog,
+  BatteryStatus,
+  RemoteMmi,
+  XpressConnectionStatus,
+  DownloadFirmwareProgress,
+  UploadProgress,
+  PairingList,
+  GNPButtonEvent,
+  DectInfo,
+  CameraStatus,
+  BluetoothLinkQuality,
+  NetworkStatusChange,
+  SettingsChanged,
+  HeadDetectionStatus,
+  JackConnectorStatus,
+  LinkConnectionStatus,
+  COUNT
+};
+
+/**
+ * What to do when an event is posted to a full channel:
+ * - Block: Wait (bounded) on the posting SDK thread for javascript to drain the queue. If it
+ *   stays full, the event is dropped, counted and logged as a warning.
+ * - DropOldest: Drop the oldest queued event of the same type (or the new event if there is none).
+ * - Coalesce: Only deliver the latest pending event with the same key (keep-latest), otherwise as DropOldest.
+ */
+enum class OverflowPolicy : uint8_t {
+  Block,
+  DropOldest,
+  Coalesce
+};
+
+struct EventRecord;
+
+/**
+ * Produces the javascript arguments for an event record - runs on the javascript main thread.
+ * The property keys are shared by all events delivered in the same tick.
+ */
+typedef void (*EventDecoder)(Napi::Env env, const util::PropertyKeys& keys, const EventRecord& record, std::vector<napi_value>& args);
+
+/**
+ * Monotonic nanosecond clock used to trace events through the channel.
+ */
+inline uint64_t eventClockNs() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Fixed size POD event as posted from SDK threads without any heap allocation. The payload
+ * union is tagged by the event type. Text is copied into an arena owned by the channel and
+ * is only valid while the decoder runs.
+ */
+struct EventRecord {
+  EventDecoder decode;
+  unsigned short deviceId;
+
+  union {
+    uint64_t eventTime;
+    struct { int32_t levelInPercent; bool charging; bool batteryLow; } battery;
+    struct { int32_t translatedInData; bool buttonInData; } button;
+    struct { int32_t type; int32_t input; } remoteMmi;
+    struct { int32_t type; int32_t status; int32_t percentage; } progress;
+    struct { int32_t phy; int32_t status; } network;
+    struct { bool leftOn; bool rightOn; } headDetection;
+    struct { bool open; int32_t component; } linkConnection;
+    int32_t value;
+    bool status;
+    Jabra_DectInfo dectInfo;
+  } payload;
+
+  // Set with eventClockNs when the SDK callback fires (0 means when the event is posted).
+  uint64_t firedNs;
+
+  // Set by the channel.
+  uint64_t queuedNs;
+  const char * text;
+  uint32_t textLength;
+  int8_t textArena;
+  EventType type;
+  uint32_t key;
+  uint64_t seq;
+};
+
+static_assert(std::is_trivially_copyable<EventRecord>::value, "EventRecord must be POD");
+
+/**
+ * Single bounded cross-thread channel for all Jabra SDK events, based on Napi::ThreadSafeFunction.
+ *
+ * Fixed size event records go through a preallocated lock-free multi-producer/single-consumer
+ * ring with a string arena, so SDK threads never allocate or take a lock for frequent events.
+ * Events that do not fit a record, events with the Block policy and records that do not fit in
+ * a full ring/arena (or a full channel) go through a mutex protected queue instead, where the
+ * overflow policy applies. Ring and queue share one bound of maxQueueSize pending events.
+ * Events are numbered when they are published to either, and both are drained on the javascript
+ * main thread in a single tick in that order. The thread safe function only carries a wake-up
+ * signal, so at most one call is ever pending in it regardless of the event rate.
+ */
+class EventChannel : public std::enable_shared_from_this<EventChannel>
+{
+  public:
+    /**
+     * Produces the javascript arguments for an event - runs on the javascript main thread.
+     * The property keys are shared by all events delivered in the same tick.
+     */
+    using ArgFunc = std::function<void(Napi::Env, const util::PropertyKeys&, std::vector<napi_value>&)>;
+
+    /**
+     * Must be called on the javascript main thread with one callback per EventType.
+     */
+    static std::shared_ptr<EventChannel> New(Napi::Env env, const std::vector<Napi::Function>& callbacks, size_t maxQueueSize);
+
+    EventChannel(const EventChannel&) = delete;
+    EventChannel& operator=(const EventChannel&) = delete;
+    ~EventChannel();
+
+    /**
+     * Configure delivery for an event type. Should be done before events are posted.
+     * In batched mode all drained events of the type are passed to the callback in a single call
+     * as one array holding the argument list of each event.
+     */
+    void setBatched(EventType type, bool batched);
+    void setPolicy(EventType type, OverflowPolicy policy);
+
+    /**
+     * When enabled, an event timing object (event name, seq, queuedUs and deliveredUs - both relative
+     * to when the SDK callback fired) is appended to the javascript arguments of every event of the type.
+     */
+    void setTiming(EventType type, bool timing);
+
+    /**
+     * Post an event from any thread. The key identifies the event source (typically the device id)
+     * and is only used by the Coalesce policy. The event is timed from when it is posted.
+     */
+    void post(EventType type, uint32_t key, const ArgFunc& argFunc);
+    void post(EventType type, const ArgFunc& argFunc) { post(type, 0, argFunc); }
+
+    /**
+     * Post a fixed size event record from any thread, optionally with text that is copied into
+     * the string arena. Lock and allocation free unless the ring or arena is full.
+     */
+    void post(EventType type, uint32_t key, const EventRecord& record, const char * text = nullptr, size_t textLength = 0);
+
+    /**
+     * Stop delivery and release the thread safe function - must be called on the javascript main thread.
+     * Events posted after close are silently discarded.
+     */
+    void close();
+
+    /**
+     * Queue, per event type delivery/drop/depth counters and per event type latency from the SDK
+     * callback to the queue and on to javascript - must be called on the javascript main thread.
+     */
+    Napi::Object getStats(Napi::Env env);
+
+    /**
+     * Name of an event type as used in stats and timing.
+     */
+    static const char * name(EventType type);
+
+    /**
+     * Event type of an event name as emitted to javascript listeners (e.g. "attach" or
+     * "onBatteryStatusUpdate") - the names used in the eventDelivery configuration.
+     */
+    static bool typeFromPublicName(const std::string& name, EventType& type);
+
+    /**
+     * True for events that carry the latest state per device (or kind/interface), so older events
+     * of the type can be coalesced or throttled without losing information.
+     */
+    static bool isStateEvent(EventType type);
+
+  private:
+    // Events posted with an ArgFunc only use the timestamps of the record.
+    struct Event {
+      uint64_t seq;
+      EventType type;
+      uint32_t key;
+      ArgFunc argFunc;
+      bool hasRecord;
+      EventRecord record;
+      std::string text;
+    };
+
+    struct TypeState {
+      std::atomic<OverflowPolicy> policy{OverflowPolicy::Block};
+      std::atomic<bool> batched{false};
+      std::atomic<bool> timing{false};
+      std::atomic<uint64_t> delivered{0};
+      std::atomic<uint64_t> dropped{0};
+      std::atomic<uint64_t> coalesced{0};
+      std::atomic<uint64_t> blocked{0};
+      std::atomic<uint32_t> depth{0};
+      std::atomic<uint32_t> maxDepth{0};
+    };
+
+    // Event latencies in nanoseconds - only touched on the javascript main thread.
+    struct TypeLatency {
+      util::LatencyHistogram callbackToQueue;
+      util::LatencyHistogram queueToDelivery;
+      util::LatencyHistogram callbackToDelivery;
+    };
+
+    struct RingSlot {
+      std::atomic<uint64_t> sequence;
+      EventRecord record;
+    };
+
+    // Bump allocator that is reset when all its strings have been consumed. State is packed
+    // into one word (high 32 bits: used bytes, low 32 bits: outstanding strings).
+    struct Arena {
+      std::unique_ptr<char[]> data;
+      std::atomic<uint64_t> state{0};
+    };
+
+    EventChannel(Napi::Env env, const std::vector<Napi::Function>& callbacks, size_t maxQueueSize);
+
+    void postQueued(Event&& event);
+    bool makeRoom(std::unique_lock<std::mutex>& lock, EventType type, TypeState& typeState);
+    void addDepth(TypeState& typeState);
+    bool reservePending();
+    void notePending(size_t pending);
+    bool tryPushRecord(const EventRecord& record);
+    bool tryPopRecord(EventRecord& record);
+    bool allocateText(const char * text, size_t textLength, EventRecord& record);
+    void releaseText(const EventRecord& record);
+    void signal();
+    void drain(Napi::Env env);
+    void discard(const std::deque<Event>& events);
+    void deliver(Napi::Env env, std::deque<Event>& events);
+    void reportUncaught(Napi::Env env, EventType type, const Napi::Error& error);
+
+    const size_t maxQueueSize;
+    std::vector<Napi::FunctionReference> callbacks;
+    Napi::ThreadSafeFunction wakeUp;
+    std::array<TypeState, (size_t)EventType::COUNT> types;
+    std::array<TypeLatency, (size_t)EventType::COUNT> latencies;
+
+    std::atomic<uint64_t> nextSeq;
+    std::atomic<bool> signalled;
+    std::atomic<bool> closed;
+    std::atomic<unsigned int> activePosters;
+    std::atomic<uint64_t> ringFallbacks;
+
+    // Lock-free ring (producers: any thread, consumer: javascript main thread).
+    const size_t ringCapacity;
+    std::unique_ptr<RingSlot[]> ring;
+    std::atomic<uint64_t> enqueuePos;
+    uint64_t dequeuePos;
+    std::array<Arena, 2> arenas;
+    std::atomic<int> activeArena;
+    std::vector<EventRecord> drained;
+
+    // Bounded queue for everything else.
+    std::mutex mutex;
+    std::condition_variable spaceAvailable;
+    std::deque<Event> queue;
+
+    // Events pending in the ring and the queue together, bounded by maxQueueSize.
+    std::atomic<size_t> pendingEvents;
+    std::atomic<size_t> maxQueueDepth;
+};
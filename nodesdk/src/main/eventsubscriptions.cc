@@ -0,0 +1,462 @@
+#include "eventsubscriptions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+static_assert((size_t)EventType::COUNT <= 32, "Subscribed event types must fit in a 32 bit mask");
+
+// Device event names as used by DeviceType.on() mapped to the event type delivering them.
+const std::unordered_map<std::string, EventType> deviceEventTypes = {
+  { "btnPress", EventType::ButtonInDataTranslated },
+  { "onDevLogEvent", EventType::DevLog },
+  { "onDiagLogEvent", EventType::DiagnosticLog },
+  { "onBatteryStatusUpdate", EventType::BatteryStatus },
+  { "onRemoteMmiEvent", EventType::RemoteMmi },
+  { "onxpressConnectionStatusEvent", EventType::XpressConnectionStatus },
+  { "downloadFirmwareProgress", EventType::DownloadFirmwareProgress },
+  { "onUploadProgress", EventType::UploadProgress },
+  { "onBTParingListChange", EventType::PairingList },
+  { "onGNPBtnEvent", EventType::GNPButtonEvent },
+  { "onDectInfoEvent", EventType::DectInfo },
+  { "onCameraStatusEvent", EventType::CameraStatus },
+  { "onBluetoothLinkQualityChangeEvent", EventType::BluetoothLinkQuality },
+  { "onNetworkStatusChangedEvent", EventType::NetworkStatusChange },
+  { "onSettingsChanged", EventType::SettingsChanged },
+  { "onHeadDetectionStatusEvent", EventType::HeadDetectionStatus },
+  { "onJackConnectorStatusEvent", EventType::JackConnectorStatus },
+  { "onLinkConnectionStatusEvent", EventType::LinkConnectionStatus }
+};
+
+// One bit per subscribed event type for every possible device id, read without locking by the
+// sdk threads. Static storage, so only the pages of device ids in use are ever touched.
+std::atomic<uint32_t> subscribedTypes[USHRT_MAX + 1];
+
+// Reference counts behind the bits, keyed by device id and event type.
+std::unordered_map<uint32_t, uint32_t> subscriberCounts;
+std::mutex subscriberCountsMutex;
+
+// Event filter - everything passes until SetEventFilter is called (zero initialized state). The
+// device list is only consulted while deviceFilterActive is set.
+struct EventFilterState {
+  std::atomic<uint32_t> blockedTypes;
+  std::atomic<bool> deviceFilterActive;
+  std::atomic<bool> allowedDevices[USHRT_MAX + 1];
+  std::atomic<uint32_t> minIntervalsMs[(size_t)EventType::COUNT];
+  std::vector<unsigned short> allowedDeviceIds; // To reset allowedDevices, guarded by eventFilterMutex.
+};
+
+// A new filter is built in the unused state and published by incrementing the generation, so
+// readers never see a half replaced filter. Readers retry if the generation changed while they
+// read, as the state they read may then already be rebuilt for the next filter.
+EventFilterState eventFilters[2];
+std::atomic<uint32_t> eventFilterGeneration(0);
+std::mutex eventFilterMutex;
+
+template <typename F>
+auto readEventFilter(F readState) -> decltype(readState(eventFilters[0])) {
+  while (true) {
+    const uint32_t generation = eventFilterGeneration.load(std::memory_order_acquire);
+    const auto result = readState(eventFilters[generation & 1]);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (eventFilterGeneration.load(std::memory_order_relaxed) == generation) {
+      return result;
+    }
+  }
+}
+
+// Throttling state per event type and key (as posted to the event channel) of a state event.
+struct ThrottledEvent {
+  unsigned short deviceId;
+  uint64_t lastPostedNs;
+  uint64_t dueNs; // When the held back record is posted - 0 if there is none.
+  EventRecord heldBack;
+};
+
+struct Throttling {
+  std::mutex mutex;
+  std::condition_variable wakeUp;
+  std::unordered_map<uint64_t, ThrottledEvent> events;
+  ThrottledEventPoster poster = nullptr;
+  bool deliveryStarted = false;
+};
+
+std::atomic<uint64_t> filteredCounts[(size_t)EventType::COUNT];
+std::atomic<uint64_t> throttledCounts[(size_t)EventType::COUNT];
+
+uint32_t subscriptionKey(unsigned short deviceId, EventType type) {
+  return ((uint32_t)deviceId << 8) | (uint32_t)type;
+}
+
+uint32_t typeBit(EventType type) {
+  return 1u << (uint32_t)type;
+}
+
+uint64_t throttleKey(EventType type, uint32_t key) {
+  return ((uint64_t)type << 32) | key;
+}
+
+Throttling& throttling() {
+  // Intentionally leaked: The delivery thread is detached and may outlive static destruction at process exit.
+  static Throttling* instance = new Throttling();
+  return *instance;
+}
+
+// Post held back events - unless the last listener was removed while they were held back.
+void postHeldBackEvents(ThrottledEventPoster poster, const std::vector<std::pair<uint64_t, EventRecord>>& heldBack) {
+  for (const auto& entry : heldBack) {
+    const EventType type = (EventType)(entry.first >> 32);
+    if (poster && (subscribedTypes[entry.second.deviceId].load(std::memory_order_relaxed) & typeBit(type)) != 0) {
+      poster(type, (uint32_t)entry.first, entry.second);
+    }
+  }
+}
+
+// Posts held back events when their interval expires. Started with the first held back event
+// and then idles until the next one.
+void deliverHeldBackEvents() {
+  Throttling& state = throttling();
+  std::vector<std::pair<uint64_t, EventRecord>> due;
+  std::unique_lock<std::mutex> lock(state.mutex);
+  while (true) {
+    const uint64_t now = eventClockNs();
+    uint64_t nextDueNs = UINT64_MAX;
+    for (auto& entry : state.events) {
+      ThrottledEvent& event = entry.second;
+      if (event.dueNs == 0) {
+        continue;
+      }
+      if (event.dueNs <= now) {
+        due.emplace_back(entry.first, event.heldBack);
+        event.dueNs = 0;
+        event.lastPostedNs = now;
+      } else {
+        nextDueNs = std::min(nextDueNs, event.dueNs);
+      }
+    }
+
+    if (!due.empty()) {
+      const ThrottledEventPoster poster = state.poster;
+      lock.unlock();
+      postHeldBackEvents(poster, due);
+      due.clear();
+      lock.lock();
+    } else if (nextDueNs == UINT64_MAX) {
+      state.wakeUp.wait(lock);
+    } else {
+      state.wakeUp.wait_for(lock, std::chrono::nanoseconds(nextDueNs - now));
+    }
+  }
+}
+
+// Adds delta (+1 or -1) to the subscriber count and returns the new count. Must hold subscriberCountsMutex.
+uint32_t updateSubscription(unsigned short deviceId, EventType type, int delta) {
+  const uint32_t key = subscriptionKey(deviceId, type);
+  auto it = subscriberCounts.find(key);
+  const uint32_t count = it != subscriberCounts.end() ? it->second : 0;
+
+  if (delta > 0) {
+    subscriberCounts[key] = count + 1;
+    if (count == 0) {
+      subscribedTypes[deviceId].fetch_or(typeBit(type));
+    }
+    return count + 1;
+  }
+
+  // Unbalanced off() calls (or calls after the device was detached) are ignored.
+  if (count == 0) {
+    return 0;
+  }
+
+  if (count == 1) {
+    subscriberCounts.erase(it);
+    subscribedTypes[deviceId].fetch_and(~typeBit(type));
+    return 0;
+  }
+
+  it->second = count - 1;
+  return count - 1;
+}
+
+Napi::Value updateSubscriptionSync(const char * const functionName, const Napi::CallbackInfo& info, int delta) {
+  Napi::Env env = info.Env();
+
+  if (!util::verifyArguments(functionName, info, {util::NUMBER, util::STRING})) {
+    return env.Undefined();
+  }
+
+  const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
+  const std::string eventName = info[1].As<Napi::String>();
+
+  // Events without a native source (e.g. busyLightChange) have nothing to subscribe to.
+  auto it = deviceEventTypes.find(eventName);
+  if (it == deviceEventTypes.end()) {
+    return Napi::Number::New(env, 0);
+  }
+
+  std::lock_guard<std::mutex> lock(subscriberCountsMutex);
+  return Napi::Number::New(env, updateSubscription(deviceId, it->second, delta));
+}
+
+// Replace the filter. Must hold eventFilterMutex.
+void applyEventFilter(uint32_t types, const std::vector<unsigned short>* deviceIds, const std::vector<uint32_t>& intervalsMs) {
+  const uint32_t generation = eventFilterGeneration.load(std::memory_order_relaxed);
+  EventFilterState& next = eventFilters[(generation + 1) & 1];
+
+  // Readers that see any of the changes below must also see that the generation moved on.
+  std::atomic_thread_fence(std::memory_order_release);
+
+  for (unsigned short deviceId : next.allowedDeviceIds) {
+    next.allowedDevices[deviceId].store(false, std::memory_order_relaxed);
+  }
+  next.allowedDeviceIds.clear();
+
+  if (deviceIds) {
+    next.allowedDeviceIds = *deviceIds;
+    for (unsigned short deviceId : next.allowedDeviceIds) {
+      next.allowedDevices[deviceId].store(true, std::memory_order_relaxed);
+    }
+  }
+  next.deviceFilterActive.store(deviceIds != nullptr, std::memory_order_relaxed);
+
+  next.blockedTypes.store(~types, std::memory_order_relaxed);
+  for (size_t i = 0; i < (size_t)EventType::COUNT; ++i) {
+    next.minIntervalsMs[i].store(intervalsMs[i], std::memory_order_relaxed);
+  }
+
+  eventFilterGeneration.store(generation + 1, std::memory_order_release);
+
+  // Throttling starts over with the new intervals - events held back so far are posted now.
+  std::vector<std::pair<uint64_t, EventRecord>> heldBack;
+  ThrottledEventPoster poster;
+  {
+    Throttling& state = throttling();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (const auto& entry : state.events) {
+      if (entry.second.dueNs != 0) {
+        heldBack.emplace_back(entry.first, entry.second.heldBack);
+      }
+    }
+    state.events.clear();
+    poster = state.poster;
+  }
+  postHeldBackEvents(poster, heldBack);
+}
+
+} // namespace
+
+bool shouldPostEvent(EventType type, unsigned short deviceId) {
+  if ((subscribedTypes[deviceId].load(std::memory_order_relaxed) & typeBit(type)) == 0) {
+    return false;
+  }
+
+  const bool filtered = readEventFilter([type, deviceId](const EventFilterState& filter) {
+    return (filter.blockedTypes.load(std::memory_order_relaxed) & typeBit(type)) != 0 ||
+      (filter.deviceFilterActive.load(std::memory_order_relaxed) && !filter.allowedDevices[deviceId].load(std::memory_order_relaxed));
+  });
+  if (filtered) {
+    filteredCounts[(size_t)type].fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  return true;
+}
+
+void setThrottledEventPoster(ThrottledEventPoster poster) {
+  Throttling& state = throttling();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.poster = poster;
+}
+
+bool throttleEvent(EventType type, uint32_t key, const EventRecord& record) {
+  const uint32_t minIntervalMs = readEventFilter([type](const EventFilterState& filter) {
+    return filter.minIntervalsMs[(size_t)type].load(std::memory_order_relaxed);
+  });
+  if (minIntervalMs == 0) {
+    return false;
+  }
+
+  const uint64_t now = eventClockNs();
+  const uint64_t intervalNs = (uint64_t)minIntervalMs * 1000000;
+  Throttling& state = throttling();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  ThrottledEvent& event = state.events[throttleKey(type, key)];
+  event.deviceId = record.deviceId;
+
+  if (event.lastPostedNs == 0 || now - event.lastPostedNs >= intervalNs) {
+    // A record the delivery thread did not get to yet is superseded by this one.
+    if (event.dueNs != 0) {
+      event.dueNs = 0;
+      throttledCounts[(size_t)type].fetch_add(1, std::memory_order_relaxed);
+    }
+    event.lastPostedNs = now;
+    return false;
+  }
+
+  if (event.dueNs != 0) {
+    throttledCounts[(size_t)type].fetch_add(1, std::memory_order_relaxed);
+  } else {
+    event.dueNs = event.lastPostedNs + intervalNs;
+    if (!state.deliveryStarted) {
+      std::thread(&deliverHeldBackEvents).detach();
+      state.deliveryStarted = true;
+    }
+    state.wakeUp.notify_one();
+  }
+  event.heldBack = record;
+  return true;
+}
+
+void freeEventSubscriptions(unsigned short deviceId) {
+  {
+    std::lock_guard<std::mutex> lock(subscriberCountsMutex);
+    for (auto it = subscriberCounts.begin(); it != subscriberCounts.end();) {
+      if ((it->first >> 8) == deviceId) {
+        it = subscriberCounts.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    subscribedTypes[deviceId].store(0);
+  }
+
+  Throttling& state = throttling();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  for (auto it = state.events.begin(); it != state.events.end();) {
+    if (it->second.deviceId == deviceId) {
+      it = state.events.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void freeEventSubscriptions() {
+  {
+    std::lock_guard<std::mutex> lock(subscriberCountsMutex);
+    for (const auto& entry : subscriberCounts) {
+      subscribedTypes[entry.first >> 8].store(0);
+    }
+    subscriberCounts.clear();
+  }
+
+  std::lock_guard<std::mutex> lock(eventFilterMutex);
+  applyEventFilter(UINT32_MAX, nullptr, std::vector<uint32_t>((size_t)EventType::COUNT, 0));
+}
+
+void addEventFilterStats(Napi::Env env, Napi::Object& stats) {
+  Napi::Object events = stats.Get("events").As<Napi::Object>();
+  for (size_t i = 0; i < (size_t)EventType::COUNT; ++i) {
+    const char * const name = EventChannel::name((EventType)i);
+    if (events.Has(name)) {
+      Napi::Object counters = events.Get(name).As<Napi::Object>();
+      counters.Set(Napi::String::New(env, "filtered"), Napi::Number::New(env, (double)filteredCounts[i].load()));
+      counters.Set(Napi::String::New(env, "throttled"), Napi::Number::New(env, (double)throttledCounts[i].load()));
+    }
+  }
+}
+
+Napi::Value napi_SubscribeEventSync(const Napi::CallbackInfo& info) {
+  return util::JSyncWrapper<Napi::Value>(__func__, info, [](const char * const functionName, const Napi::CallbackInfo& info) -> Napi::Value {
+    return updateSubscriptionSync(functionName, info, +1);
+  });
+}
+
+Napi::Value napi_UnsubscribeEventSync(const Napi::CallbackInfo& info) {
+  return util::JSyncWrapper<Napi::Value>(__func__, info, [](const char * const functionName, const Napi::CallbackInfo& info) -> Napi::Value {
+    return updateSubscriptionSync(functionName, info, -1);
+  });
+}
+
+Napi::Value napi_SetEventFilter(const Napi::CallbackInfo& info) {
+  return util::JSyncWrapper<Napi::Value>(__func__, info, [](const char * const functionName, const Napi::CallbackInfo& info) -> Napi::Value {
+    Napi::Env env = info.Env();
+
+    if (!util::verifyArguments(functionName, info, {util::OBJECT})) {
+      return env.Undefined();
+    }
+
+    Napi::Object filter = info[0].As<Napi::Object>();
+
+    // Validate everything before the current filter is replaced.
+    auto typeOf = [&env, functionName](const std::string& eventName, EventType& type) {
+      auto it = deviceEventTypes.find(eventName);
+      if (it == deviceEventTypes.end()) {
+        const std::string errMsg = std::string(functionName) + " got unknown device event " + eventName;
+        LOG_ERROR_CAT_(LogCategory::callbacks) << errMsg;
+        Napi::TypeError::New(env, errMsg).ThrowAsJavaScriptException();
+        return false;
+      }
+      type = it->second;
+      return true;
+    };
+
+    uint32_t types = UINT32_MAX;
+    if (filter.Has("eventTypes")) {
+      Napi::Array eventTypes = filter.Get("eventTypes").As<Napi::Array>();
+      types = 0;
+      for (uint32_t i = 0; i < eventTypes.Length(); ++i) {
+        EventType type;
+        if (!typeOf(eventTypes.Get(i).As<Napi::String>(), type)) {
+          return env.Undefined();
+        }
+        types |= typeBit(type);
+      }
+    }
+
+    std::vector<unsigned short> deviceIds;
+    const bool hasDeviceIds = filter.Has("deviceIds");
+    if (hasDeviceIds) {
+      Napi::Array deviceIdsArray = filter.Get("deviceIds").As<Napi::Array>();
+      for (uint32_t i = 0; i < deviceIdsArray.Length(); ++i) {
+        deviceIds.push_back((unsigned short)deviceIdsArray.Get(i).As<Napi::Number>().Int32Value());
+      }
+    }
+
+    // Either one interval for all device events or intervals per device event name.
+    std::vector<uint32_t> intervalsMs((size_t)EventType::COUNT, 0);
+    if (filter.Has("minIntervalMs")) {
+      Napi::Value minIntervalMs = filter.Get("minIntervalMs");
+      // Only state events can be throttled - dropping e.g. button presses or firmware progress
+      // would lose information.
+      if (minIntervalMs.IsNumber()) {
+        const uint32_t intervalMs = minIntervalMs.As<Napi::Number>().Uint32Value();
+        for (const auto& entry : deviceEventTypes) {
+          if (EventChannel::isStateEvent(entry.second)) {
+            intervalsMs[(size_t)entry.second] = intervalMs;
+          }
+        }
+      } else {
+        Napi::Object intervals = minIntervalMs.As<Napi::Object>();
+        Napi::Array eventNames = intervals.GetPropertyNames();
+        for (uint32_t i = 0; i < eventNames.Length(); ++i) {
+          const std::string eventName = eventNames.Get(i).As<Napi::String>();
+          EventType type;
+          if (!typeOf(eventName, type)) {
+            return env.Undefined();
+          }
+          if (!EventChannel::isStateEvent(type)) {
+            const std::string errMsg = std::string(functionName) + " can not throttle " + eventName + " - only state events can be throttled";
+            LOG_ERROR_CAT_(LogCategory::callbacks) << errMsg;
+            Napi::TypeError::New(env, errMsg).ThrowAsJavaScriptException();
+            return env.Undefined();
+          }
+          intervalsMs[(size_t)type] = intervals.Get(eventName).As<Napi::Number>().Uint32Value();
+        }
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(eventFilterMutex);
+    applyEventFilter(types, hasDeviceIds ? &deviceIds : nullptr, intervalsMs);
+
+    return env.Undefined();
+  });
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "stdafx.h"
+#include "eventchannel.h"
+
+/**
+ * Per device subscriptions to device events, reference counted from DeviceType.on() and off()
+ * in javascript, and the event filter set with SetEventFilter. The sdk callbacks check
+ * shouldPostEvent before they copy or queue anything, so events nobody listens to (or that are
+ * filtered out) are dropped right where they arrive.
+ */
+
+/**
+ * True if the event has subscribers and passes the event filter. Safe to call from any thread
+ * and lock free.
+ */
+bool shouldPostEvent(EventType type, unsigned short deviceId);
+
+typedef void (*ThrottledEventPoster)(EventType type, uint32_t key, const EventRecord& record);
+
+/**
+ * Set how events held back by throttleEvent are posted once their interval has expired.
+ */
+void setThrottledEventPoster(ThrottledEventPoster poster);
+
+/**
+ * True if a state event must be held back, because the last event of its type and key was
+ * posted less than the minimum interval of the event filter ago. Only the latest held back
+ * record is kept and posted when the interval expires, so the final state is never lost.
+ * Call after shouldPostEvent with the key the event is posted with. Lock free unless the
+ * event type is throttled.
+ */
+bool throttleEvent(EventType type, uint32_t key, const EventRecord& record);
+
+/**
+ * Drop all subscriptions and held back events of a detached device - or of all devices,
+ * which also resets the event filter.
+ */
+void freeEventSubscriptions(unsigned short deviceId);
+void freeEventSubscriptions();
+
+/**
+ * Add the filtered and throttled counters to the per event counters of the event channel stats.
+ */
+void addEventFilterStats(Napi::Env env, Napi::Object& stats);
+
+// SubscribeEventSync(deviceId: number, eventName: string): number;
+Napi::Value napi_SubscribeEventSync(const Napi::CallbackInfo& info);
+
+// UnsubscribeEventSync(deviceId: number, eventName: string): number;
+Napi::Value napi_UnsubscribeEventSync(const Napi::CallbackInfo& info);
+
+// SetEventFilter(filter: EventFilter): void;
+Napi::Value napi_SetEventFilter(const Napi::CallbackInfo& info);
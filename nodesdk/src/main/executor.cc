@@ -0,0 +1,385 @@
+#include "stdafx.h"
+#include "executor.h"
+
+#include <uv.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const unsigned int DEFAULT_THREAD_COUNT = 4;
+const unsigned int MAX_THREAD_COUNT = 32;
+
+/**
+ * Delivers finished workers back to the javascript thread of their environment, where
+ * OnOK/OnError must run. Workers are posted from the executor threads and drained in a single
+ * uv_async tick inside one callback scope (so promise continuations run afterwards).
+ *
+ * There is one channel per environment (main thread, worker_threads, electron contexts), running
+ * on the event loop of that environment and closed by its cleanup hook. Workers finishing after
+ * their environment is gone are dropped.
+ */
+class CompletionChannel
+{
+  public:
+    // Called on the javascript thread of the environment.
+    static std::shared_ptr<CompletionChannel> forEnv(Napi::Env env) {
+      std::lock_guard<std::mutex> lock(channelsMutex);
+      auto it = channels.find(env);
+      if (it != channels.end()) {
+        return it->second;
+      }
+
+      std::shared_ptr<CompletionChannel> channel(new CompletionChannel(env));
+      channels.emplace(env, channel);
+
+      napi_status status = napi_add_env_cleanup_hook(env, &static_env_cleanup, env);
+      if (status != napi_ok) {
+        LOG_ERROR_(LOGINSTANCE) << "Executor could not register cleanup hook: " << status;
+      }
+
+      return channel;
+    }
+
+    // Called on the javascript thread for every queued worker.
+    void attach() {
+      // Keep the event loop alive while work is outstanding - same as libuv work requests do.
+      if (inflight++ == 0) {
+        uv_ref(reinterpret_cast<uv_handle_t *>(handle));
+      }
+    }
+
+    // Called on an executor thread when a worker has finished executing.
+    void post(Napi::AsyncWorker* worker) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (closed) {
+        // The environment is gone, so the worker can neither complete nor be destroyed.
+        LOG_WARNING_(LOGINSTANCE) << "Executor dropped a completed worker of a closed environment";
+        return;
+      }
+      completed.push_back(worker);
+      uv_async_send(handle);
+    }
+
+  private:
+    explicit CompletionChannel(Napi::Env env)
+      : inflight(0), env(env), context(new Napi::AsyncContext(env, "JabraDeviceExecutor")),
+        handle(new uv_async_t), closed(false) {
+      uv_loop_t * loop = nullptr;
+      napi_status status = napi_get_uv_event_loop(env, &loop);
+      if (status != napi_ok || loop == nullptr) {
+        throw Napi::Error::New(env, "Executor could not get the event loop of the environment");
+      }
+
+      uv_async_init(loop, handle, &static_async_callback);
+      handle->data = this;
+      uv_unref(reinterpret_cast<uv_handle_t *>(handle));
+    }
+
+    static void static_async_callback(uv_async_t *asyncHandle) {
+      static_cast<CompletionChannel *>(asyncHandle->data)->drain();
+    }
+
+    static void static_env_cleanup(void * arg) {
+      std::shared_ptr<CompletionChannel> channel;
+      {
+        std::lock_guard<std::mutex> lock(channelsMutex);
+        auto it = channels.find(static_cast<napi_env>(arg));
+        if (it == channels.end()) {
+          return;
+        }
+        channel = it->second;
+        channels.erase(it);
+      }
+      channel->close();
+    }
+
+    // Called on the javascript thread while the environment is torn down. Executor threads may
+    // still hold the channel, so it outlives this - but not the handle or async context.
+    void close() {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        completed.clear();
+      }
+
+      context.reset();
+      uv_close(reinterpret_cast<uv_handle_t *>(handle), [](uv_handle_t * closedHandle) {
+        delete reinterpret_cast<uv_async_t *>(closedHandle);
+      });
+      handle = nullptr;
+    }
+
+    // Report an exception thrown by a javascript callback as uncaught, like libuv work completions do.
+    void reportUncaught(const Napi::Error& error) {
+      napi_status status = napi_fatal_exception(env, error.Value());
+      if (status != napi_ok) {
+        LOG_ERROR_(LOGINSTANCE) << "Executor completion failure with details " << error.Message();
+      }
+    }
+
+    void drain() {
+      Napi::HandleScope scope(env);
+      Napi::CallbackScope callbackScope(env, *context);
+
+      while (true) {
+        std::vector<Napi::AsyncWorker*> workers;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (completed.empty()) {
+            break;
+          }
+          workers.swap(completed);
+        }
+
+        for (Napi::AsyncWorker* worker : workers) {
+          try {
+            worker->OnWorkComplete(env, napi_ok);
+            if (env.IsExceptionPending()) {
+              reportUncaught(env.GetAndClearPendingException());
+            }
+          } catch (const Napi::Error &e) {
+            reportUncaught(e);
+          } catch (const std::exception &e) {
+            LOG_ERROR_(LOGINSTANCE) << "Executor completion failure with details " << e.what();
+          } catch (...) {
+            LOG_ERROR_(LOGINSTANCE) << "Executor completion failure";
+          }
+
+          if (--inflight == 0 && handle != nullptr) {
+            uv_unref(reinterpret_cast<uv_handle_t *>(handle));
+          }
+        }
+      }
+    }
+
+    static std::unordered_map<napi_env, std::shared_ptr<CompletionChannel>> channels;
+    static std::mutex channelsMutex;
+
+    size_t inflight; // Only touched on the javascript thread.
+    Napi::Env env;
+    std::unique_ptr<Napi::AsyncContext> context;
+    uv_async_t * handle; // Owned by libuv after close.
+
+    std::mutex mutex;
+    bool closed;
+    std::vector<Napi::AsyncWorker*> completed;
+};
+
+std::unordered_map<napi_env, std::shared_ptr<CompletionChannel>> CompletionChannel::channels;
+std::mutex CompletionChannel::channelsMutex;
+
+class DeviceExecutor
+{
+  public:
+    static DeviceExecutor& instance() {
+      // Intentionally leaked: The threads are detached and may outlive static destruction at process exit.
+      static DeviceExecutor* executor = new DeviceExecutor(configuredThreadCount());
+      return *executor;
+    }
+
+    void queue(bool hasDevice, unsigned short deviceId, Napi::AsyncWorker* worker) {
+      std::shared_ptr<CompletionChannel> completion = CompletionChannel::forEnv(worker->Env());
+      completion->attach();
+
+      queue(hasDevice, deviceId, { worker, std::function<void()>(), std::move(completion), Clock::now() });
+    }
+
+    void queue(unsigned short deviceId, std::function<void()> work) {
+      queue(true, deviceId, { nullptr, std::move(work), std::shared_ptr<CompletionChannel>(), Clock::now() });
+    }
+
+    Napi::Object getStats(const Napi::Env& env) {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      Napi::Object result = Napi::Object::New(env);
+      result.Set(Napi::String::New(env, "threads"), Napi::Number::New(env, threadCount));
+      result.Set(Napi::String::New(env, "busyThreads"), Napi::Number::New(env, busyThreads));
+      result.Set(Napi::String::New(env, "queueDepth"), Napi::Number::New(env, queueDepth));
+      result.Set(Napi::String::New(env, "maxQueueDepth"), Napi::Number::New(env, maxQueueDepth));
+      result.Set(Napi::String::New(env, "queuedTotal"), Napi::Number::New(env, (double)queuedTotal));
+      result.Set(Napi::String::New(env, "completedTotal"), Napi::Number::New(env, (double)completedTotal));
+      result.Set(Napi::String::New(env, "avgWaitTimeUs"), Napi::Number::New(env, startedTotal > 0 ? (double)totalWaitUs / startedTotal : 0.0));
+      result.Set(Napi::String::New(env, "maxWaitTimeUs"), Napi::Number::New(env, (double)maxWaitUs));
+
+      Napi::Object deviceQueueDepths = Napi::Object::New(env);
+      for (const auto& entry : strands) {
+        // A strand stays in the map while its last call runs, but only waiting calls are reported.
+        if (entry.second.tasks.empty()) {
+          continue;
+        }
+        deviceQueueDepths.Set(Napi::Number::New(env, entry.first), Napi::Number::New(env, entry.second.tasks.size()));
+      }
+      result.Set(Napi::String::New(env, "deviceQueueDepths"), deviceQueueDepths);
+
+      return result;
+    }
+
+  private:
+    // Either a worker completed on the javascript thread of its env or native work without completion.
+    struct Task {
+      Napi::AsyncWorker* worker;
+      std::function<void()> work;
+      std::shared_ptr<CompletionChannel> completion;
+      Clock::time_point queuedAt;
+    };
+
+    struct Strand {
+      std::deque<Task> tasks;
+      bool scheduled = false;
+    };
+
+    // A ready entry is either a device strand with pending work or a single device-less task.
+    struct ReadyEntry {
+      bool hasDevice;
+      unsigned short deviceId;
+      Task task;
+    };
+
+    void queue(bool hasDevice, unsigned short deviceId, Task&& task) {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      if (hasDevice) {
+        Strand& strand = strands[deviceId];
+        strand.tasks.push_back(std::move(task));
+        if (!strand.scheduled) {
+          strand.scheduled = true;
+          ready.push_back({ true, deviceId, Task() });
+        }
+      } else {
+        ready.push_back({ false, 0, std::move(task) });
+      }
+
+      ++queuedTotal;
+      maxQueueDepth = std::max(maxQueueDepth, ++queueDepth);
+      cv.notify_one();
+    }
+
+    static unsigned int configuredThreadCount() {
+      const char * const value = std::getenv("LIBJABRA_NODE_EXECUTOR_THREADS");
+      const int count = value ? std::atoi(value) : 0;
+      if (count <= 0) {
+        return DEFAULT_THREAD_COUNT;
+      }
+      return std::min((unsigned int)count, MAX_THREAD_COUNT);
+    }
+
+    explicit DeviceExecutor(unsigned int threadCount)
+      : threadCount(threadCount), busyThreads(0), queueDepth(0), maxQueueDepth(0),
+        queuedTotal(0), startedTotal(0), completedTotal(0), totalWaitUs(0), maxWaitUs(0) {
+      LOG_INFO_(LOGINSTANCE) << "Starting device executor with " << threadCount << " threads";
+      for (unsigned int i = 0; i < threadCount; ++i) {
+        std::thread(&DeviceExecutor::run, this).detach();
+      }
+    }
+
+    void run() {
+      while (true) {
+        ReadyEntry entry;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          cv.wait(lock, [this] { return !ready.empty(); });
+
+          entry = std::move(ready.front());
+          ready.pop_front();
+
+          if (entry.hasDevice) {
+            Strand& strand = strands[entry.deviceId];
+            entry.task = std::move(strand.tasks.front());
+            strand.tasks.pop_front();
+          }
+
+          const uint64_t waitUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - entry.task.queuedAt).count();
+          totalWaitUs += waitUs;
+          maxWaitUs = std::max(maxWaitUs, waitUs);
+          ++startedTotal;
+          --queueDepth;
+          ++busyThreads;
+        }
+
+        Napi::AsyncWorker* const worker = entry.task.worker;
+        if (worker) {
+          worker->OnExecute(worker->Env());
+          entry.task.completion->post(worker);
+          entry.task.completion.reset();
+        } else {
+          try {
+            entry.task.work();
+          } catch (const std::exception& e) {
+            LOG_ERROR_(LOGINSTANCE) << "Native work for device #" << entry.deviceId << " failed: " << e.what();
+          } catch (...) {
+            LOG_ERROR_(LOGINSTANCE) << "Native work for device #" << entry.deviceId << " failed with unknown exception";
+          }
+          entry.task.work = nullptr;
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          --busyThreads;
+          ++completedTotal;
+
+          if (entry.hasDevice) {
+            auto it = strands.find(entry.deviceId);
+            if (it->second.tasks.empty()) {
+              strands.erase(it);
+            } else {
+              // Re-schedule at the back so a busy device can not starve the others.
+              ready.push_back({ true, entry.deviceId, Task() });
+              cv.notify_one();
+            }
+          }
+        }
+      }
+    }
+
+    const unsigned int threadCount;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<ReadyEntry> ready;
+    std::map<unsigned short, Strand> strands;
+
+    unsigned int busyThreads;
+    unsigned int queueDepth;
+    unsigned int maxQueueDepth;
+    uint64_t queuedTotal;
+    uint64_t startedTotal;
+    uint64_t completedTotal;
+    uint64_t totalWaitUs;
+    uint64_t maxWaitUs;
+};
+
+} // namespace
+
+namespace util {
+
+void QueueOnExecutor(Napi::AsyncWorker* worker) {
+  DeviceExecutor::instance().queue(false, 0, worker);
+}
+
+void QueueOnDevice(unsigned short deviceId, Napi::AsyncWorker* worker) {
+  DeviceExecutor::instance().queue(true, deviceId, worker);
+}
+
+void QueueOnDevice(unsigned short deviceId, std::function<void()> work) {
+  DeviceExecutor::instance().queue(deviceId, std::move(work));
+}
+
+} // namespace util
+
+Napi::Value napi_GetExecutorStatsSync(const Napi::CallbackInfo& info) {
+  return util::JSyncWrapper<Napi::Value>(__func__, info, [](const char * const functionName, const Napi::CallbackInfo& info) {
+    return DeviceExecutor::instance().getStats(info.Env());
+  });
+}
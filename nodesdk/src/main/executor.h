@@ -0,0 +1,49 @@
+#pragma once
+
+#include <napi.h>
+
+#include <functional>
+
+/**
+ * Native executor that runs async work outside the shared libuv threadpool.
+ *
+ * Work queued for a device is executed on a per-device strand, i.e. calls for the
+ * same device run one at a time in the order they were queued, while calls for
+ * different devices run in parallel. Work without a device runs on any free thread.
+ * All work shares a bounded pool of threads (default 4, configurable with the
+ * environment variable LIBJABRA_NODE_EXECUTOR_THREADS).
+ *
+ * Completion (OnOK/OnError) is always marshalled back to the javascript main thread.
+ */
+namespace util {
+
+/**
+ * Queue a worker for execution on the executor without any ordering guarantees.
+ *
+ * Must be called from the javascript main thread. The worker self-destructs after
+ * completion exactly as if Napi::AsyncWorker::Queue() had been called.
+ */
+void QueueOnExecutor(Napi::AsyncWorker* worker);
+
+/**
+ * Queue a worker for execution on the strand of a specific device.
+ *
+ * Must be called from the javascript main thread. The worker self-destructs after
+ * completion exactly as if Napi::AsyncWorker::Queue() had been called.
+ */
+void QueueOnDevice(unsigned short deviceId, Napi::AsyncWorker* worker);
+
+/**
+ * Queue native work without a javascript completion on the strand of a specific device.
+ *
+ * Safe to call from any thread, e.g. from sdk callbacks. Exceptions thrown by the work are
+ * logged and otherwise ignored.
+ */
+void QueueOnDevice(unsigned short deviceId, std::function<void()> work);
+
+} // namespace util
+
+/**
+ * Expose executor queue depth and wait-time statistics to node.
+ */
+Napi::Value napi_GetExecutorStatsSync(const Napi::CallbackInfo& info);
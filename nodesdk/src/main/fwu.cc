@@ -9,7 +9,7 @@ Napi::Value napi_DownloadFirmware(const Napi::CallbackInfo& info) {
     const std::string authorization = info[2].As<Napi::String>();
     Napi::Function javascriptResultCallback = info[3].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, version, authorization](){ 
@@ -18,7 +18,7 @@ Napi::Value napi_DownloadFirmware(const Napi::CallbackInfo& info) {
           throw util::JabraReturnCodeException(functionName, ret);
         }
       }
-    ))->Queue();
+    ));
   }
   return env.Undefined();
 }
@@ -31,7 +31,7 @@ Napi::Value napi_UpdateFirmware(const Napi::CallbackInfo& info) {
     const std::string firmFile = info[1].As<Napi::String>();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, firmFile](){ 
@@ -40,7 +40,7 @@ Napi::Value napi_UpdateFirmware(const Napi::CallbackInfo& info) {
           throw util::JabraReturnCodeException(functionName, ret);
         }
       }
-    ))->Queue();
+    ));
   }
   return env.Undefined();
 }
@@ -53,7 +53,7 @@ Napi::Value napi_DownloadFirmwareUpdater(const Napi::CallbackInfo& info) {
     const std::string authorization = info[1].As<Napi::String>();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, authorization](){ 
@@ -62,7 +62,7 @@ Napi::Value napi_DownloadFirmwareUpdater(const Napi::CallbackInfo& info) {
           throw util::JabraReturnCodeException(functionName, ret);
         }
       }
-    ))->Queue();
+    ));
   }
   return env.Undefined();
 }
@@ -75,7 +75,7 @@ Napi::Value napi_GetFirmwareFilePath(const Napi::CallbackInfo& info) {
     const std::string version = info[1].As<Napi::String>();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<std::string, Napi::String>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<std::string, Napi::String>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, version](){ 
@@ -89,7 +89,7 @@ Napi::Value napi_GetFirmwareFilePath(const Napi::CallbackInfo& info) {
       [](const Napi::Env& env, const std::string filePath) { 
         Napi::String napiResult = Napi::String::New(env, filePath.c_str());
         return napiResult;
-      }))->Queue();
+      }));
   }
   return env.Undefined();
 }
@@ -184,7 +184,7 @@ Napi::Value napi_GetLatestFirmwareInformation(const Napi::CallbackInfo& info) {
     const std::string authorizationId = info[1].As<Napi::String>();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<Jabra_FirmwareInfo *, Napi::Object>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<Jabra_FirmwareInfo *, Napi::Object>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, authorizationId](){ 
@@ -223,7 +223,7 @@ Napi::Value napi_GetLatestFirmwareInformation(const Napi::CallbackInfo& info) {
           Jabra_FreeFirmwareInfo(fwInfo);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -237,7 +237,8 @@ Napi::Value napi_CancelFirmwareDownload(const Napi::CallbackInfo& info) {
     const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-    (new util::JAsyncWorker<void, void>(
+    // Not queued on the device strand as it must be able to overtake a pending download.
+    util::QueueOnExecutor(new util::JAsyncWorker<void, void>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId](){ 
@@ -246,7 +247,7 @@ Napi::Value napi_CancelFirmwareDownload(const Napi::CallbackInfo& info) {
           util::JabraReturnCodeException::LogAndThrow(functionName, retv);
         }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -261,7 +262,7 @@ Napi::Value napi_CheckForFirmwareUpdate(const Napi::CallbackInfo& info) {
     const std::string authorizationId = info[1].As<Napi::String>();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<bool, Napi::Boolean>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<bool, Napi::Boolean>(
       functionName, 
       javascriptResultCallback,
       [functionName,deviceId,authorizationId](){
@@ -280,7 +281,7 @@ Napi::Value napi_CheckForFirmwareUpdate(const Napi::CallbackInfo& info) {
       [](const Napi::Env& env, const bool result) {
         return Napi::Boolean::New(env, result);
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
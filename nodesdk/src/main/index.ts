@@ -5,6 +5,7 @@ export * from './core-types';
 export * from './meta';
 export * from './logger';
 export * from './deviceconstants';
+export { toHexString } from './util';
 
 // Additional, backwards compatible export of jabra enums combined.
 import * as jabraEnums from "./jabra-enums";
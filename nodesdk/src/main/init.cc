@@ -10,6 +10,11 @@
 #include "app.h"
 #include "callControl.h"
 #include "deviceconstants.h"
+#include "deviceregistry.h"
+#include "eventsubscriptions.h"
+#include "executor.h"
+#include "perfstats.h"
+#include "propertykeys.h"
 
 
 /**
@@ -19,9 +24,16 @@
  * the exported javascript function is identical except it is without the "napi_" prefix.
   */
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  // Property names shared by the napi mappers of this environment.
+  util::PropertyKeys::Init(env);
+
+  // Log category of the exported functions - set per section below.
+  LogCategory exportsLogCategory = LogCategory::app;
+
   // App:
   EXPORTS_SET(Initialize)
   EXPORTS_SET(UnInitialize)
+  EXPORTS_SET(GetEventChannelStatsSync)
 
   EXPORTS_SET(ConnectToJabraApplication)
   EXPORTS_SET(DisconnectFromJabraApplication)
@@ -35,6 +47,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   EXPORTS_SET(GetVersion)
 
   // Device:
+  exportsLogCategory = LogCategory::device;
   EXPORTS_SET(GetFirmwareVersion)
   EXPORTS_SET(GetFirmwareVersionBundle)
   EXPORTS_SET(GetLatestFirmwareInformation)
@@ -91,11 +104,15 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   // Suported features
   EXPORTS_SET(IsFeatureSupported)
   EXPORTS_SET(GetSupportedFeatures)
+  EXPORTS_SET(GetDeviceSnapshot)
+  EXPORTS_SET(GetCachedDeviceInfoSync)
+  EXPORTS_SET(GetCapabilitiesSync)
 
   // Misc
   EXPORTS_SET(GetPanics)
 
   // FWU
+  exportsLogCategory = LogCategory::fwu;
   EXPORTS_SET(DownloadFirmware)
   EXPORTS_SET(UpdateFirmware)
   EXPORTS_SET(DownloadFirmwareUpdater)
@@ -106,9 +123,15 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   EXPORTS_SET(CheckForFirmwareUpdate)
 
   // Device settings:
+  exportsLogCategory = LogCategory::settings;
   EXPORTS_SET(SetSettings)
   EXPORTS_SET(GetSetting)
   EXPORTS_SET(GetSettings)
+  EXPORTS_SET(SetSettingValues)
+  EXPORTS_SET(GetSettingsDelta)
+  EXPORTS_SET(SettingsChangeEventEnabled)
+  EXPORTS_SET(GetSettingsSchema)
+  EXPORTS_SET(GetSettingValues)
   EXPORTS_SET(FactoryReset)
   EXPORTS_SET(IsFactoryResetSupported)
   EXPORTS_SET(IsSettingProtectionEnabled)
@@ -132,6 +155,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   EXPORTS_SET(GetMACAddress);
   
   // Remote MMI
+  exportsLogCategory = LogCategory::device;
   EXPORTS_SET(GetRemoteMmiFocus)
   EXPORTS_SET(ReleaseRemoteMmiFocus)
   EXPORTS_SET(IsRemoteMmiInFocus)
@@ -142,7 +166,13 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   EXPORTS_SET(IsBatteryStatusSupported)
   EXPORTS_SET(GetRemoteControlBatteryStatus)
 
+  // Device status events
+  EXPORTS_SET(HeadDetectionStatusEventEnabled)
+  EXPORTS_SET(JackConnectorStatusEventEnabled)
+  EXPORTS_SET(LinkConnectionStatusEventEnabled)
+
   // BT
+  exportsLogCategory = LogCategory::bt;
   EXPORTS_SET(SearchNewDevices)
   EXPORTS_SET(ConnectBTDevice)
   EXPORTS_SET(ConnectNewDevice)
@@ -166,6 +196,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   EXPORTS_SET(BTLinkQualityChangeEventEnabled)
 
   // DECT
+  exportsLogCategory = LogCategory::dect;
   EXPORTS_SET(GetConnectedHeadsetNames)
   EXPORTS_SET(TriggerDECTPairing)
   EXPORTS_SET(TriggerDECTSecurePairing)
@@ -173,14 +204,22 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   EXPORTS_SET(SetDECTPairingKey)
   
   // Callbacks:
+  exportsLogCategory = LogCategory::callbacks;
   EXPORTS_SET(IsDevLogEnabled);
   EXPORTS_SET(EnableDevLog);
+  EXPORTS_SET(SubscribeEventSync);
+  EXPORTS_SET(UnsubscribeEventSync);
+  EXPORTS_SET(SetEventFilter);
 
   // Setup logging.
+  exportsLogCategory = LogCategory::app;
   EXPORTS_SET(NativeAddonLog);
   EXPORTS_SET(GetNativeAddonLogConfig);
+  EXPORTS_SET(SetNativeAddonLogSeverity);
+  EXPORTS_SET(SetNativeAddonLogCategory);
 
   // Call control
+  exportsLogCategory = LogCategory::device;
   EXPORTS_SET(SetHold);
   EXPORTS_SET(GetBusyLightStatus);
   EXPORTS_SET(SetBusyLightStatus);
@@ -270,15 +309,29 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   EXPORTS_SET(GetConstIntegerSync);
   EXPORTS_SET(GetConstFieldSync);
   EXPORTS_SET(GetConstListSync);
+  EXPORTS_SET(GetConstPathSync);
+  EXPORTS_SET(GetConstTreeSync);
+
+  // Executor
+  exportsLogCategory = LogCategory::app;
+  EXPORTS_SET(GetExecutorStatsSync);
+
+  // Latency statistics
+  EXPORTS_SET(GetPerfStatsSync);
+  EXPORTS_SET(ResetPerfStats);
+
+  freezeLogCategories();
 
   try {
-    configureLogging();
+    configureLogging(env);
   } catch (const std::exception &e) {
     std::cerr << "Fatal log error - configureLogging for jabra sdk node wrapper failed:" << e.what() << std::flush;
   } catch (...) {
     std::cerr << "Fatal log error - configureLogging for jabra sdk node wrapper failed:" << std::flush;
   }
 
+  exports.Set(Napi::String::New(env, "NativeAddonLogSeverityGate"), createNativeAddonLogSeverityGate(env));
+
   return exports;
 }
 
@@ -486,6 +486,14 @@ export enum enumProxyType {
   High= 2
 };
 
+/**
+ * Component a link connection status refers to
+ */
+ export enum enumLinkStatusComponent {
+  RightEarbud = 0,
+  LeftEarbud = 1
+};
+
 /**
  * DECT headset pairing state
  */
@@ -0,0 +1,137 @@
+#include "jsonwriter.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <cmath>
+
+namespace util {
+
+JsonWriter::JsonWriter() : needComma(false) {
+}
+
+void JsonWriter::separate() {
+  if (needComma) {
+    out += ',';
+  }
+  needComma = true;
+}
+
+JsonWriter& JsonWriter::beginObject() {
+  separate();
+  out += '{';
+  needComma = false;
+  return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+  out += '}';
+  needComma = true;
+  return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+  separate();
+  out += '[';
+  needComma = false;
+  return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+  out += ']';
+  needComma = true;
+  return *this;
+}
+
+JsonWriter& JsonWriter::key(const char * name) {
+  separate();
+  quoted(name, strlen(name));
+  out += ':';
+  needComma = false;
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(const char * s) {
+  if (!s) {
+    return null();
+  }
+  separate();
+  quoted(s, strlen(s));
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(const std::string& s) {
+  separate();
+  quoted(s.data(), s.length());
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(bool b) {
+  separate();
+  out += b ? "true" : "false";
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(double d) {
+  if (!std::isfinite(d)) {
+    return null();
+  }
+  separate();
+  char buf[32];
+  int length = snprintf(buf, sizeof(buf), "%.17g", d);
+  out.append(buf, length);
+  return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+  separate();
+  out += "null";
+  return *this;
+}
+
+JsonWriter& JsonWriter::integer(int64_t i) {
+  separate();
+  char buf[24];
+  int length = snprintf(buf, sizeof(buf), "%lld", (long long)i);
+  out.append(buf, length);
+  return *this;
+}
+
+JsonWriter& JsonWriter::unsignedInteger(uint64_t i) {
+  separate();
+  char buf[24];
+  int length = snprintf(buf, sizeof(buf), "%llu", (unsigned long long)i);
+  out.append(buf, length);
+  return *this;
+}
+
+void JsonWriter::quoted(const char * s, size_t length) {
+  static const char hex[] = "0123456789abcdef";
+
+  out += '"';
+  const char * runStart = s;
+  for (const char * p = s; p != s + length; ++p) {
+    const unsigned char c = (unsigned char)*p;
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+
+    out.append(runStart, p - runStart);
+    runStart = p + 1;
+
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      default: {
+        const char escaped[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+        out.append(escaped, sizeof(escaped));
+      }
+    }
+  }
+  out.append(runStart, s + length - runStart);
+  out += '"';
+}
+
+} // namespace util
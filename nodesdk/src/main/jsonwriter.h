@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+/**
+ * Minimal streaming JSON writer for dumping native structures (f.x. for logging). Writes straight
+ * into a string buffer with commas and string escaping handled automatically - no intermediate
+ * streams or per value allocations.
+ *
+ * The writer owns the string it writes into - use take() to return it without copying.
+ *
+ * Nb. Dumps are only meant to be built when they are actually used, i.e. inside IF_LOG_.
+ */
+class JsonWriter
+{
+  public:
+    JsonWriter();
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+
+    /**
+     * Write an object member name - must be followed by a value, object or array.
+     */
+    JsonWriter& key(const char * name);
+
+    JsonWriter& value(const char * s); // nullptr is written as null.
+    JsonWriter& value(const std::string& s);
+    JsonWriter& value(bool b);
+    JsonWriter& value(double d);
+    JsonWriter& null();
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+    JsonWriter& value(T i) {
+      return std::is_signed<T>::value ? integer((int64_t)i) : unsignedInteger((uint64_t)i);
+    }
+
+    template <typename T>
+    JsonWriter& field(const char * name, const T& v) {
+      return key(name).value(v);
+    }
+
+    const std::string& str() const { return out; }
+
+    /**
+     * Move the written string out of the writer.
+     */
+    std::string take() { return std::move(out); }
+
+  private:
+    void separate();
+    void quoted(const char * s, size_t length);
+    JsonWriter& integer(int64_t i);
+    JsonWriter& unsignedInteger(uint64_t i);
+
+    std::string out;
+    bool needComma;
+};
+
+} // namespace util
@@ -1,6 +1,11 @@
 #include "logger.h"
 #include <string>
+#include <cstdlib>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <unordered_map>
 #ifdef  __APPLE__
 #include <unistd.h>
 #endif
@@ -8,6 +13,8 @@
 // Node lib headers:
 #include <napi.h>
 #include "napiutil.h"
+#include "asynclogappender.h"
+#include "binarylogencoder.h"
 
 using namespace std;
 
@@ -22,11 +29,174 @@ static bool endsWith(const std::string& str, const std::string& suffix)
 
 static std::string configuredLogPath = "";
 
+// Log file path used when logging is enabled (also at runtime with SetNativeAddonLogSeverity).
+static std::string logFilePath = "";
+
+// Javascript reads the app category severity from the severity gate array, which is only written
+// on the javascript main thread.
+static int32_t * severityGateData = nullptr;
+static napi_ref severityGateRef = nullptr;
+
+std::atomic<int> logCategorySeverities[(size_t)LogCategory::COUNT];
+std::atomic<uint32_t> logCategorySampleEvery[(size_t)LogCategory::COUNT];
+std::atomic<uint32_t> logCategorySampleCounters[(size_t)LogCategory::COUNT];
+
+static const char * const logCategoryNames[(size_t)LogCategory::COUNT] = {
+  "app", "device", "settings", "fwu", "bt", "dect", "callbacks"
+};
+
+struct CStringHash {
+  size_t operator()(const char * str) const {
+    size_t hash = 5381;
+    while (*str) {
+      hash = hash * 33 + (unsigned char)*str++;
+    }
+    return hash;
+  }
+};
+
+struct CStringEqual {
+  bool operator()(const char * a, const char * b) const {
+    return std::strcmp(a, b) == 0;
+  }
+};
+
+// Filled during the first module Init and read-only after that, so lookups need no lock.
+static std::unordered_map<const char *, LogCategory, CStringHash, CStringEqual> functionLogCategories;
+static std::atomic<bool> logCategoriesFrozen(false);
+
+// Set when logging goes through the background writer (the default). Intentionally leaked: plog
+// keeps a raw pointer to it until its own static teardown. Its writer thread is stopped by
+// stopAsyncLogging instead of being joined by a static destructor at process exit.
+static AsyncLogAppender* asyncAppender = nullptr;
+
+// Number of records the async appender can buffer before it starts dropping.
+static const size_t defaultAsyncLogBufferSize = 8192;
+
 const std::string& getLogFilePath() {
   return configuredLogPath;
 }
 
-void configureLogging() {
+static bool severityFromString(const std::string& str, plog::Severity& severity) {
+  if (str == "none") {
+    severity = plog::none;
+  } else if (str == "fatal") {
+    severity = plog::fatal;
+  } else if (str == "error") {
+    severity = plog::error;
+  } else if (str == "warning") {
+    severity = plog::warning;
+  } else if (str == "info") {
+    severity = plog::info;
+  } else if (str == "debug") {
+    severity = plog::debug;
+  } else if (str == "trace" || str == "verbose") {
+    severity = plog::verbose;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool logCategoryFromString(const std::string& str, LogCategory& category) {
+  for (size_t i = 0; i < (size_t)LogCategory::COUNT; ++i) {
+    if (str == logCategoryNames[i]) {
+      category = (LogCategory)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Is anything logged at all?
+static bool anyLogCategoryEnabled() {
+  for (const std::atomic<int>& severity : logCategorySeverities) {
+    if (severity.load() != plog::none) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Must be called on the javascript main thread once logging has been configured.
+static void setLogCategory(LogCategory category, plog::Severity severity, uint32_t sampleEvery) {
+  logCategorySeverities[(size_t)category] = severity;
+  logCategorySampleEvery[(size_t)category] = sampleEvery;
+
+  if (category == LogCategory::app) {
+    plog::get<LOGINSTANCE>()->setMaxSeverity(severity);
+    if (severityGateData) {
+      severityGateData[0] = severity;
+    }
+  }
+
+  configuredLogPath = anyLogCategoryEnabled() ? logFilePath : "";
+}
+
+/**
+ * Apply LIBJABRA_NODE_LOG_CATEGORIES, f.x. "fwu=verbose,bt=debug,callbacks=verbose/100" where
+ * the optional /N logs only 1 of every N hot path messages of the category.
+ */
+static void configureLogCategories(const char * spec) {
+  std::string rest(spec ? spec : "");
+  while (!rest.empty()) {
+    const size_t comma = rest.find(',');
+    const std::string item = rest.substr(0, comma);
+    rest = comma == std::string::npos ? "" : rest.substr(comma + 1);
+
+    const size_t eq = item.find('=');
+    if (eq == std::string::npos) {
+      continue;
+    }
+
+    const size_t slash = item.find('/', eq);
+    const std::string severityStr = item.substr(eq + 1, slash == std::string::npos ? std::string::npos : slash - eq - 1);
+    const uint32_t sampleEvery = slash == std::string::npos ? 1 : (uint32_t)std::strtoul(item.c_str() + slash + 1, nullptr, 10);
+
+    LogCategory category;
+    plog::Severity severity;
+    if (logCategoryFromString(item.substr(0, eq), category) && severityFromString(severityStr, severity)) {
+      logCategorySeverities[(size_t)category] = severity;
+      logCategorySampleEvery[(size_t)category] = (std::max)(sampleEvery, 1u);
+    }
+  }
+}
+
+void registerLogCategory(const char * functionName, LogCategory category) {
+  if (!logCategoriesFrozen) {
+    functionLogCategories[functionName] = category;
+  }
+}
+
+void freezeLogCategories() {
+  logCategoriesFrozen = true;
+}
+
+LogCategory logCategoryOf(const char * functionName) {
+  if (!logCategoriesFrozen || !functionName) {
+    return LogCategory::app;
+  }
+  auto it = functionLogCategories.find(functionName);
+  return it != functionLogCategories.end() ? it->second : LogCategory::app;
+}
+
+static void stopAsyncLoggingHook(void * arg) {
+  stopAsyncLogging();
+}
+
+void stopAsyncLogging() {
+  if (asyncAppender) {
+    asyncAppender->stop();
+  }
+}
+
+void resumeAsyncLogging() {
+  if (asyncAppender) {
+    asyncAppender->start();
+  }
+}
+
+void configureLogging(Napi::Env env) {
   // Use same defaults and environment variable as Jabra SDK to setup
   // log destinaton.
   const char * const resPath = std::getenv("LIBJABRA_RESOURCE_PATH");
@@ -63,34 +233,65 @@ void configureLogging() {
 	#endif
   }
 
-  logPath = logPath.append("JabraNodeWrapper.log");
+  // LIBJABRA_NODE_LOG_FORMAT=binary selects the compact binary format (decode with jabra-log-decode).
+  const char * const formatEnv = std::getenv("LIBJABRA_NODE_LOG_FORMAT");
+  const bool useBinary = formatEnv && std::string(formatEnv) == "binary";
+
+  logPath = logPath.append(useBinary ? "JabraNodeWrapper.jlog" : "JabraNodeWrapper.log");
 
   // Use same environment variable and defaults as Jabra SDK to setup log level.
   const char * const _severityEnv = std::getenv("LIBJABRA_TRACE_LEVEL");
   std::string severityEnv(_severityEnv ? _severityEnv : "warning");
 
   plog::Severity severity = plog::warning;
-  if (severityEnv == "fatal") {
-    severity = plog::fatal;
-  } else if (severityEnv == "error") {
-    severity = plog::error;
-  } else if (severityEnv == "warning") {
-    severity = plog::warning;
-  } else if (severityEnv == "info") {
-    severity = plog::info;
-  } else if (severityEnv == "debug") {
-    severity = plog::debug;
-  } else if (severityEnv == "trace" || severityEnv == "verbose") {
-    severity = plog::verbose;
-	} else {
+  if (!severityFromString(severityEnv, severity)) {
     severity = plog::none;
   }
 
+  // Categories default to LIBJABRA_TRACE_LEVEL - override with LIBJABRA_NODE_LOG_CATEGORIES.
+  for (size_t i = 0; i < (size_t)LogCategory::COUNT; ++i) {
+    logCategorySeverities[i] = severity;
+    logCategorySampleEvery[i] = 1;
+  }
+  configureLogCategories(std::getenv("LIBJABRA_NODE_LOG_CATEGORIES"));
+  severity = (plog::Severity)logCategorySeverities[(size_t)LogCategory::app].load();
+
+  // Log file writing is done on a background thread unless LIBJABRA_NODE_LOG_ASYNC=0. The
+  // buffer size (in records) can be set with LIBJABRA_NODE_LOG_BUFFER. The binary format is
+  // only supported by the background writer.
+  const char * const asyncEnv = std::getenv("LIBJABRA_NODE_LOG_ASYNC");
+  const bool useAsync = useBinary || !(asyncEnv && std::string(asyncEnv) == "0");
+
+  const char * const bufferEnv = std::getenv("LIBJABRA_NODE_LOG_BUFFER");
+  size_t bufferSize = bufferEnv ? (size_t)std::strtoul(bufferEnv, nullptr, 10) : 0;
+  if (bufferSize == 0) {
+    bufferSize = defaultAsyncLogBufferSize;
+  }
+
   // Setup plog:
-	plog::init<LOGINSTANCE>(severity, logPath.c_str(), 10000000, 10);
+  // The appender is also set up when logging is off, so it can be enabled at runtime.
+  if (useAsync) {
+    if (!asyncAppender) {
+      std::unique_ptr<LogEncoder> encoder(useBinary ? (LogEncoder*)new BinaryLogEncoder() : (LogEncoder*)new TxtLogEncoder());
+	#ifdef _WIN32
+      asyncAppender = new AsyncLogAppender(plog::util::toWide(logPath.c_str()).c_str(), 10000000, 10, std::move(encoder), bufferSize);
+	#else
+      asyncAppender = new AsyncLogAppender(logPath.c_str(), 10000000, 10, std::move(encoder), bufferSize);
+	#endif
+      plog::init<LOGINSTANCE>(severity, asyncAppender);
+    }
+
+    napi_status status = napi_add_env_cleanup_hook(env, &stopAsyncLoggingHook, nullptr);
+    if (status != napi_ok) {
+      LOG_ERROR_(LOGINSTANCE) << "Logging could not register cleanup hook: " << status;
+    }
+  } else {
+	  plog::init<LOGINSTANCE>(severity, logPath.c_str(), 10000000, 10);
+  }
 
   // Save log location for reference (if anything is logged).
-  configuredLogPath = (severity!=plog::none) ? logPath : "";
+  logFilePath = logPath;
+  configuredLogPath = anyLogCategoryEnabled() ? logPath : "";
 
   // Log configuration:
   IF_LOG_(LOGINSTANCE, plog::info) {
@@ -110,11 +311,20 @@ Napi::Value napi_NativeAddonLog(const Napi::CallbackInfo& info) {
 
   if (util::verifyArguments(__func__, info, { util::NUMBER, util::STRING, util::OBJECT_OR_STRING })) {
     plog::Severity severity = (plog::Severity)(info[0].As<Napi::Number>().Int32Value());
+    if (!logCategoryEnabled(LogCategory::app, severity)) {
+      return env.Undefined();
+    }
+
     std::string caller = std::string("javascript:") + std::string(info[1].As<Napi::String>());
     std::string msg = info[2].As<Napi::Object>().ToString();
 
-    // Use variant of LOG macro implementation to ensure caller instead of __func__ is registered in log:
-    (*plog::get<LOGINSTANCE>()) += plog::Record(severity, caller.c_str(), 0, nullptr, PLOG_GET_THIS()) << msg;
+    if (asyncAppender) {
+      // Straight into the background writer - no plog::Record formatting on the javascript thread.
+      asyncAppender->enqueue(severity, caller, msg);
+    } else {
+      // Use variant of LOG macro implementation to ensure caller instead of __func__ is registered in log:
+      (*plog::get<LOGINSTANCE>()) += plog::Record(severity, caller.c_str(), 0, nullptr, PLOG_GET_THIS()) << msg;
+    }
   }
 
   return env.Undefined();
@@ -127,7 +337,7 @@ Napi::Value napi_GetNativeAddonLogConfig(const Napi::CallbackInfo& info) {
   const Napi::Env env = info.Env();
 
   if (util::verifyArguments(__func__, info, { })) {
-    plog::Severity maxSeverity = plog::get<LOGINSTANCE>()->getMaxSeverity();
+    plog::Severity maxSeverity = (plog::Severity)logCategorySeverities[(size_t)LogCategory::app].load();
     std::string maxSeverityStr = std::string(plog::severityToString(maxSeverity));
 
     Napi::Object config = Napi::Object::New(env);
@@ -135,9 +345,103 @@ Napi::Value napi_GetNativeAddonLogConfig(const Napi::CallbackInfo& info) {
     config.Set(Napi::String::New(env, "maxSeverity"), Napi::Number::New(env, maxSeverity));
     config.Set(Napi::String::New(env, "maxSeverityString"), Napi::String::New(env, maxSeverityStr));
     config.Set(Napi::String::New(env, "configuredLogPath"), Napi::String::New(env, configuredLogPath));
+    config.Set(Napi::String::New(env, "logFormat"), Napi::String::New(env, endsWith(configuredLogPath, ".jlog") ? "binary" : "text"));
+
+    Napi::Object categories = Napi::Object::New(env);
+    for (size_t i = 0; i < (size_t)LogCategory::COUNT; ++i) {
+      Napi::Object category = Napi::Object::New(env);
+      category.Set(Napi::String::New(env, "maxSeverity"), Napi::Number::New(env, logCategorySeverities[i].load()));
+      category.Set(Napi::String::New(env, "sampleEvery"), Napi::Number::New(env, logCategorySampleEvery[i].load()));
+      categories.Set(Napi::String::New(env, logCategoryNames[i]), category);
+    }
+    config.Set(Napi::String::New(env, "categories"), categories);
+
+    if (asyncAppender) {
+      const AsyncLogStats stats = asyncAppender->getStats();
+      Napi::Object asyncStats = Napi::Object::New(env);
+      asyncStats.Set(Napi::String::New(env, "capacity"), Napi::Number::New(env, (double)stats.capacity));
+      asyncStats.Set(Napi::String::New(env, "queued"), Napi::Number::New(env, (double)stats.queued));
+      asyncStats.Set(Napi::String::New(env, "written"), Napi::Number::New(env, (double)stats.written));
+      asyncStats.Set(Napi::String::New(env, "dropped"), Napi::Number::New(env, (double)stats.dropped));
+      asyncStats.Set(Napi::String::New(env, "batches"), Napi::Number::New(env, (double)stats.batches));
+      config.Set(Napi::String::New(env, "asyncLogging"), asyncStats);
+    }
 
     return config;
   }
 
   return env.Undefined();
 }
+
+static void freeSeverityGate(void * arg) {
+  napi_env env = (napi_env)arg;
+  if (severityGateRef) {
+    napi_delete_reference(env, severityGateRef);
+    severityGateRef = nullptr;
+  }
+  severityGateData = nullptr;
+}
+
+Napi::Int32Array createNativeAddonLogSeverityGate(Napi::Env env) {
+  Napi::Int32Array gate = Napi::Int32Array::New(env, 1);
+  gate[0] = logCategorySeverities[(size_t)LogCategory::app].load();
+
+  // Keep the array alive so native code can update it in place when the severity changes.
+  if (!severityGateRef) {
+    napi_status status = napi_create_reference(env, gate, 1, &severityGateRef);
+    if (status == napi_ok) {
+      severityGateData = gate.Data();
+      napi_add_env_cleanup_hook(env, &freeSeverityGate, env);
+    }
+  }
+
+  return gate;
+}
+
+/**
+ * Change the native log severity of all categories at runtime.
+ */
+Napi::Value napi_SetNativeAddonLogSeverity(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+
+  if (util::verifyArguments(__func__, info, { util::NUMBER })) {
+    int32_t severity = info[0].As<Napi::Number>().Int32Value();
+    severity = (std::max)((int32_t)plog::none, (std::min)((int32_t)plog::verbose, severity));
+
+    for (size_t i = 0; i < (size_t)LogCategory::COUNT; ++i) {
+      setLogCategory((LogCategory)i, (plog::Severity)severity, logCategorySampleEvery[i].load());
+    }
+
+    LOG_(LOGINSTANCE, plog::info) << "Changed logging severity to " << plog::severityToString((plog::Severity)severity);
+  }
+
+  return env.Undefined();
+}
+
+/**
+ * Change severity and sampling of a single log category at runtime.
+ */
+Napi::Value napi_SetNativeAddonLogCategory(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+
+  const bool hasSampling = info.Length() == 3;
+  if (hasSampling ? util::verifyArguments(__func__, info, { util::STRING, util::NUMBER, util::NUMBER })
+                  : util::verifyArguments(__func__, info, { util::STRING, util::NUMBER })) {
+    const std::string categoryName = info[0].As<Napi::String>();
+    LogCategory category;
+    if (!logCategoryFromString(categoryName, category)) {
+      Napi::TypeError::New(env, "Unknown log category " + categoryName).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+
+    int32_t severity = info[1].As<Napi::Number>().Int32Value();
+    severity = (std::max)((int32_t)plog::none, (std::min)((int32_t)plog::verbose, severity));
+    const uint32_t sampleEvery = hasSampling ? (std::max)(info[2].As<Napi::Number>().Uint32Value(), 1u) : logCategorySampleEvery[(size_t)category].load();
+
+    setLogCategory(category, (plog::Severity)severity, sampleEvery);
+
+    LOG_(LOGINSTANCE, plog::info) << "Changed " << categoryName << " logging severity to " << plog::severityToString((plog::Severity)severity) << " sampling 1/" << sampleEvery;
+  }
+
+  return env.Undefined();
+}
@@ -3,6 +3,9 @@
 #include <plog/Log.h>
 #include <napi.h>
 
+#include <atomic>
+#include <cstdint>
+
 /**
  * The unique plog logging instance that we are using in this module. This
  * should be unique across npm modules that also use plog in it's single
@@ -12,11 +15,81 @@
  */
 const unsigned int LOGINSTANCE = 9; // Any unused, non-zero value should do.
 
+/**
+ * Log categories with independent severities (and sampling of hot path messages). Plain
+ * LOG_*_(LOGINSTANCE) logging belongs to the app category. Exported napi functions are assigned
+ * a category in init.cc, which the napi helpers use when logging on behalf of that function.
+ */
+enum class LogCategory : uint8_t {
+  app,
+  device,
+  settings,
+  fwu,
+  bt,
+  dect,
+  callbacks,
+  COUNT
+};
+
+/** Current max severity per category - read with logCategoryEnabled. */
+extern std::atomic<int> logCategorySeverities[(size_t)LogCategory::COUNT];
+
+/** Log 1 of every N sampled messages per category (1 logs all). */
+extern std::atomic<uint32_t> logCategorySampleEvery[(size_t)LogCategory::COUNT];
+extern std::atomic<uint32_t> logCategorySampleCounters[(size_t)LogCategory::COUNT];
+
+inline bool logCategoryEnabled(LogCategory category, plog::Severity severity) {
+  return severity <= logCategorySeverities[(size_t)category].load(std::memory_order_relaxed);
+}
+
+inline bool logCategorySample(LogCategory category) {
+  const uint32_t every = logCategorySampleEvery[(size_t)category].load(std::memory_order_relaxed);
+  return every <= 1 || logCategorySampleCounters[(size_t)category].fetch_add(1, std::memory_order_relaxed) % every == 0;
+}
+
+/**
+ * Register the category of an exported napi function (by its __func__ name). Only has effect
+ * until freezeLogCategories is called.
+ */
+void registerLogCategory(const char * functionName, LogCategory category);
+void freezeLogCategories();
+
+/**
+ * Category of a registered napi function - app for anything else.
+ */
+LogCategory logCategoryOf(const char * functionName);
+
+/**
+ * Category logging - same as LOG_(LOGINSTANCE, severity) but filtered by the category severity.
+ */
+#define IF_LOG_CAT_(category, severity) if (!plog::get<LOGINSTANCE>() || !logCategoryEnabled(category, severity)) {;} else
+#define LOG_CAT_(category, severity) IF_LOG_CAT_(category, severity) (*plog::get<LOGINSTANCE>()) += plog::Record(severity, PLOG_GET_FUNC(), __LINE__, PLOG_GET_FILE(), PLOG_GET_THIS())
+
+#define LOG_VERBOSE_CAT_(category) LOG_CAT_(category, plog::verbose)
+#define LOG_DEBUG_CAT_(category) LOG_CAT_(category, plog::debug)
+#define LOG_INFO_CAT_(category) LOG_CAT_(category, plog::info)
+#define LOG_WARNING_CAT_(category) LOG_CAT_(category, plog::warning)
+#define LOG_ERROR_CAT_(category) LOG_CAT_(category, plog::error)
+#define LOG_FATAL_CAT_(category) LOG_CAT_(category, plog::fatal)
+
+/**
+ * Category logging for hot path messages, which are additionally sampled.
+ */
+#define LOG_SAMPLED_CAT_(category, severity) IF_LOG_CAT_(category, severity) if (!logCategorySample(category)) {;} else (*plog::get<LOGINSTANCE>()) += plog::Record(severity, PLOG_GET_FUNC(), __LINE__, PLOG_GET_FILE(), PLOG_GET_THIS())
+
 /**
  * Helper method for configuring logging with plog (https://github.com/SergiusTheBest/plog)
  * based on same environment settings as Jabra SDK (LIBJABRA_RESOURCE_PATH, LIBJABRA_TRACE_LEVEL etc).
+ * The background log writer is stopped when the environment is torn down.
  */
-void configureLogging();
+void configureLogging(Napi::Env env);
+
+/**
+ * Write everything logged so far and stop the background log writer. Until resumeAsyncLogging is
+ * called, records are written on the thread logging them. Must be called on the javascript main thread.
+ */
+void stopAsyncLogging();
+void resumeAsyncLogging();
 
 /**
 * Get path of log file.
@@ -40,3 +113,21 @@ Napi::Value napi_NativeAddonLog(const Napi::CallbackInfo& info);
  */
 Napi::Value napi_GetNativeAddonLogConfig(const Napi::CallbackInfo& info);
 
+/**
+ * Expose method to change the native log severity at runtime from node.
+ */
+Napi::Value napi_SetNativeAddonLogSeverity(const Napi::CallbackInfo& info);
+
+/**
+ * Expose method to change the severity and sampling of a log category at runtime from node.
+ */
+Napi::Value napi_SetNativeAddonLogCategory(const Napi::CallbackInfo& info);
+
+/**
+ * Create the severity gate exported to node as NativeAddonLogSeverityGate - a one element
+ * Int32Array that always holds the current max severity of the app category (where javascript
+ * log entries go), so javascript can filter log entries without calling into native code. Call
+ * once from module Init after configureLogging.
+ */
+Napi::Int32Array createNativeAddonLogSeverityGate(Napi::Env env);
+
@@ -1,5 +1,5 @@
 import { SdkIntegration } from "./sdkintegration";
-import { AddonLogSeverity, NativeAddonLogConfig } from "./core-types";
+import { AddonLogSeverity, NativeAddonLogCategory, NativeAddonLogConfig } from "./core-types";
 import { isNodeJs } from './util';
 
 /** @internal */
@@ -28,8 +28,8 @@ if (isNodeJs()) {
  */
 export function _JabraNativeAddonLog(severity: AddonLogSeverity, caller: string, msg: string | Error | (() => string), ...args: (string | object | boolean | number | Array<any> | (() => string))[]): void {
     try {
-      const config = _JabraGetNativeAddonLogConfig();
-      const maxSeverity = config ? config.maxSeverity : AddonLogSeverity.verbose;
+      // Shared with native code, so always holds the current severity without a native call.
+      const maxSeverity = sdkIntegration.NativeAddonLogSeverityGate[0];
       if (severity <= maxSeverity) {
         let totalMessage = mapLogValue(msg);
         if (args.length > 0 ) {
@@ -93,3 +93,43 @@ export function _JabraGetNativeAddonLogConfig() : NativeAddonLogConfig | undefin
         }
     }
 }
+
+/**
+ * Change the max severity of the native Jabra SDK log at runtime. Takes effect immediately for
+ * both native and javascript logging.
+ *
+ * Nb. The method is does not throw exceptions even on failure. So it ought to be safe to call in any context.
+ *
+ * @hidden
+ */
+export function _JabraSetNativeAddonLogSeverity(severity: AddonLogSeverity): void {
+    try {
+        sdkIntegration.SetNativeAddonLogSeverity(severity);
+        cachedLogConfig = undefined;
+    } catch (e) { // Make sure any exceptions does not propagate.
+        // If the console is up, show internal error:
+        console.error("Could not change log severity. Got error " + e);
+    }
+}
+
+/**
+ * Change the max severity and optionally the sampling (log 1 of every sampleEvery high frequency
+ * messages) of a single native log category at runtime.
+ *
+ * Nb. The method is does not throw exceptions even on failure. So it ought to be safe to call in any context.
+ *
+ * @hidden
+ */
+export function _JabraSetNativeAddonLogCategory(category: NativeAddonLogCategory, severity: AddonLogSeverity, sampleEvery?: number): void {
+    try {
+        if (sampleEvery === undefined) {
+            sdkIntegration.SetNativeAddonLogCategory(category, severity);
+        } else {
+            sdkIntegration.SetNativeAddonLogCategory(category, severity, sampleEvery);
+        }
+        cachedLogConfig = undefined;
+    } catch (e) { // Make sure any exceptions does not propagate.
+        // If the console is up, show internal error:
+        console.error("Could not change log category " + category + ". Got error " + e);
+    }
+}
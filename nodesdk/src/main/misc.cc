@@ -1,45 +1,35 @@
 #include "misc.h"
 
-// https://www.linuxquestions.org/questions/programming-9/c-bin-array-to-hex-string-and-back-4175560352/
-std::string ToHex(const char* buffer, size_t size){
-	std::stringstream str;
-	str.setf(std::ios_base::hex, std::ios::basefield);
-	str.setf(std::ios_base::uppercase);
-	str.fill('0');
-	for(size_t i=0; i<size; ++i){
-		str << std::setw(2) << (unsigned short)(unsigned char)buffer[i];
-	}
-	return str.str();
-}
+static const size_t PANIC_CODE_SIZE = sizeof(Jabra_PanicListDevType::panicCode);
 
 Napi::Value napi_GetPanics(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
-  return util::SimpleDeviceAsyncFunction<Napi::Array, std::vector<std::string>>(functionName, info, 
+  return util::SimpleDeviceAsyncFunction<Napi::Array, std::vector<uint8_t>>(functionName, info, 
     [functionName](unsigned short deviceId) {
-      std::vector<std::string> v = { };
+      // Raw panic codes back to back - hex formatting (if any) is done in javascript.
+      std::vector<uint8_t> v;
       Jabra_PanicListType *panics;
       panics = Jabra_GetPanics(deviceId);
       if (panics != NULL)
       {
+        v.resize(panics->entriesNo * PANIC_CODE_SIZE);
         for (unsigned int i = 0; i < panics->entriesNo; i++)
         {
-          uint8_t *panicCode;
-          panicCode = panics->panicList[i].panicCode;
-          std::string hexstring = ToHex((char*)panicCode, 25); // To replace magic number with sizeof.
-          v.push_back(hexstring);
+          memcpy(&v[i * PANIC_CODE_SIZE], panics->panicList[i].panicCode, PANIC_CODE_SIZE);
         }
         Jabra_FreePanicListType(panics);
       }
       return v;
     }, 
-    [](const Napi::Env& env, const std::vector<std::string> cppResult) { 
-        Napi::Array arr = Napi::Array::New(env);
-        uint32_t i = 0;
-        for(auto const& item: cppResult) {
-          Napi::String s = Napi::String::New(env, item);
-          arr[i++] = s;
+    [](const Napi::Env& env, const std::vector<uint8_t>& cppResult) { 
+        // One buffer for all panic codes with a Uint8Array view per code.
+        const size_t count = cppResult.size() / PANIC_CODE_SIZE;
+        Napi::Uint8Array all = util::newUint8Array(env, cppResult.data(), cppResult.size());
+        Napi::Array arr = Napi::Array::New(env, count);
+        for (size_t i = 0; i < count; ++i) {
+          arr[(uint32_t)i] = Napi::Uint8Array::New(env, PANIC_CODE_SIZE, all.ArrayBuffer(), i * PANIC_CODE_SIZE);
         }
         return arr;
       }
   );
-}
\ No newline at end of file
+}
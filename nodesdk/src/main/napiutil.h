@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <memory>
+#include <string.h>
 #include <thread>
 #include <vector>
 
@@ -14,14 +15,17 @@
 
 // Own stuff:
 #include "logger.h"
+#include "executor.h"
+#include "perfstats.h"
 
 // -----------------------------------------Helper Macros ------------------------------------------------
 
 /**
  * Helper macro that make sure a native function starting with "napi_" prefix is visiable in node
- * without the "napi_" prefix. Call this in module initialization.
+ * without the "napi_" prefix. Call this in module initialization. The function is assigned the
+ * log category in the local variable exportsLogCategory.
  */
-#define EXPORTS_SET(name) exports.Set(Napi::String::New(env, #name), Napi::Function::New(env, napi_##name));
+#define EXPORTS_SET(name) exports.Set(Napi::String::New(env, #name), Napi::Function::New(env, napi_##name)); registerLogCategory("napi_" #name, exportsLogCategory);
 
 // ----------------------------------------- Util --------------------------------------------------------
 
@@ -72,6 +76,21 @@ const T getObjEnumValueOrDefault(Napi::Object& obj, const char * name, const T d
     }
 }
 
+/**
+ * Create a Uint8Array holding a copy of raw bytes using a single memcpy. Binary payloads are
+ * passed to javascript as is - any hex formatting is left to javascript (see toHexString).
+ *
+ * Nb. External (non-copying) ArrayBuffers are not used as Electron does not allow them when
+ * the V8 memory cage is enabled, and the payloads here are small.
+ */
+inline Napi::Uint8Array newUint8Array(const Napi::Env& env, const void * data, size_t length) {
+    Napi::Uint8Array result = Napi::Uint8Array::New(env, length);
+    if (length > 0) {
+        memcpy(result.Data(), data, length);
+    }
+    return result;
+}
+
 /**
  * Should be thrown by api work functions when a jabra function fails with a specific error code.
  * 
@@ -101,7 +120,7 @@ class JabraReturnCodeException : public std::runtime_error
     }
     
     static void LogAndThrow(const char * callerFunctionName, const Jabra_ReturnCode jabraApiReturnCode) {
-        LOG_ERROR_(LOGINSTANCE) << generateString(callerFunctionName, jabraApiReturnCode);
+        LOG_ERROR_CAT_(logCategoryOf(callerFunctionName)) << generateString(callerFunctionName, jabraApiReturnCode);
         throw JabraReturnCodeException(callerFunctionName, jabraApiReturnCode);
     }
 };
@@ -139,7 +158,7 @@ class JabraException : public std::runtime_error
     }
     
     static void LogAndThrow(const char * callerFunctionName, const std::string& reason = "") {
-        LOG_ERROR_(LOGINSTANCE) << generateString(callerFunctionName, reason);
+        LOG_ERROR_CAT_(logCategoryOf(callerFunctionName)) << generateString(callerFunctionName, reason);
         throw JabraException(callerFunctionName, reason);
     }
 };
@@ -185,6 +204,9 @@ bool verifyArguments(const char * const callerFunctionName, const Napi::Callback
  * The sole exception where this worker should NOT be used, is for handling Jabra c-callbacks
  * in init and eventhandlers!
  * 
+ * Workers should be queued with util::QueueOnDevice (or util::QueueOnExecutor when no device
+ * is involved) rather than Queue(), so slow Jabra calls do not occupy the shared libuv threadpool.
+ * 
  * Nb. Based on Napi::AsyncWorker that self-destorys (no explicit delete required)
  */
 template <typename JabraWorkReturnType, typename NapiReturnType>
@@ -194,6 +216,9 @@ class JAsyncWorker : public Napi::AsyncWorker
     Jabra_ReturnCode errorCode;
     JabraWorkReturnType jabraResult;
     const char * const callerFunctionName;
+    const LogCategory logCategory;
+    const bool logCall; // Per call messages are sampled as a whole.
+    const PerfClock::time_point createdAt; // Workers are queued right after construction.
     const std::function<JabraWorkReturnType()> jabraWorkFunc;
     const std::function<NapiReturnType(const Napi::Env& env, const JabraWorkReturnType& jabraData)> jabraToNapiMapperFunc;
     const std::function<void(JabraWorkReturnType& jabraData)> jabraCleanupFunc;
@@ -213,25 +238,25 @@ class JAsyncWorker : public Napi::AsyncWorker
                  const std::function<JabraWorkReturnType()>& jabraWorkFunc,
                  const std::function<NapiReturnType(const Napi::Env& env, const JabraWorkReturnType& jabraData)>& jabraToNapiMapperFunc,
                  const std::function<void(JabraWorkReturnType& jabraData)>& jabraCleanupFunc = [](JabraWorkReturnType& jabraData) {}
-                ) : Napi::AsyncWorker(javascriptResultCallback), errorCode(Jabra_ReturnCode::Return_Ok), jabraResult(), callerFunctionName(callerFunctionName), jabraWorkFunc(jabraWorkFunc), jabraToNapiMapperFunc(jabraToNapiMapperFunc), jabraCleanupFunc(jabraCleanupFunc) {}
+                ) : Napi::AsyncWorker(javascriptResultCallback), errorCode(Jabra_ReturnCode::Return_Ok), jabraResult(), callerFunctionName(callerFunctionName), logCategory(logCategoryOf(callerFunctionName)), logCall(logCategoryEnabled(logCategory, plog::debug) && logCategorySample(logCategory)), createdAt(PerfClock::now()), jabraWorkFunc(jabraWorkFunc), jabraToNapiMapperFunc(jabraToNapiMapperFunc), jabraCleanupFunc(jabraCleanupFunc) {}
     JAsyncWorker(const JAsyncWorker&) = delete;
     ~JAsyncWorker() {}
 
     void okError(const Napi::Env& env, const std::string& errorMsg, bool duringJsCallback) {
-        LOG_ERROR_(LOGINSTANCE) << errorMsg;
+        LOG_ERROR_CAT_(logCategory) << errorMsg;
         try {
             if (!duringJsCallback) {
                 Callback().Call({ Napi::String::New(env, errorMsg), env.Undefined() });
             }
         } catch (const std::exception &e) {
-            LOG_ERROR_(LOGINSTANCE) << "Failed calling error callback with details " + std::string(e.what());
+            LOG_ERROR_CAT_(logCategory) << "Failed calling error callback with details " + std::string(e.what());
         } catch (...) {
-            LOG_ERROR_(LOGINSTANCE) << "Failed calling error callback";
+            LOG_ERROR_CAT_(logCategory) << "Failed calling error callback";
         }
     }
 
     void executeError(const std::string& errorMsg, const Jabra_ReturnCode _errorCode = Jabra_ReturnCode::Return_Ok) {
-        LOG_ERROR_(LOGINSTANCE) << errorMsg;
+        LOG_ERROR_CAT_(logCategory) << errorMsg;
         SetError(errorMsg);
         errorCode = _errorCode;
     }
@@ -242,11 +267,14 @@ class JAsyncWorker : public Napi::AsyncWorker
     // should go on `this`.
     void Execute()
     {
+        recordPerf(callerFunctionName, PerfPhase::queue, PerfClock::now() - createdAt);
+        ScopedPerfTimer timer(callerFunctionName, PerfPhase::execute);
+
         try
         {
-            LOG_DEBUG_(LOGINSTANCE) << "JAsyncWorker: " << callerFunctionName << " started async function call";
+            if (logCall) { LOG_DEBUG_CAT_(logCategory) << "JAsyncWorker: " << callerFunctionName << " started async function call"; }
             jabraResult = jabraWorkFunc();
-            LOG_VERBOSE_(LOGINSTANCE) << "JAsyncWorker: " << callerFunctionName << " finished async function call";      
+            if (logCall) { LOG_VERBOSE_CAT_(logCategory) << "JAsyncWorker: " << callerFunctionName << " finished async function call"; }
         }
         catch (const JabraReturnCodeException &e)
         {
@@ -272,13 +300,13 @@ class JAsyncWorker : public Napi::AsyncWorker
 
     void cleanup() {
         try {
-            LOG_VERBOSE_(LOGINSTANCE) << "JAsyncWorker: " << callerFunctionName << " started cleanup.";
+            if (logCall) { LOG_VERBOSE_CAT_(logCategory) << "JAsyncWorker: " << callerFunctionName << " started cleanup."; }
             jabraCleanupFunc(jabraResult);
-            LOG_VERBOSE_(LOGINSTANCE) << "JAsyncWorker: " << callerFunctionName << " completed (and finished cleanup).";
+            if (logCall) { LOG_VERBOSE_CAT_(logCategory) << "JAsyncWorker: " << callerFunctionName << " completed (and finished cleanup)."; }
         } catch (const std::exception &e) {
-            LOG_ERROR_(LOGINSTANCE) << "JAsyncWorker cleanup failure with details " + std::string(e.what());
+            LOG_ERROR_CAT_(logCategory) << "JAsyncWorker cleanup failure with details " + std::string(e.what());
         } catch (...) {
-            LOG_ERROR_(LOGINSTANCE) << "JAsyncWorker cleanup failure";
+            LOG_ERROR_CAT_(logCategory) << "JAsyncWorker cleanup failure";
         }
     }
 
@@ -293,11 +321,15 @@ class JAsyncWorker : public Napi::AsyncWorker
         bool callBackError = false;
 
         try {
-            LOG_VERBOSE_(LOGINSTANCE) << "JAsyncWorker: " << callerFunctionName << " started mapping.";
-            napiResult = jabraToNapiMapperFunc(env, jabraResult);
-            LOG_VERBOSE_(LOGINSTANCE) << "JAsyncWorker: " << callerFunctionName << " finished mapping.";            
+            if (logCall) { LOG_VERBOSE_CAT_(logCategory) << "JAsyncWorker: " << callerFunctionName << " started mapping."; }
+            {
+                ScopedPerfTimer timer(callerFunctionName, PerfPhase::mapping);
+                napiResult = jabraToNapiMapperFunc(env, jabraResult);
+            }
+            if (logCall) { LOG_VERBOSE_CAT_(logCategory) << "JAsyncWorker: " << callerFunctionName << " finished mapping."; }
             
             callBackError = true;
+            ScopedPerfTimer timer(callerFunctionName, PerfPhase::callback);
             // TODO: Should Receiver().Value() be passed as first arg ?
             Callback().Call({ env.Undefined(), napiResult });
             callBackError = false;
@@ -340,11 +372,12 @@ class JAsyncWorker : public Napi::AsyncWorker
                 mutableError.Set(Napi::String::New(env, "code"), (Napi::Number::New(env, (int)errorCode)));
             }
 
+            ScopedPerfTimer timer(callerFunctionName, PerfPhase::callback);
             Callback().Call(Receiver().Value(), std::initializer_list<napi_value>{ mutableError.Value() });
         } catch (const std::exception &e) {
-            LOG_ERROR_(LOGINSTANCE) << "Failed calling error callback with details " + std::string(e.what());
+            LOG_ERROR_CAT_(logCategory) << "Failed calling error callback with details " + std::string(e.what());
         } catch (...) {
-            LOG_ERROR_(LOGINSTANCE) << "Failed calling error callback";
+            LOG_ERROR_CAT_(logCategory) << "Failed calling error callback";
         }
 
         cleanup();
@@ -367,6 +400,9 @@ class JAsyncWorker<void,void> : public Napi::AsyncWorker
 
     Jabra_ReturnCode errorCode;
     const char * const callerFunctionName;
+    const LogCategory logCategory;
+    const bool logCall; // Per call messages are sampled as a whole.
+    const PerfClock::time_point createdAt; // Workers are queued right after construction.
     const std::function<void()> jabraWorkFunc;
     const std::function<void()> jabraCleanupFunc;
 
@@ -382,12 +418,12 @@ class JAsyncWorker<void,void> : public Napi::AsyncWorker
                  const Napi::Function &javascriptResultCallback, 
                  const std::function<void()>& jabraWorkFunc,
                  const std::function<void()>& jabraCleanupFunc = [](){}
-                ) : Napi::AsyncWorker(javascriptResultCallback), errorCode(Jabra_ReturnCode::Return_Ok), callerFunctionName(callerFunctionName), jabraWorkFunc(jabraWorkFunc), jabraCleanupFunc(jabraCleanupFunc) {}
+                ) : Napi::AsyncWorker(javascriptResultCallback), errorCode(Jabra_ReturnCode::Return_Ok), callerFunctionName(callerFunctionName), logCategory(logCategoryOf(callerFunctionName)), logCall(logCategoryEnabled(logCategory, plog::debug) && logCategorySample(logCategory)), createdAt(PerfClock::now()), jabraWorkFunc(jabraWorkFunc), jabraCleanupFunc(jabraCleanupFunc) {}
     JAsyncWorker(const JAsyncWorker&) = delete;
     ~JAsyncWorker() {}
 
     void executeError(const std::string& errorMsg, const Jabra_ReturnCode _errorCode = Jabra_ReturnCode::Return_Ok) {
-        LOG_ERROR_(LOGINSTANCE) << errorMsg;
+        LOG_ERROR_CAT_(logCategory) << errorMsg;
         SetError(errorMsg);
         errorCode = _errorCode;
     }
@@ -398,11 +434,14 @@ class JAsyncWorker<void,void> : public Napi::AsyncWorker
     // should go on `this`.
     void Execute()
     {
+        recordPerf(callerFunctionName, PerfPhase::queue, PerfClock::now() - createdAt);
+        ScopedPerfTimer timer(callerFunctionName, PerfPhase::execute);
+
         try
         {
-            LOG_DEBUG_(LOGINSTANCE) << callerFunctionName << " started async prodcedure call";
+            if (logCall) { LOG_DEBUG_CAT_(logCategory) << callerFunctionName << " started async prodcedure call"; }
             jabraWorkFunc();
-            LOG_VERBOSE_(LOGINSTANCE) << callerFunctionName << " finished async procedure call";
+            if (logCall) { LOG_VERBOSE_CAT_(logCategory) << callerFunctionName << " finished async procedure call"; }
         }
         catch (const JabraReturnCodeException &e)
         {
@@ -428,13 +467,13 @@ class JAsyncWorker<void,void> : public Napi::AsyncWorker
 
     void cleanup() {
         try {
-            LOG_VERBOSE_(LOGINSTANCE) << "JAsyncWorker: " << callerFunctionName << " started cleanup.";
+            if (logCall) { LOG_VERBOSE_CAT_(logCategory) << "JAsyncWorker: " << callerFunctionName << " started cleanup."; }
             jabraCleanupFunc();
-            LOG_VERBOSE_(LOGINSTANCE) << "JAsyncWorker: " << callerFunctionName << " completed (and finished cleanup).";
+            if (logCall) { LOG_VERBOSE_CAT_(logCategory) << "JAsyncWorker: " << callerFunctionName << " completed (and finished cleanup)."; }
         } catch (const std::exception &e) {
-            LOG_ERROR_(LOGINSTANCE) << "JAsyncWorker cleanup failure with details " + std::string(e.what());
+            LOG_ERROR_CAT_(logCategory) << "JAsyncWorker cleanup failure with details " + std::string(e.what());
         } catch (...) {
-            LOG_ERROR_(LOGINSTANCE) << "JAsyncWorker cleanup failure";
+            LOG_ERROR_CAT_(logCategory) << "JAsyncWorker cleanup failure";
         }
     }
 
@@ -447,11 +486,12 @@ class JAsyncWorker<void,void> : public Napi::AsyncWorker
         Napi::HandleScope scope(env);
 
         try {
+            ScopedPerfTimer timer(callerFunctionName, PerfPhase::callback);
             Callback().Call({ env.Undefined(), env.Undefined() });
         } catch (const std::exception &e) {
-            LOG_ERROR_(LOGINSTANCE) << "JAsyncWorker ok callback failure with details " + std::string(e.what());
+            LOG_ERROR_CAT_(logCategory) << "JAsyncWorker ok callback failure with details " + std::string(e.what());
         } catch (...) {
-            LOG_ERROR_(LOGINSTANCE) << "JAsyncWorker ok callback failure";
+            LOG_ERROR_CAT_(logCategory) << "JAsyncWorker ok callback failure";
         }
 
         cleanup();
@@ -471,11 +511,12 @@ class JAsyncWorker<void,void> : public Napi::AsyncWorker
                 mutableError.Set(Napi::String::New(env, "code"), (Napi::Number::New(env, (int)errorCode)));
             }
 
+            ScopedPerfTimer timer(callerFunctionName, PerfPhase::callback);
             Callback().Call(Receiver().Value(), std::initializer_list<napi_value>{ mutableError.Value() });
         } catch (const std::exception &e) {
-            LOG_ERROR_(LOGINSTANCE) << "JAsyncWorker error callback failure with details " + std::string(e.what());
+            LOG_ERROR_CAT_(logCategory) << "JAsyncWorker error callback failure with details " + std::string(e.what());
         } catch (...) {
-            LOG_ERROR_(LOGINSTANCE) << "JAsyncWorker error callback failure";
+            LOG_ERROR_CAT_(logCategory) << "JAsyncWorker error callback failure";
         }
 
         cleanup();
@@ -515,7 +556,7 @@ Napi::Value SimpleAsyncFunction(const char * const callerFunctionName,
                jabraCleanupFunc
               );
 
-        worker->Queue();
+        util::QueueOnExecutor(worker);
     }
 
     return env.Undefined();
@@ -556,7 +597,7 @@ Napi::Value SimpleDeviceAsyncFunction(const char * const callerFunctionName,
                jabraCleanupFunc
               );
 
-        worker->Queue();
+        util::QueueOnDevice(deviceId, worker);
     }
 
     return env.Undefined();
@@ -593,7 +634,7 @@ inline Napi::Value SimpleDeviceAsyncBoolSetter(const char * const callerFunction
                jabraCleanupFunc
               );
 
-        worker->Queue();
+        util::QueueOnDevice(deviceId, worker);
     }
 
     return env.Undefined();
@@ -612,23 +653,28 @@ inline Napi::Value SimpleDeviceAsyncBoolSetter(const char * const callerFunction
  */
 template <typename T> 
 T JSyncWrapper(const char * const callerFunctionName, const Napi::CallbackInfo& info, const std::function<T (const char * const callerFunctionName, const Napi::CallbackInfo&)> func) {
+    const LogCategory logCategory = logCategoryOf(callerFunctionName);
+    const bool logCall = logCategoryEnabled(logCategory, plog::debug) && logCategorySample(logCategory);
+
+    ScopedPerfTimer timer(callerFunctionName, PerfPhase::execute);
+
     try
     {
-        LOG_DEBUG_(LOGINSTANCE) << "JSyncWrapper: " << callerFunctionName << " started sync function call.";
+        if (logCall) { LOG_DEBUG_CAT_(logCategory) << "JSyncWrapper: " << callerFunctionName << " started sync function call."; }
         auto result = func(callerFunctionName, info);
-        LOG_VERBOSE_(LOGINSTANCE) << "JSyncWrapper: " << callerFunctionName << " completed sync function call.";
+        if (logCall) { LOG_VERBOSE_CAT_(logCategory) << "JSyncWrapper: " << callerFunctionName << " completed sync function call."; }
 
         return result;
     }
     catch (const Napi::Error& e) {
         const std::string errorMsg = "JSyncWrapper execute failure: " + std::string(e.what());
-        LOG_ERROR_(LOGINSTANCE) << errorMsg;
+        LOG_ERROR_CAT_(logCategory) << errorMsg;
         throw; // Rethrow napi exceptions as they are handled.
     }
     catch (const JabraReturnCodeException &e)
     {
         const std::string errorMsg = "JSyncWrapper execute failure: " + std::string(e.what());
-        LOG_ERROR_(LOGINSTANCE) << errorMsg;
+        LOG_ERROR_CAT_(logCategory) << errorMsg;
 
         Napi::Env env = info.Env();
         Napi::Error error = Napi::Error::New(env, errorMsg);
@@ -643,19 +689,19 @@ T JSyncWrapper(const char * const callerFunctionName, const Napi::CallbackInfo&
     catch (const JabraException &e)
     {
         const std::string errorMsg = "JSyncWrapper execute failure: " + std::string(e.what());
-        LOG_ERROR_(LOGINSTANCE) << errorMsg;
+        LOG_ERROR_CAT_(logCategory) << errorMsg;
         Napi::Error::New(info.Env(), errorMsg).ThrowAsJavaScriptException();
     }
     catch (const std::exception &e)
     {
         const std::string errorMsg = "JSyncWrapper execute failure : " + std::string(callerFunctionName) + " -> " + e.what();
-        LOG_ERROR_(LOGINSTANCE) << errorMsg;
+        LOG_ERROR_CAT_(logCategory) << errorMsg;
         Napi::Error::New(info.Env(), errorMsg).ThrowAsJavaScriptException();
     }
     catch (...)
     {
         const std::string errorMsg = "JSyncWrapper execute failure : " + std::string(callerFunctionName) + " -> unknown error";
-        LOG_ERROR_(LOGINSTANCE) << errorMsg;
+        LOG_ERROR_CAT_(logCategory) << errorMsg;
         Napi::Error::New(info.Env(), errorMsg).ThrowAsJavaScriptException();
     }
 
@@ -0,0 +1,301 @@
+#include "stdafx.h"
+#include "perfstats.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+using util::PerfPhase;
+
+namespace {
+
+// Log-linear buckets: values below SUB_BUCKETS microseconds are exact, larger values share a
+// bucket with values within 1/SUB_BUCKETS of them. Values from 2^MAX_BITS us (~71 minutes) up
+// go into the last bucket.
+const unsigned int SUB_BUCKET_BITS = 4;
+const unsigned int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+const unsigned int MAX_BITS = 32;
+const unsigned int BUCKET_COUNT = (MAX_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+// Distinct functions recorded per thread - well above the number of exported functions.
+const size_t FUNCTION_SLOTS = 512;
+
+const char * const phaseNames[(size_t)PerfPhase::COUNT] = { "queue", "execute", "mapping", "callback" };
+
+unsigned int highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return 63 - __builtin_clzll(value);
+#else
+  unsigned int bit = 0;
+  while (value >> (bit + 1)) {
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+unsigned int bucketOf(uint64_t valueUs) {
+  if (valueUs < SUB_BUCKETS) {
+    return (unsigned int)valueUs;
+  }
+
+  const unsigned int bit = highestBit(valueUs);
+  if (bit >= MAX_BITS) {
+    return BUCKET_COUNT - 1;
+  }
+
+  const unsigned int shift = bit - SUB_BUCKET_BITS;
+  return (shift + 1) * SUB_BUCKETS + (unsigned int)(valueUs >> shift) - SUB_BUCKETS;
+}
+
+// Highest value that goes into the bucket.
+uint64_t bucketUpperBound(unsigned int bucket) {
+  if (bucket < SUB_BUCKETS) {
+    return bucket;
+  }
+
+  const unsigned int shift = bucket / SUB_BUCKETS - 1;
+  const uint64_t subBucket = bucket % SUB_BUCKETS + SUB_BUCKETS;
+  return ((subBucket + 1) << shift) - 1;
+}
+
+/**
+ * Histogram of one function and phase on one thread. Only the owning thread writes to it, so
+ * plain load/store pairs are enough. Readers on other threads may see a slightly inconsistent
+ * (but never torn) state while a value is being recorded.
+ */
+struct Histogram {
+  Histogram() : generation(0) {
+    clear();
+  }
+
+  void clear() {
+    for (std::atomic<uint32_t>& count : counts) {
+      count.store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    sumUs.store(0, std::memory_order_relaxed);
+    maxUs.store(0, std::memory_order_relaxed);
+  }
+
+  void record(uint64_t valueUs) {
+    std::atomic<uint32_t>& count = counts[bucketOf(valueUs)];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    total.store(total.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sumUs.store(sumUs.load(std::memory_order_relaxed) + valueUs, std::memory_order_relaxed);
+    if (valueUs > maxUs.load(std::memory_order_relaxed)) {
+      maxUs.store(valueUs, std::memory_order_relaxed);
+    }
+  }
+
+  // Reset generation the counters belong to - counters of older generations are ignored.
+  std::atomic<uint32_t> generation;
+  std::atomic<uint32_t> counts[BUCKET_COUNT];
+  std::atomic<uint64_t> total;
+  std::atomic<uint64_t> sumUs;
+  std::atomic<uint64_t> maxUs;
+};
+
+struct FunctionPerf {
+  explicit FunctionPerf(const char * name) : name(name) {
+    for (std::atomic<Histogram*>& phase : phases) {
+      phase.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  const char * const name;
+  std::atomic<Histogram*> phases[(size_t)PerfPhase::COUNT]; // Allocated on first use.
+};
+
+/**
+ * The histograms of one thread, indexed by function name pointer (open addressing, insert only).
+ */
+struct ThreadPerf {
+  ThreadPerf() {
+    for (std::atomic<FunctionPerf*>& slot : slots) {
+      slot.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  // Only called on the owning thread. Returns nullptr if the table is full.
+  FunctionPerf* find(const char * name) {
+    size_t index = (size_t)(((uint64_t)(uintptr_t)name * 0x9E3779B97F4A7C15ull) >> 32) % FUNCTION_SLOTS;
+    for (size_t probes = 0; probes < FUNCTION_SLOTS; ++probes, index = (index + 1) % FUNCTION_SLOTS) {
+      FunctionPerf* function = slots[index].load(std::memory_order_relaxed);
+      if (!function) {
+        function = new FunctionPerf(name);
+        slots[index].store(function, std::memory_order_release);
+        return function;
+      }
+      if (function->name == name) {
+        return function;
+      }
+    }
+    return nullptr;
+  }
+
+  std::atomic<FunctionPerf*> slots[FUNCTION_SLOTS];
+};
+
+class PerfRegistry
+{
+  public:
+    static PerfRegistry& instance() {
+      // Intentionally leaked like the per thread histograms: Executor threads are detached and
+      // may record after static destruction at process exit.
+      static PerfRegistry* registry = new PerfRegistry();
+      return *registry;
+    }
+
+    // Called once per thread - the ThreadPerf lives for the rest of the process.
+    ThreadPerf* addThread() {
+      ThreadPerf* thread = new ThreadPerf();
+      std::lock_guard<std::mutex> lock(mutex);
+      threads.push_back(thread);
+      return thread;
+    }
+
+    std::vector<ThreadPerf*> getThreads() {
+      std::lock_guard<std::mutex> lock(mutex);
+      return threads;
+    }
+
+    std::atomic<uint32_t> generation;
+
+  private:
+    PerfRegistry() : generation(1) {}
+
+    std::mutex mutex;
+    std::vector<ThreadPerf*> threads;
+};
+
+// Merge the histogram of one thread into the total of all threads.
+void addHistogram(util::LatencyHistogram& merged, const Histogram& histogram) {
+  for (unsigned int i = 0; i < BUCKET_COUNT; ++i) {
+    merged.counts[i] += histogram.counts[i].load(std::memory_order_relaxed);
+  }
+  merged.total += histogram.total.load(std::memory_order_relaxed);
+  merged.sum += histogram.sumUs.load(std::memory_order_relaxed);
+  merged.max = (std::max)(merged.max, histogram.maxUs.load(std::memory_order_relaxed));
+}
+
+} // namespace
+
+namespace util {
+
+void recordPerf(const char * functionName, PerfPhase phase, PerfClock::duration elapsed) {
+  static thread_local ThreadPerf* const thread = PerfRegistry::instance().addThread();
+
+  FunctionPerf* const function = thread->find(functionName);
+  if (!function) {
+    return;
+  }
+
+  std::atomic<Histogram*>& slot = function->phases[(size_t)phase];
+  Histogram* histogram = slot.load(std::memory_order_relaxed);
+  if (!histogram) {
+    histogram = new Histogram();
+    slot.store(histogram, std::memory_order_release);
+  }
+
+  const uint32_t generation = PerfRegistry::instance().generation.load(std::memory_order_relaxed);
+  if (histogram->generation.load(std::memory_order_relaxed) != generation) {
+    histogram->clear();
+    histogram->generation.store(generation, std::memory_order_release);
+  }
+
+  const int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  histogram->record(elapsedUs > 0 ? (uint64_t)elapsedUs : 0);
+}
+
+LatencyHistogram::LatencyHistogram() : counts(BUCKET_COUNT, 0), total(0), sum(0), max(0) {}
+
+void LatencyHistogram::record(uint64_t value) {
+  ++counts[bucketOf(value)];
+  ++total;
+  sum += value;
+  max = (std::max)(max, value);
+}
+
+void LatencyHistogram::clear() {
+  std::fill(counts.begin(), counts.end(), 0);
+  total = 0;
+  sum = 0;
+  max = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double fraction) const {
+  uint64_t counted = 0;
+  for (unsigned int i = 0; i < BUCKET_COUNT; ++i) {
+    counted += counts[i];
+    if (counted > 0 && counted >= fraction * total) {
+      return (std::min)(bucketUpperBound(i), max);
+    }
+  }
+  return max;
+}
+
+Napi::Object LatencyHistogram::toNapi(const Napi::Env& env, double unitsPerUs) const {
+  Napi::Object result = Napi::Object::New(env);
+  result.Set(Napi::String::New(env, "count"), Napi::Number::New(env, (double)total));
+  result.Set(Napi::String::New(env, "meanUs"), Napi::Number::New(env, total > 0 ? (double)sum / total / unitsPerUs : 0.0));
+  result.Set(Napi::String::New(env, "p50Us"), Napi::Number::New(env, percentile(0.5) / unitsPerUs));
+  result.Set(Napi::String::New(env, "p90Us"), Napi::Number::New(env, percentile(0.9) / unitsPerUs));
+  result.Set(Napi::String::New(env, "p99Us"), Napi::Number::New(env, percentile(0.99) / unitsPerUs));
+  result.Set(Napi::String::New(env, "maxUs"), Napi::Number::New(env, max / unitsPerUs));
+  return result;
+}
+
+} // namespace util
+
+Napi::Value napi_GetPerfStatsSync(const Napi::CallbackInfo& info) {
+  return util::JSyncWrapper<Napi::Value>(__func__, info, [](const char * const functionName, const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    PerfRegistry& registry = PerfRegistry::instance();
+    const uint32_t generation = registry.generation.load();
+
+    // Merge by name, as the same function may have been recorded on several threads.
+    std::map<std::string, std::array<util::LatencyHistogram, (size_t)PerfPhase::COUNT>> merged;
+    for (ThreadPerf* thread : registry.getThreads()) {
+      for (const std::atomic<FunctionPerf*>& slot : thread->slots) {
+        const FunctionPerf* function = slot.load(std::memory_order_acquire);
+        if (!function) {
+          continue;
+        }
+
+        for (size_t phase = 0; phase < (size_t)PerfPhase::COUNT; ++phase) {
+          const Histogram* histogram = function->phases[phase].load(std::memory_order_acquire);
+          if (histogram && histogram->generation.load(std::memory_order_acquire) == generation) {
+            addHistogram(merged[function->name][phase], *histogram);
+          }
+        }
+      }
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    for (const auto& entry : merged) {
+      Napi::Object phases = Napi::Object::New(env);
+      for (size_t phase = 0; phase < (size_t)PerfPhase::COUNT; ++phase) {
+        if (entry.second[phase].total > 0) {
+          phases.Set(Napi::String::New(env, phaseNames[phase]), entry.second[phase].toNapi(env));
+        }
+      }
+
+      // Report by exported (javascript) name.
+      const std::string& name = entry.first;
+      result.Set(Napi::String::New(env, name.compare(0, 5, "napi_") == 0 ? name.substr(5) : name), phases);
+    }
+
+    return result;
+  });
+}
+
+Napi::Value napi_ResetPerfStats(const Napi::CallbackInfo& info) {
+  return util::JSyncWrapper<Napi::Value>(__func__, info, [](const char * const functionName, const Napi::CallbackInfo& info) {
+    PerfRegistry::instance().generation++;
+    return info.Env().Undefined();
+  });
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <napi.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Latency histograms for the napi entry points, recorded by the napi helpers (JAsyncWorker and
+ * JSyncWrapper) per calling function and phase.
+ *
+ * Every thread records into its own histograms, so recording takes no locks and never contends
+ * with other threads. Histograms are log-linear (HDR style) with 16 sub-buckets per power of two,
+ * i.e. reported percentiles are within ~6% of the exact value.
+ */
+namespace util {
+
+using PerfClock = std::chrono::steady_clock;
+
+enum class PerfPhase : uint8_t {
+  queue,    // Waiting in the executor before Execute started.
+  execute,  // Running the Jabra SDK work (or the whole call for sync functions).
+  mapping,  // Converting the result to javascript values.
+  callback, // Running the javascript callback.
+  COUNT
+};
+
+/**
+ * Record the time spent in a phase of a call. functionName must be thread-invariant (generally
+ * __func__ of the napi function) - it is used as key without copying.
+ */
+void recordPerf(const char * functionName, PerfPhase phase, PerfClock::duration elapsed);
+
+/**
+ * Records the time until it goes out of scope (also when leaving by an exception).
+ */
+class ScopedPerfTimer
+{
+  public:
+    ScopedPerfTimer(const char * functionName, PerfPhase phase) : functionName(functionName), phase(phase), started(PerfClock::now()) {}
+    ~ScopedPerfTimer() {
+      recordPerf(functionName, phase, PerfClock::now() - started);
+    }
+
+    ScopedPerfTimer(const ScopedPerfTimer&) = delete;
+    ScopedPerfTimer& operator=(const ScopedPerfTimer&) = delete;
+
+  private:
+    const char * const functionName;
+    const PerfPhase phase;
+    const PerfClock::time_point started;
+};
+
+/**
+ * Single threaded histogram with the same bucket layout, for latencies recorded on one thread
+ * only. Values can be in any unit up to 2^32 (larger values count as 2^32 in the percentiles).
+ */
+struct LatencyHistogram {
+  LatencyHistogram();
+
+  void record(uint64_t value);
+  void clear();
+  uint64_t percentile(double fraction) const;
+
+  /**
+   * count, meanUs, p50Us, p90Us, p99Us and maxUs - values are divided by unitsPerUs.
+   */
+  Napi::Object toNapi(const Napi::Env& env, double unitsPerUs = 1.0) const;
+
+  std::vector<uint64_t> counts;
+  uint64_t total;
+  uint64_t sum;
+  uint64_t max;
+};
+
+} // namespace util
+
+/**
+ * Expose count, p50, p90, p99 and max latencies per napi function and phase to node.
+ */
+Napi::Value napi_GetPerfStatsSync(const Napi::CallbackInfo& info);
+
+/**
+ * Expose method to restart latency recording from node.
+ */
+Napi::Value napi_ResetPerfStats(const Napi::CallbackInfo& info);
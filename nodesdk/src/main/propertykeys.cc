@@ -0,0 +1,147 @@
+#include "stdafx.h"
+#include "propertykeys.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+#define PROPERTY_KEY_NAME(name) #name,
+
+const char * const propertyKeyNames[] = {
+  PROPERTY_KEYS(PROPERTY_KEY_NAME)
+};
+
+#undef PROPERTY_KEY_NAME
+
+static_assert(sizeof(propertyKeyNames) / sizeof(propertyKeyNames[0]) == (size_t)PropertyKey::COUNT, "Property key names out of sync");
+
+/**
+ * Persistent references to the array holding the cached strings of each environment
+ * (N-API v3 only allows references to objects, so the strings are kept in an array).
+ */
+std::unordered_map<napi_env, Napi::ObjectReference *> PropertyKeyHolders;
+std::mutex PropertyKeyHoldersMutex;
+
+// Last environment looked up on this thread - each environment only runs on one thread.
+thread_local napi_env lastEnv = nullptr;
+thread_local Napi::ObjectReference * lastHolder = nullptr;
+
+void freePropertyKeys(void * arg) {
+  napi_env env = static_cast<napi_env>(arg);
+
+  Napi::ObjectReference * holder = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(PropertyKeyHoldersMutex);
+    auto it = PropertyKeyHolders.find(env);
+    if (it != PropertyKeyHolders.end()) {
+      holder = it->second;
+      PropertyKeyHolders.erase(it);
+    }
+  }
+
+  if (lastEnv == env) {
+    lastEnv = nullptr;
+    lastHolder = nullptr;
+  }
+
+  delete holder;
+}
+
+Napi::ObjectReference * findPropertyKeys(napi_env env) {
+  if (lastEnv == env) {
+    return lastHolder;
+  }
+
+  std::lock_guard<std::mutex> lock(PropertyKeyHoldersMutex);
+  auto it = PropertyKeyHolders.find(env);
+  if (it == PropertyKeyHolders.end()) {
+    return nullptr;
+  }
+
+  lastEnv = env;
+  lastHolder = it->second;
+  return lastHolder;
+}
+
+} // namespace
+
+namespace util {
+
+void PropertyKeys::Init(Napi::Env env) {
+  if (findPropertyKeys(env) != nullptr) {
+    return;
+  }
+
+  Napi::Array strings = Napi::Array::New(env, (size_t)PropertyKey::COUNT);
+  for (size_t i = 0; i < (size_t)PropertyKey::COUNT; ++i) {
+    strings.Set((uint32_t)i, Napi::String::New(env, propertyKeyNames[i]));
+  }
+
+  Napi::ObjectReference * holder = new Napi::ObjectReference(Napi::Persistent(strings));
+  {
+    std::lock_guard<std::mutex> lock(PropertyKeyHoldersMutex);
+    PropertyKeyHolders[env] = holder;
+  }
+
+  napi_status status = napi_add_env_cleanup_hook(env, &freePropertyKeys, env);
+  if (status != napi_ok) {
+    LOG_ERROR_(LOGINSTANCE) << "PropertyKeys could not register cleanup hook: " << status;
+  }
+}
+
+PropertyKeys::PropertyKeys(Napi::Env env) : env(env) {
+  Napi::ObjectReference * holderRef = findPropertyKeys(env);
+  if (holderRef == nullptr) {
+    Init(env);
+    holderRef = findPropertyKeys(env);
+  }
+  holder = holderRef->Value();
+  values.fill(nullptr);
+}
+
+napi_value PropertyKeys::operator[](PropertyKey key) const {
+  napi_value& result = values[(size_t)key];
+  if (result == nullptr) {
+    napi_status status = napi_get_element(env, holder, (uint32_t)key, &result);
+    if (status != napi_ok) {
+      result = nullptr;
+      throw Napi::Error::New(env);
+    }
+  }
+  return result;
+}
+
+ObjectBuilder::ObjectBuilder(Napi::Env env, const PropertyKeys& keys) : keys(keys), object(Napi::Object::New(env)), count(0) {
+}
+
+ObjectBuilder& ObjectBuilder::set(PropertyKey key, napi_value value) {
+  if (count == MAX_PROPERTIES) {
+    flush();
+  }
+
+  napi_property_descriptor& descriptor = descriptors[count++];
+  descriptor = {};
+  descriptor.name = keys[key];
+  descriptor.value = value;
+  descriptor.attributes = static_cast<napi_property_attributes>(napi_writable | napi_enumerable | napi_configurable);
+
+  return *this;
+}
+
+Napi::Object ObjectBuilder::build() {
+  flush();
+  return object;
+}
+
+void ObjectBuilder::flush() {
+  if (count > 0) {
+    napi_status status = napi_define_properties(object.Env(), object, count, descriptors.data());
+    count = 0;
+    if (status != napi_ok) {
+      throw Napi::Error::New(object.Env());
+    }
+  }
+}
+
+} // namespace util
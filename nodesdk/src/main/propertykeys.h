@@ -0,0 +1,97 @@
+#pragma once
+
+#include <napi.h>
+
+#include <array>
+#include <cstdint>
+
+/**
+ * Property names used by the hot napi mappers (attach events, DECT info and button events,
+ * settings objects, device capabilities). Add new names here - the strings are created from the same list.
+ */
+#define PROPERTY_KEYS(X) \
+  X(deviceID) X(productID) X(vendorID) X(deviceName) X(usbDevicePath) X(parentInstanceId) \
+  X(errorStatus) X(isDongleDevice) X(dongleName) X(variant) X(ESN) X(isInFirmwareUpdateMode) \
+  X(connectionType) X(parentDeviceId) X(firmwareVersion) X(supportedFeatures) \
+  X(rawData) X(kind) X(density) X(errorCount) X(sumMeasuredRSSI) X(maximumReferenceRSSI) \
+  X(numberMeasuredSlots) X(dataAgeSeconds) X(syncErrors) X(aErrors) X(xErrors) X(zErrors) \
+  X(hubSyncErrors) X(hubAErrors) X(handoversCount) \
+  X(buttonTypeKey) X(buttonTypeValue) X(buttonEventType) X(key) X(value) \
+  X(guid) X(name) X(helpText) X(isValidationSupport) X(validationRule) X(minLength) X(maxLength) \
+  X(errorMessage) X(regExp) X(isDeviceRestart) X(isSettingProtected) X(isSettingProtectionEnabled) \
+  X(isWirelessConnect) X(cntrlType) X(settingDataType) X(currValue) X(groupName) X(groupHelpText) \
+  X(isDepedentsetting) X(isPCsetting) X(isChildDeviceSetting) X(dependentDefaultValue) X(listSize) \
+  X(listKeyValue) X(dependentcount) X(dependents) X(GUID) X(enableFlag) X(errStatus) X(settingInfo) \
+  X(mask) X(isRingerSupported) X(isOffHookSupported) X(isOnlineSupported) X(isMuteSupported) \
+  X(isHoldSupported) X(isBusyLightSupported) X(isEqualizerSupported) X(isSetDateTimeSupported) \
+  X(isGnHidStdHidSupported) X(isCertifiedForSkypeForBusiness) X(isPairingListSupported) \
+  X(isUploadImageSupported) X(isUploadRingtoneSupported) X(isFactoryResetSupported)
+
+#define PROPERTY_KEY_ENUM(name) name,
+
+enum class PropertyKey : uint16_t {
+  PROPERTY_KEYS(PROPERTY_KEY_ENUM)
+  COUNT
+};
+
+#undef PROPERTY_KEY_ENUM
+
+namespace util {
+
+/**
+ * Per environment cache of the property name strings. The strings are created once in Init and
+ * kept alive by a persistent reference until the environment is torn down, so mappers do not
+ * re-create (and re-hash) the same V8 strings for every object they build.
+ *
+ * Must only be used on the javascript thread of the environment.
+ */
+class PropertyKeys
+{
+  public:
+    /**
+     * Create the cached strings for an environment - call once from module Init.
+     */
+    static void Init(Napi::Env env);
+
+    explicit PropertyKeys(Napi::Env env);
+
+    napi_value operator[](PropertyKey key) const;
+
+  private:
+    napi_env env;
+    napi_value holder;
+
+    // Strings already fetched from holder by this instance - mappers building many objects
+    // (settings, pairing lists) use the same keys over and over.
+    mutable std::array<napi_value, (size_t)PropertyKey::COUNT> values;
+};
+
+/**
+ * Builds an object with its properties defined in a single napi_define_properties call (per 32
+ * properties) using the cached property names. Properties are writable, enumerable and
+ * configurable like properties set with Napi::Object::Set.
+ */
+class ObjectBuilder
+{
+  public:
+    ObjectBuilder(Napi::Env env, const PropertyKeys& keys);
+
+    ObjectBuilder& set(PropertyKey key, napi_value value);
+
+    /**
+     * Define the collected properties and return the object.
+     */
+    Napi::Object build();
+
+  private:
+    static const size_t MAX_PROPERTIES = 32;
+
+    void flush();
+
+    const PropertyKeys& keys;
+    Napi::Object object;
+    std::array<napi_property_descriptor, MAX_PROPERTIES> descriptors;
+    size_t count;
+};
+
+} // namespace util
@@ -8,7 +8,9 @@ import { BaseType } from 'typescript';
 import { ConfigParamsCloud, GenericConfigParams, enumHidState, AudioFileFormatEnum, DeviceSettings, DeviceInfo, PairedListInfo,
          NamedAsset, AddonLogSeverity, JabraError, RemoteMmiActionOutput, DectInfo, WhiteboardPosition, ZoomLimits, PanTilt,
          DateTime, VideoLimitsStepSize, PanTiltRelative, ZoomRelative, IPv4Status, FirmwareVersionBundleType, ProxySettings, libcurlError,
-         SensorRegionType, dongleConnectedHeadsetName, whichHeadsetNamesToRead, libcurlError, LanguagePackStats } from './core-types';
+         SensorRegionType, dongleConnectedHeadsetName, whichHeadsetNamesToRead, libcurlError, LanguagePackStats, ExecutorStats, EventChannelStats, PerfStats, DeviceSnapshot, CachedDeviceInfo, DeviceCapabilities,
+         SettingValues, SettingsDelta, SettingsSchema, SchemaSettingValues,
+         DeviceConstantTree, NativeAddonLogCategory, HeadDetectionStatus, LinkConnectionStatus, EventFilter } from './core-types';
 import { DeviceConstants } from './deviceconstants';
 import { enumDeviceBtnType, enumFirmwareEventType, enumFirmwareEventStatus,
          enumUploadEventStatus, enumBTPairedListType, enumRemoteMmiType,
@@ -57,6 +59,10 @@ export declare interface SdkIntegration {
                cameraStatusCallback: (deviceId: number, status: boolean) => void,
                bluetoothLinkQualityChangeCallback: (deviceId: number, linkQuality: enumBTLinkQuality) => void,
                networkStatusChangeCallback: (deviceId: number, PHY: enumNetworkInterface, status: enumNetworkInterfaceStatus) => void,
+               settingsChangedCallback: (deviceId: number, guids: string[]) => void,
+               headDetectionStatusCallback: (deviceId: number, status: HeadDetectionStatus) => void,
+               jackConnectorStatusCallback: (deviceId: number, inserted: boolean) => void,
+               linkConnectionStatusCallback: (deviceId: number, status: LinkConnectionStatus) => void,
                configParams: ConfigParamsCloud & GenericConfigParams) : void;
 
     /**
@@ -66,18 +72,20 @@ export declare interface SdkIntegration {
      * Nb. This method is blocking!!
      */
     UnInitialize(): boolean;
+
+    /**
+     * Get queue depth and per event delivered/dropped counters for the native event channel
+     * (internal utility, not directly Jabra SDK related). Returns null if not initialized.
+     */
+    GetEventChannelStatsSync(): EventChannelStats | null;
     
     /***
      * Add a message to native log file (internal utility, not directly Jabra SDK related).
      * 
      * Do not call this directly - use the optimized and more flexible js helper _JabraNativeAddonLog.
      * 
-     * This function is blocking(!) and is also not optimized for speed. Depending on OS, the logging code alone takes 
-     * from 8-70 ms to run excluding the n-api wrapping itself. 
-     * 
-     * Consequently, this function is not intended for general use, in loops or anywhere where 
-     * speed is critical. It is however fine to use this log infrequently, like in startup/closedown
-     * to mark bounderies, to log errors etc.
+     * Messages are queued for the background log writer (unless LIBJABRA_NODE_LOG_ASYNC=0, in which
+     * case this function blocks while the message is written to the log file).
      * 
     */
     NativeAddonLog(severity: AddonLogSeverity, caller: string, msg: string | Error): void;
@@ -90,6 +98,28 @@ export declare interface SdkIntegration {
      */
     GetNativeAddonLogConfig() : NativeAddonLogConfig;
 
+    /**
+     * Change the native log severity at runtime (internal utility, not directly Jabra SDK related).
+     *
+     * Do not call this directly - use the js helper _JabraSetNativeAddonLogSeverity.
+     */
+    SetNativeAddonLogSeverity(severity: AddonLogSeverity): void;
+
+    /**
+     * Change the severity and optionally the sampling of a single native log category at runtime
+     * (internal utility, not directly Jabra SDK related).
+     *
+     * Do not call this directly - use the js helper _JabraSetNativeAddonLogCategory.
+     */
+    SetNativeAddonLogCategory(category: NativeAddonLogCategory, severity: AddonLogSeverity, sampleEvery?: number): void;
+
+    /**
+     * Single element array holding the current native max log severity of the app category.
+     * Updated in place by SetNativeAddonLogSeverity and SetNativeAddonLogCategory, so it can be
+     * checked without calling native code.
+     */
+    readonly NativeAddonLogSeverityGate: Int32Array;
+
     /**
      * Template for calling experimental N-API code synchronously. For development use only for
      * experiments only. Otherwise not called.
@@ -137,6 +167,10 @@ export declare interface SdkIntegration {
     GetSettings(deviceId: number, callback: (error: JabraError, result: DeviceSettings) => void): void;
     GetSetting(deviceId: number, guid: string, callback: (error: JabraError, result: DeviceSettings) => void): void;
     SetSettings(deviceId: number, settings: DeviceSettings, callback: (error: JabraError, result: void) => void): void;
+    SetSettingValues(deviceId: number, values: SettingValues, callback: (error: JabraError, result: void) => void): void;
+    GetSettingsDelta(deviceId: number, sinceVersion: number, callback: (error: JabraError, result: SettingsDelta) => void): void;
+    GetSettingsSchema(deviceId: number, callback: (error: JabraError, result: SettingsSchema) => void): void;
+    GetSettingValues(deviceId: number, callback: (error: JabraError, result: SchemaSettingValues) => void): void;
     
     FactoryReset(deviceId: number, callback: (error: JabraError, result: void) => void): void;
     IsFactoryResetSupported(deviceId: number, callback: (error: JabraError, result: boolean) => void): void;
@@ -166,7 +200,7 @@ export declare interface SdkIntegration {
 
     GetNamedAsset(deviceId: number, filename: assetName, callback: (error: JabraError, result: NamedAsset) => void): void;
 
-    GetPanics(deviceId: number, callback: (error: JabraError, result: string[]) => void): void;
+    GetPanics(deviceId: number, callback: (error: JabraError, result: Uint8Array[]) => void): void;
 
     DownloadFirmware(deviceId: number, version: string, authorization?: string, callback: (error: JabraError, result: void) => void): void;
     UpdateFirmware(deviceId: number, firmFile: string, callback: (error: JabraError, result: void) => void): void;
@@ -238,6 +272,9 @@ export declare interface SdkIntegration {
     GetDatetime(deviceId: number, callback: (error: JabraError, result: DateTime) => void): void;
     GetEqualizerParameters(deviceId: number, maxNBands:number, callback: (error: JabraError, result: Array<{ max_gain: number, centerFrequency: number, currentGain: number }>) => void): void;
     GetSupportedFeatures(deviceId: number, callback: (error: JabraError, result: Array<enumDeviceFeature>) => void): void;
+    GetDeviceSnapshot(deviceId: number, fieldMask: number, callback: (error: JabraError, result: DeviceSnapshot) => void): void;
+    GetCachedDeviceInfoSync(deviceId: number): CachedDeviceInfo | undefined;
+    GetCapabilitiesSync(deviceId: number): DeviceCapabilities;
     
     GetLanguagePackInformation(deviceId: number, pack: enumLanguagePack, callback: (error: JabraError, result: LanguagePackStats) => void): void;
     GetSubDeviceProperty(deviceId: number, subDeviceID: enumSubDevice, deviceProperty: enumDeviceProperty, callback: (error: JabraError, result: string) => void): void;
@@ -341,14 +378,69 @@ export declare interface SdkIntegration {
     GetEthernetIPv4Status(deviceId: number, callback: (error: JabraError, result: IPv4Status) => void): void;
     GetWLANIPv4Status(deviceId: number, callback: (error: JabraError, result: IPv4Status) => void): void;
     GetUSBState(deviceId: number, callback: (error: JabraError, result: enumUSBState) => void): void;
-    GetMACAddress(deviceId: number, selectedInterface : enumNetworkInterface, callback: (error: JabraError, result: Array<number>) => void): void;
+    GetMACAddress(deviceId: number, selectedInterface : enumNetworkInterface, callback: (error: JabraError, result: Uint8Array) => void): void;
     
     BTLinkQualityChangeEventEnabled(deviceId: number, enable: boolean, callback: (error: JabraError, result: void) => void): void;
 
+    /**
+     * Register (or cancel) a Jabra_SetSettingsChangeListener for all settings of the device. Changes
+     * are reported through the settingsChanged callback of Initialize, with unchanged values filtered out.
+     */
+    SettingsChangeEventEnabled(deviceId: number, enable: boolean, callback: (error: JabraError, result: void) => void): void;
+
+    /**
+     * Register (or cancel) the native device status listeners. Events are reported through the
+     * corresponding callbacks of Initialize.
+     */
+    HeadDetectionStatusEventEnabled(deviceId: number, enable: boolean, callback: (error: JabraError, result: void) => void): void;
+    JackConnectorStatusEventEnabled(deviceId: number, enable: boolean, callback: (error: JabraError, result: void) => void): void;
+    LinkConnectionStatusEventEnabled(deviceId: number, enable: boolean, callback: (error: JabraError, result: void) => void): void;
+
+    /**
+     * Add (or remove) a subscriber to a device event (named as in DeviceType.on). Events of devices
+     * and event types without subscribers are dropped natively. Returns the new subscriber count
+     * (always 0 for events without a native source).
+     */
+    SubscribeEventSync(deviceId: number, eventName: string): number;
+    UnsubscribeEventSync(deviceId: number, eventName: string): number;
+
+    /**
+     * Replace the native filter for device events. Throws a TypeError for unknown event names.
+     */
+    SetEventFilter(filter: EventFilter): void;
+
     GetConstSync(deviceId: number, key: string): number | undefined;
     GetConstStringSync(deviceId: number, refKey: number): string | undefined;
     GetConstBooleanSync(deviceId: number, refKey: number): boolean | undefined;
     GetConstIntegerSync(deviceId: number, refKey: number): number | undefined;
     GetConstFieldSync(deviceId: number, refKey: number, id : string): number | undefined;
     GetConstListSync(deviceId: number, refKey: number, idx : number): number | undefined;
+    /**
+     * Resolve a whole path like "a.b[3].c" in one call - from the root of the constants tree or,
+     * when refKey is given, relative to that node (the path may then start with an index).
+     */
+    GetConstPathSync(deviceId: number, path: string, refKey?: number): number | undefined;
+    /**
+     * Materialize the constants below rootKey (at most maxDepth levels) as one frozen object. Struct
+     * fields can not be enumerated by the SDK, so only the given field names are looked up in structs.
+     * The result is cached per device and arguments.
+     */
+    GetConstTreeSync(deviceId: number, rootKey: string, maxDepth: number, fields?: string[]): DeviceConstantTree | undefined;
+
+    /**
+     * Get queue depth and wait-time statistics for the native executor that runs all
+     * async calls (internal utility, not directly Jabra SDK related).
+     */
+    GetExecutorStatsSync(): ExecutorStats;
+
+    /**
+     * Get latency percentiles per native function and call phase (internal utility, not directly
+     * Jabra SDK related).
+     */
+    GetPerfStatsSync(): PerfStats;
+
+    /**
+     * Restart the latency statistics returned by GetPerfStatsSync.
+     */
+    ResetPerfStats(): void;
   }
@@ -1,8 +1,20 @@
 #include "settings.h"
+#include "app.h"
+#include "propertykeys.h"
+#include "deviceregistry.h"
+#include "jsonwriter.h"
 
+#include <stdio.h>
 #include <string.h>
 #include <limits.h>
 #include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 /**
  * For freeing a DeviceSettings that we created ourselves.
@@ -56,115 +68,100 @@ static void Custom_FreeDeviceSettings(DeviceSettings* setting) {
 }
 
 /**
- * Utility for representing a native deviceSettings structure as a string (for logging purposes).
+ * Write a setting value (currValue or dependentDefaultValue) according to its data type.
  */
-static std::string toString(DeviceSettings * src) {
-  std::ostringstream buffer; 
+static void writeSettingValue(util::JsonWriter& json, const char * name, const SettingInfo& settingSrc, void * value) {
+  if (value) {
+    json.key(name);
+    if (settingSrc.settingDataType == DataType::settingByte) {
+      json.value(*((uint8_t *)value));
+    } else if (settingSrc.settingDataType == DataType::settingString) {
+      json.value((const char *)value);
+    } else {
+      json.value("ERROR: unexpected datatype " + std::to_string(settingSrc.settingDataType));
+    }
+  }
+}
 
-  buffer << "{ ";
-  buffer << "\"errStatus\": " << src->errStatus << ", ";
-  buffer << "\"settingInfo\": [ ";
+/**
+ * Dump a native deviceSettings structure as json (for logging purposes).
+ */
+static void writeJson(util::JsonWriter& json, const DeviceSettings * src) {
+  json.beginObject();
+  json.field("errStatus", (int)src->errStatus);
+  json.key("settingInfo").beginArray();
 
   for (unsigned int i=0; i<src->settingCount; ++i) {
-    SettingInfo& settingSrc = src->settingInfo[i];
-    if (i>0)  {
-        buffer << ",";
-    }
+    const SettingInfo& settingSrc = src->settingInfo[i];
 
-    buffer << "{ ";
-    buffer << "\"guid\": \"" << (settingSrc.guid ? settingSrc.guid : "") << "\", ";
-    buffer << "\"name\": \"" << (settingSrc.name ? settingSrc.name : "") << "\", ";
-    buffer << "\"helpText\": \"" << (settingSrc.helpText ? settingSrc.helpText : "") << "\", ";
-    buffer << "\"isValidationSupport\": " << (settingSrc.isValidationSupport ? "true" : "false") << ", ";
+    json.beginObject();
+    json.field("guid", settingSrc.guid);
+    json.field("name", settingSrc.name);
+    json.field("helpText", settingSrc.helpText);
+    json.field("isValidationSupport", settingSrc.isValidationSupport);
 
-    ValidationRule *validationRuleSrc = settingSrc.validationRule;
+    const ValidationRule *validationRuleSrc = settingSrc.validationRule;
     if (validationRuleSrc) {
-       buffer << "\"validationRule\": { ";
-       buffer << "\"minLength\": " << validationRuleSrc->minLength << ", ";
-       buffer << "\"maxLength\": " << validationRuleSrc->maxLength << ", ";
-       buffer << "\"errorMessage\": \"" << (validationRuleSrc->errorMessage ? validationRuleSrc->errorMessage : "") << "\", ";
-       buffer << "\"regExp\": \"" << (validationRuleSrc->regExp ? validationRuleSrc->regExp : "") << "\" " ;
-       buffer << "}, " << std::endl;
-    }
-
-    buffer << "\"isDeviceRestart\": " << (settingSrc.isDeviceRestart ? "true" : "false") << ", ";
-    buffer << "\"isSettingProtected\": " << (settingSrc.isSettingProtected ? "true" : "false") << ", ";    
-    buffer << "\"isSettingProtectionEnabled\": " << (settingSrc.isSettingProtectionEnabled ? "true" : "false") << ", ";
-    buffer << "\"isWirelessConnect\": " << (settingSrc.isWirelessConnect ? "true" : "false") << ", ";
-    buffer << "\"cntrlType\": " << settingSrc.cntrlType << ", ";
-    
-    if (settingSrc.currValue) {
-      if (settingSrc.settingDataType == DataType::settingByte) {
-        buffer << "\"currValue\": " << std::to_string(*((uint8_t *)settingSrc.currValue)) << ", ";
-      } else if (settingSrc.settingDataType == DataType::settingString) {
-        buffer << "\"currValue\": \"" << (char *)settingSrc.currValue << "\", ";
-      } else {
-        buffer << "\"currValue\": " << "ERROR: unexpected datatype " << settingSrc.currValue << ", ";
-      }
-    }
-
-    buffer << "\"settingDataType\": " << settingSrc.settingDataType << ", ";
-    buffer << "\"groupName\": \"" << (settingSrc.groupName ? settingSrc.groupName : "") << "\", ";
-    buffer << "\"groupHelpText\": \"" << (settingSrc.groupHelpText ? settingSrc.groupHelpText : "") << "\", ";
-    buffer << "\"isDepedentsetting\": " << (settingSrc.isDepedentsetting ? "true" : "false") << ", ";
-
-    buffer << "\"isPCsetting\": " << (settingSrc.isPCsetting ? "true" : "false") << ", ";
-    buffer << "\"isChildDeviceSetting\": " << (settingSrc.isChildDeviceSetting ? "true" : "false") << ", ";
-    
-    if (settingSrc.dependentDefaultValue) {
-      if (settingSrc.settingDataType == DataType::settingByte) {
-        buffer << "\"dependentDefaultValue\": " << std::to_string(*((uint8_t *)settingSrc.dependentDefaultValue)) << ", ";
-      } else if (settingSrc.settingDataType == DataType::settingString) {
-        buffer << "\"dependentDefaultValue\": \"" << (char *)settingSrc.dependentDefaultValue << "\", ";
-      } else {
-        buffer << "\"dependentDefaultValue\": " << "ERROR: unexpected datatype " << settingSrc.settingDataType << ", ";
-      }
+      json.key("validationRule").beginObject();
+      json.field("minLength", validationRuleSrc->minLength);
+      json.field("maxLength", validationRuleSrc->maxLength);
+      json.field("errorMessage", validationRuleSrc->errorMessage);
+      json.field("regExp", validationRuleSrc->regExp);
+      json.endObject();
     }
 
-    buffer << "\"listSize\": " << settingSrc.listSize << ", ";
-    buffer << "\"listKeyValue\": [ ";
+    json.field("isDeviceRestart", settingSrc.isDeviceRestart);
+    json.field("isSettingProtected", settingSrc.isSettingProtected);
+    json.field("isSettingProtectionEnabled", settingSrc.isSettingProtectionEnabled);
+    json.field("isWirelessConnect", settingSrc.isWirelessConnect);
+    json.field("cntrlType", (int)settingSrc.cntrlType);
+    writeSettingValue(json, "currValue", settingSrc, settingSrc.currValue);
+    json.field("settingDataType", (int)settingSrc.settingDataType);
+    json.field("groupName", settingSrc.groupName);
+    json.field("groupHelpText", settingSrc.groupHelpText);
+    json.field("isDepedentsetting", settingSrc.isDepedentsetting);
+    json.field("isPCsetting", settingSrc.isPCsetting);
+    json.field("isChildDeviceSetting", settingSrc.isChildDeviceSetting);
+    writeSettingValue(json, "dependentDefaultValue", settingSrc, settingSrc.dependentDefaultValue);
+
+    json.field("listSize", settingSrc.listSize);
+    json.key("listKeyValue").beginArray();
     for (int j=0; j< settingSrc.listSize; ++j) {
-      if (j>0)  {
-        buffer << ",";
-      }
-
-      buffer << "{ ";
+      const ListKeyValue& listKeyValueSrc = settingSrc.listKeyValue[j];
 
-      ListKeyValue& listKeyValueSrc = settingSrc.listKeyValue[j];
-
-      buffer << "\"key\": " << listKeyValueSrc.key << ", ";
- 
+      json.beginObject();
+      json.field("key", listKeyValueSrc.key);
       if (listKeyValueSrc.value) {
-        buffer << "\"value\": \"" <<  (char *)listKeyValueSrc.value << "\", ";
+        json.field("value", (const char *)listKeyValueSrc.value);
       }
-
-      buffer << "\"dependentcount\": " << listKeyValueSrc.dependentcount << ", ";
-      buffer << "\"dependents\": [ ";
+      json.field("dependentcount", listKeyValueSrc.dependentcount);
+      json.key("dependents").beginArray();
       for (int k=0; k< listKeyValueSrc.dependentcount; ++k) {
-        if (k>0)  {
-           buffer << ",";
-        }
-
-        DependencySetting& dependencySettingSrc = listKeyValueSrc.dependents[k];
-        buffer << "{ ";
-        buffer << "\"GUID\": \"" << (dependencySettingSrc.GUID ? dependencySettingSrc.GUID : "") << "\", ";
-        buffer << "\"enableFlag\": " << (dependencySettingSrc.enableFlag ? "true" : "false") << " ";
-        buffer << "}";
+        const DependencySetting& dependencySettingSrc = listKeyValueSrc.dependents[k];
+        json.beginObject();
+        json.field("GUID", dependencySettingSrc.GUID);
+        json.field("enableFlag", dependencySettingSrc.enableFlag);
+        json.endObject();
       }
-      buffer << "]";
-
-      buffer << "}";
+      json.endArray();
+      json.endObject();
     }
-    buffer << "]";
+    json.endArray();
 
-    buffer << "}";
+    json.endObject();
   }
 
-  buffer << "]"; // settingInfo
-
-  buffer << "}"; // top level object
+  json.endArray(); // settingInfo
+  json.endObject(); // top level object
+}
 
-  return buffer.str();
+/**
+ * Utility for representing a native deviceSettings structure as a json string (for logging purposes).
+ */
+static std::string toString(const DeviceSettings * src) {
+  util::JsonWriter json;
+  writeJson(json, src);
+  return json.take();
 }
 
 /**
@@ -216,7 +213,7 @@ static DeviceSettings *toCType(const unsigned short deviceId, Napi::Object src)
         } else if (settingDst.settingDataType == DataType::settingString) {
           settingDst.currValue = util::newCString(settingSrc.Get("currValue"));
         } else {         
-          LOG_ERROR_(LOGINSTANCE) << "Device " << deviceId << " has unexpected settingDataType " << settingDst.currValue << " for settings GUID " << settingDst.guid;
+          LOG_ERROR_CAT_(LogCategory::settings) << "Device " << deviceId << " has unexpected settingDataType " << settingDst.currValue << " for settings GUID " << settingDst.guid;
           settingDst.currValue = nullptr;
         }
       } else {
@@ -236,7 +233,7 @@ static DeviceSettings *toCType(const unsigned short deviceId, Napi::Object src)
         } else if (settingDst.settingDataType == DataType::settingString) {
           settingDst.dependentDefaultValue = util::newCString(settingSrc.Get("dependentDefaultValue"));
         } else {         
-          LOG_ERROR_(LOGINSTANCE) << "Device " << deviceId << " has unexpected settingDataType " << settingDst.currValue << " for settings GUID " << settingDst.guid;
+          LOG_ERROR_CAT_(LogCategory::settings) << "Device " << deviceId << " has unexpected settingDataType " << settingDst.currValue << " for settings GUID " << settingDst.guid;
           settingDst.dependentDefaultValue = nullptr;
         }
       } else {
@@ -286,106 +283,113 @@ static DeviceSettings *toCType(const unsigned short deviceId, Napi::Object src)
 }
 
 /**
-* Copy a native sdk DeviceSettings object into an empty napi device settings object (the reverse of toCType).
+* Copy a single native sdk SettingInfo into a new napi setting object. The current values
+* (currValue) are left out when only the static settings schema is wanted.
 */
-static void toNodeType(const unsigned short deviceId, DeviceSettings *src, Napi::Object& dest) {
-  Napi::Env env = dest.Env();
-  
-  Napi::Array settings = Napi::Array::New(env, src->settingCount);
-  for (unsigned int i=0; i<src->settingCount; ++i) {
-    SettingInfo& settingSrc = src->settingInfo[i];
+static Napi::Object toNodeType(const unsigned short deviceId, const util::PropertyKeys& keys, const Napi::Env& env, SettingInfo& settingSrc, bool includeCurrValue) {
+  util::ObjectBuilder settingDst(env, keys);
 
-    Napi::Object settingDst = Napi::Object::New(env);
+  settingDst.set(PropertyKey::guid, Napi::String::New(env, settingSrc.guid ? settingSrc.guid : ""));
+  settingDst.set(PropertyKey::name, Napi::String::New(env, settingSrc.name ? settingSrc.name : ""));
+  settingDst.set(PropertyKey::helpText, Napi::String::New(env, settingSrc.helpText ? settingSrc.helpText : ""));
+  settingDst.set(PropertyKey::isValidationSupport, Napi::Boolean::New(env, settingSrc.isValidationSupport));
 
-    settingDst.Set(Napi::String::New(env, "guid"), Napi::String::New(env, settingSrc.guid ? settingSrc.guid : ""));
-    settingDst.Set(Napi::String::New(env, "name"), Napi::String::New(env, settingSrc.name ? settingSrc.name : ""));
-    settingDst.Set(Napi::String::New(env, "helpText"), Napi::String::New(env, settingSrc.helpText ? settingSrc.helpText : ""));
-    settingDst.Set(Napi::String::New(env, "isValidationSupport"), Napi::Boolean::New(env, settingSrc.isValidationSupport));
+  ValidationRule *validationRuleSrc = settingSrc.validationRule;
+  if (validationRuleSrc) {
+     util::ObjectBuilder validationRuleDst(env, keys);
 
-    ValidationRule *validationRuleSrc = settingSrc.validationRule;
-    if (validationRuleSrc) {
-       Napi::Object validationRuleDst = Napi::Object::New(env);
+     validationRuleDst.set(PropertyKey::minLength, Napi::Number::New(env, validationRuleSrc->minLength));
+     validationRuleDst.set(PropertyKey::maxLength, Napi::Number::New(env, validationRuleSrc->maxLength));
 
-       validationRuleDst.Set(Napi::String::New(env, "minLength"), Napi::Number::New(env, validationRuleSrc->minLength));
-       validationRuleDst.Set(Napi::String::New(env, "maxLength"), Napi::Number::New(env, validationRuleSrc->maxLength));
+     validationRuleDst.set(PropertyKey::errorMessage, Napi::String::New(env, validationRuleSrc->errorMessage ? validationRuleSrc->errorMessage : ""));
+     validationRuleDst.set(PropertyKey::regExp, Napi::String::New(env, validationRuleSrc->regExp ? validationRuleSrc->regExp : ""));
 
-       validationRuleDst.Set(Napi::String::New(env, "errorMessage"), Napi::String::New(env, validationRuleSrc->errorMessage ? validationRuleSrc->errorMessage : ""));
-       validationRuleDst.Set(Napi::String::New(env, "regExp"), Napi::String::New(env, validationRuleSrc->regExp ? validationRuleSrc->regExp : ""));
+     settingDst.set(PropertyKey::validationRule, validationRuleDst.build());
+  }
 
-       settingDst.Set(Napi::String::New(env, "validationRule"), validationRuleDst);
+  settingDst.set(PropertyKey::isDeviceRestart, Napi::Boolean::New(env, settingSrc.isDeviceRestart));
+  settingDst.set(PropertyKey::isSettingProtected, Napi::Boolean::New(env, settingSrc.isSettingProtected));
+  settingDst.set(PropertyKey::isSettingProtectionEnabled, Napi::Boolean::New(env, settingSrc.isSettingProtectionEnabled));
+  settingDst.set(PropertyKey::isWirelessConnect, Napi::Boolean::New(env, settingSrc.isWirelessConnect));
+  settingDst.set(PropertyKey::cntrlType, Napi::Number::New(env, settingSrc.cntrlType));
+  settingDst.set(PropertyKey::settingDataType, Napi::Number::New(env, settingSrc.settingDataType));
+
+  if (includeCurrValue && settingSrc.currValue) {
+    if (settingSrc.settingDataType == DataType::settingByte) {
+      settingDst.set(PropertyKey::currValue, Napi::Number::New(env, *((uint8_t *)settingSrc.currValue)));
+    } else if (settingSrc.settingDataType == DataType::settingString) {
+      settingDst.set(PropertyKey::currValue, Napi::String::New(env, (char *)settingSrc.currValue));
+    } else {
+      LOG_ERROR_CAT_(LogCategory::settings) << "Device " << deviceId << " has unexpected settingDataType " << settingSrc.currValue << " for settings GUID " << settingSrc.guid;
     }
+  }
 
-    settingDst.Set(Napi::String::New(env, "isDeviceRestart"), Napi::Boolean::New(env, settingSrc.isDeviceRestart));
-    settingDst.Set(Napi::String::New(env, "isSettingProtected"), Napi::Boolean::New(env, settingSrc.isSettingProtected));
-    settingDst.Set(Napi::String::New(env, "isSettingProtectionEnabled"), Napi::Boolean::New(env, settingSrc.isSettingProtectionEnabled));
-    settingDst.Set(Napi::String::New(env, "isWirelessConnect"), Napi::Boolean::New(env, settingSrc.isWirelessConnect));
-    settingDst.Set(Napi::String::New(env, "cntrlType"), Napi::Number::New(env, settingSrc.cntrlType));
-    settingDst.Set(Napi::String::New(env, "settingDataType"), Napi::Number::New(env, settingSrc.settingDataType));
-
-    if (settingSrc.currValue) {
-      if (settingSrc.settingDataType == DataType::settingByte) {
-        settingDst.Set(Napi::String::New(env, "currValue"), Napi::Number::New(env, *((uint8_t *)settingSrc.currValue)));
-      } else if (settingSrc.settingDataType == DataType::settingString) {
-        settingDst.Set(Napi::String::New(env, "currValue"), Napi::String::New(env, (char *)settingSrc.currValue));
-      } else {
-        LOG_ERROR_(LOGINSTANCE) << "Device " << deviceId << " has unexpected settingDataType " << settingSrc.currValue << " for settings GUID " << settingSrc.guid;
-      }
-    }
+  settingDst.set(PropertyKey::groupName, Napi::String::New(env, settingSrc.groupName ? settingSrc.groupName : ""));
+  settingDst.set(PropertyKey::groupHelpText, Napi::String::New(env, settingSrc.groupHelpText ? settingSrc.groupHelpText : ""));
+  settingDst.set(PropertyKey::isDepedentsetting, Napi::Boolean::New(env, settingSrc.isDepedentsetting));
 
-    settingDst.Set(Napi::String::New(env, "groupName"), Napi::String::New(env, settingSrc.groupName ? settingSrc.groupName : ""));
-    settingDst.Set(Napi::String::New(env, "groupHelpText"), Napi::String::New(env, settingSrc.groupHelpText ? settingSrc.groupHelpText : ""));
-    settingDst.Set(Napi::String::New(env, "isDepedentsetting"), Napi::Boolean::New(env, settingSrc.isDepedentsetting));
-
-    settingDst.Set(Napi::String::New(env, "isPCsetting"), Napi::Boolean::New(env, settingSrc.isPCsetting));
-    settingDst.Set(Napi::String::New(env, "isChildDeviceSetting"), Napi::Boolean::New(env, settingSrc.isChildDeviceSetting));
-    
-    if (settingSrc.dependentDefaultValue) {
-      if (settingSrc.settingDataType == DataType::settingByte) {
-        settingDst.Set(Napi::String::New(env, "dependentDefaultValue"), Napi::Number::New(env, *((uint8_t *)settingSrc.dependentDefaultValue)));
-      } else if (settingSrc.settingDataType == DataType::settingString) {
-        settingDst.Set(Napi::String::New(env, "dependentDefaultValue"), Napi::String::New(env, (char *)settingSrc.dependentDefaultValue));
-      } else {
-        LOG_ERROR_(LOGINSTANCE) << "Device " << deviceId << " has unexpected settingDataType " << settingSrc.settingDataType << " for settings GUID " << settingSrc.guid;
-      }
+  settingDst.set(PropertyKey::isPCsetting, Napi::Boolean::New(env, settingSrc.isPCsetting));
+  settingDst.set(PropertyKey::isChildDeviceSetting, Napi::Boolean::New(env, settingSrc.isChildDeviceSetting));
+  
+  if (settingSrc.dependentDefaultValue) {
+    if (settingSrc.settingDataType == DataType::settingByte) {
+      settingDst.set(PropertyKey::dependentDefaultValue, Napi::Number::New(env, *((uint8_t *)settingSrc.dependentDefaultValue)));
+    } else if (settingSrc.settingDataType == DataType::settingString) {
+      settingDst.set(PropertyKey::dependentDefaultValue, Napi::String::New(env, (char *)settingSrc.dependentDefaultValue));
+    } else {
+      LOG_ERROR_CAT_(LogCategory::settings) << "Device " << deviceId << " has unexpected settingDataType " << settingSrc.settingDataType << " for settings GUID " << settingSrc.guid;
     }
+  }
 
-    Napi::Array keyValueList = Napi::Array::New(env, settingSrc.listSize);
-    settingDst.Set(Napi::String::New(env, "listSize"), Napi::Number::New(env, settingSrc.listSize));
-    for (int j=0; j< settingSrc.listSize; ++j) {
-      ListKeyValue& listKeyValueSrc = settingSrc.listKeyValue[j];
+  Napi::Array keyValueList = Napi::Array::New(env, settingSrc.listSize);
+  settingDst.set(PropertyKey::listSize, Napi::Number::New(env, settingSrc.listSize));
+  for (int j=0; j< settingSrc.listSize; ++j) {
+    ListKeyValue& listKeyValueSrc = settingSrc.listKeyValue[j];
 
-      Napi::Object listKeyValueDst = Napi::Object::New(env);
-      listKeyValueDst.Set(Napi::String::New(env, "key"), Napi::Number::New(env, listKeyValueSrc.key));
+    util::ObjectBuilder listKeyValueDst(env, keys);
+    listKeyValueDst.set(PropertyKey::key, Napi::Number::New(env, listKeyValueSrc.key));
  
-      if (listKeyValueSrc.value) {
-        listKeyValueDst.Set(Napi::String::New(env, "value"), Napi::String::New(env, (char *)listKeyValueSrc.value));
-      }
+    if (listKeyValueSrc.value) {
+      listKeyValueDst.set(PropertyKey::value, Napi::String::New(env, (char *)listKeyValueSrc.value));
+    }
 
-      listKeyValueDst.Set(Napi::String::New(env, "dependentcount"), Napi::Number::New(env, listKeyValueSrc.dependentcount));
+    listKeyValueDst.set(PropertyKey::dependentcount, Napi::Number::New(env, listKeyValueSrc.dependentcount));
 
-      Napi::Array dependenciesList = Napi::Array::New(env, listKeyValueSrc.dependentcount);
-      for (int k=0; k< listKeyValueSrc.dependentcount; ++k) {
-        DependencySetting& dependencySettingSrc = listKeyValueSrc.dependents[k];
+    Napi::Array dependenciesList = Napi::Array::New(env, listKeyValueSrc.dependentcount);
+    for (int k=0; k< listKeyValueSrc.dependentcount; ++k) {
+      DependencySetting& dependencySettingSrc = listKeyValueSrc.dependents[k];
 
-        Napi::Object dependencySettingDst = Napi::Object::New(env);
-        dependencySettingDst.Set(Napi::String::New(env, "GUID"), Napi::String::New(env, dependencySettingSrc.GUID ? dependencySettingSrc.GUID : ""));
-        dependencySettingDst.Set(Napi::String::New(env, "enableFlag"), Napi::Boolean::New(env, dependencySettingSrc.enableFlag));
+      util::ObjectBuilder dependencySettingDst(env, keys);
+      dependencySettingDst.set(PropertyKey::GUID, Napi::String::New(env, dependencySettingSrc.GUID ? dependencySettingSrc.GUID : ""));
+      dependencySettingDst.set(PropertyKey::enableFlag, Napi::Boolean::New(env, dependencySettingSrc.enableFlag));
 
-        dependenciesList.Set(k, dependencySettingDst);
-      }
+      dependenciesList.Set(k, dependencySettingDst.build());
+    }
 
-      listKeyValueDst.Set(Napi::String::New(env, "dependents"), dependenciesList);
+    listKeyValueDst.set(PropertyKey::dependents, dependenciesList);
 
-      keyValueList.Set(j, listKeyValueDst);
-    }
+    keyValueList.Set(j, listKeyValueDst.build());
+  }
+
+  settingDst.set(PropertyKey::listKeyValue, keyValueList);
 
-    settingDst.Set(Napi::String::New(env, "listKeyValue"), keyValueList);
+  return settingDst.build();
+}
 
-    settings.Set(i, settingDst);
+/**
+* Copy a native sdk DeviceSettings object into an empty napi device settings object (the reverse of toCType).
+*/
+static void toNodeType(const unsigned short deviceId, DeviceSettings *src, Napi::Object& dest) {
+  Napi::Env env = dest.Env();
+  util::PropertyKeys keys(env);
+
+  Napi::Array settings = Napi::Array::New(env, src->settingCount);
+  for (unsigned int i=0; i<src->settingCount; ++i) {
+    settings.Set(i, toNodeType(deviceId, keys, env, src->settingInfo[i], true));
   }
 
-  dest.Set(Napi::String::New(env, "errStatus"), Napi::Number::New(env, src->errStatus));
-  dest.Set(Napi::String::New(env, "settingInfo"), settings);
+  dest.Set(keys[PropertyKey::errStatus], Napi::Number::New(env, src->errStatus));
+  dest.Set(keys[PropertyKey::settingInfo], settings);
 }
 
 Napi::Value napi_GetSettings(const Napi::CallbackInfo& info) {
@@ -396,7 +400,7 @@ Napi::Value napi_GetSettings(const Napi::CallbackInfo& info) {
     const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-    (new util::JAsyncWorker<DeviceSettings *, Napi::Object>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<DeviceSettings *, Napi::Object>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId]() -> DeviceSettings * { 
@@ -405,8 +409,8 @@ Napi::Value napi_GetSettings(const Napi::CallbackInfo& info) {
         if (!rawSetttings) {
           util::JabraException::LogAndThrow(functionName, "null returned");
         } else {
-            IF_LOG_(LOGINSTANCE, plog::verbose) {
-              LOG_VERBOSE_(LOGINSTANCE) << "napi_GetSetting got raw object : '" << toString(rawSetttings) << "'";
+            IF_LOG_CAT_(LogCategory::settings, plog::verbose) {
+              LOG_VERBOSE_CAT_(LogCategory::settings) << "napi_GetSetting got raw object : '" << toString(rawSetttings) << "'";
             }
         }
 
@@ -422,7 +426,7 @@ Napi::Value napi_GetSettings(const Napi::CallbackInfo& info) {
             Jabra_FreeDeviceSettings(rawSetttings);
           }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -437,7 +441,7 @@ Napi::Value napi_GetSetting(const Napi::CallbackInfo& info) {
     const std::string guid = info[1].As<Napi::String>();
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
-    (new util::JAsyncWorker<DeviceSettings *, Napi::Object>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<DeviceSettings *, Napi::Object>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId, guid]() -> DeviceSettings * { 
@@ -446,8 +450,8 @@ Napi::Value napi_GetSetting(const Napi::CallbackInfo& info) {
         if (!rawSetttings) {
           util::JabraException::LogAndThrow(functionName, "null returned");
         } else {
-            IF_LOG_(LOGINSTANCE, plog::verbose) {
-              LOG_VERBOSE_(LOGINSTANCE) << "napi_GetSetting got raw object : '" << toString(rawSetttings) << "'";
+            IF_LOG_CAT_(LogCategory::settings, plog::verbose) {
+              LOG_VERBOSE_CAT_(LogCategory::settings) << "napi_GetSetting got raw object : '" << toString(rawSetttings) << "'";
             }
         }
       
@@ -464,7 +468,7 @@ Napi::Value napi_GetSetting(const Napi::CallbackInfo& info) {
             Jabra_FreeDeviceSettings(rawSetttings);
           }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
@@ -480,11 +484,11 @@ Napi::Value napi_SetSettings(const Napi::CallbackInfo& info) {
     Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
 
     DeviceSettings * const rawDeviceSettings = toCType(deviceId, settings);
-    IF_LOG_(LOGINSTANCE, plog::verbose) {
-      LOG_VERBOSE_(LOGINSTANCE) << "napi_SetSettings translated settings input argument into raw object : '" << toString(rawDeviceSettings) << "'";
+    IF_LOG_CAT_(LogCategory::settings, plog::verbose) {
+      LOG_VERBOSE_CAT_(LogCategory::settings) << "napi_SetSettings translated settings input argument into raw object : '" << toString(rawDeviceSettings) << "'";
     }
 
-    (new util::JAsyncWorker<void, void>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
       functionName,
       javascriptResultCallback,
       [functionName, deviceId, rawDeviceSettings](){
@@ -497,12 +501,593 @@ Napi::Value napi_SetSettings(const Napi::CallbackInfo& info) {
           Custom_FreeDeviceSettings(rawDeviceSettings);
         }
       }
-    ))->Queue();
+    ));
+  }
+
+  return env.Undefined();
+}
+
+/**
+ * A single setting value as passed to/from SetSettingValues and GetSettingsDelta.
+ * Byte values are stored as a single char.
+ */
+struct SettingValue {
+  DataType type;
+  std::string value;
+
+  bool operator==(const SettingValue& other) const {
+    return type == other.type && value == other.value;
+  }
+};
+
+static Napi::Value toNodeType(const Napi::Env& env, const SettingValue& src) {
+  if (src.type == DataType::settingByte) {
+    return Napi::Number::New(env, src.value.empty() ? 0 : (uint8_t)src.value[0]);
+  } else {
+    return Napi::String::New(env, src.value);
+  }
+}
+
+// SetSettingValues(deviceId: number, values: { [guid: string]: number | string }, callback: (error: JabraError, result: void) => void): void;
+Napi::Value napi_SetSettingValues(const Napi::CallbackInfo& info) {
+  const char * const functionName = __func__;
+  Napi::Env env = info.Env();
+
+  if (util::verifyArguments(functionName, info, {util::NUMBER, util::OBJECT, util::FUNCTION})) {
+    const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
+    Napi::Object values = info[1].As<Napi::Object>();
+    Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
+
+    // Only the changed settings are sent - the device keeps all other values as is.
+    Napi::Array guids = values.GetPropertyNames();
+    std::vector<std::pair<std::string, SettingValue>> changes;
+    changes.reserve(guids.Length());
+    for (uint32_t i = 0; i < guids.Length(); ++i) {
+      const std::string guid = guids.Get(i).As<Napi::String>();
+      Napi::Value value = values.Get(guid);
+      if (value.IsNumber()) {
+        const double byteValue = value.As<Napi::Number>().DoubleValue();
+        if (!(byteValue >= 0 && byteValue <= 255) || byteValue != (double)(uint8_t)byteValue) {
+          const std::string errMsg = "Value of setting " + guid + " to " + std::string(functionName) + " out of range (expected integer from 0 to 255)";
+          LOG_ERROR_CAT_(LogCategory::settings) << errMsg;
+          Napi::TypeError::New(env, errMsg).ThrowAsJavaScriptException();
+          return env.Undefined();
+        }
+        changes.emplace_back(guid, SettingValue { DataType::settingByte, std::string(1, (char)(uint8_t)byteValue) });
+      } else if (value.IsString()) {
+        changes.emplace_back(guid, SettingValue { DataType::settingString, value.As<Napi::String>() });
+      } else {
+        const std::string errMsg = "Wrong type of value for setting " + guid + " to " + std::string(functionName) + " (expected number or string)";
+        LOG_ERROR_CAT_(LogCategory::settings) << errMsg;
+        Napi::TypeError::New(env, errMsg).ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+    }
+
+    DeviceSettings * const rawDeviceSettings = new DeviceSettings();
+    rawDeviceSettings->errStatus = Jabra_ErrorStatus::NoError;
+    rawDeviceSettings->settingCount = (unsigned int)changes.size();
+    rawDeviceSettings->settingInfo = new SettingInfo[changes.size()]();
+    for (size_t i = 0; i < changes.size(); ++i) {
+      SettingInfo& settingDst = rawDeviceSettings->settingInfo[i];
+      const SettingValue& value = changes[i].second;
+
+      settingDst.guid = util::newCString(changes[i].first);
+      settingDst.settingDataType = value.type;
+      if (value.type == DataType::settingByte) {
+        settingDst.currValue = new char[1] { value.value[0] };
+      } else {
+        settingDst.currValue = util::newCString(value.value);
+      }
+    }
+
+    IF_LOG_CAT_(LogCategory::settings, plog::verbose) {
+      LOG_VERBOSE_CAT_(LogCategory::settings) << "napi_SetSettingValues translated values input argument into raw object : '" << toString(rawDeviceSettings) << "'";
+    }
+
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<void, void>(
+      functionName,
+      javascriptResultCallback,
+      [functionName, deviceId, rawDeviceSettings](){
+        Jabra_ReturnCode retv;
+        if ((retv = Jabra_SetSettings(deviceId, rawDeviceSettings)) != Return_Ok) {
+          util::JabraReturnCodeException::LogAndThrow(functionName, retv);
+        }
+      }, [rawDeviceSettings]() {
+        Custom_FreeDeviceSettings(rawDeviceSettings);
+      }
+    ));
+  }
+
+  return env.Undefined();
+}
+
+/**
+ * Last read value of each setting per device together with the version it last changed in.
+ * Versions come from one global counter, so they also keep increasing across re-attaches.
+ */
+struct SettingsSnapshotEntry {
+  SettingValue value;
+  uint64_t changedVersion;
+};
+
+static std::unordered_map<unsigned short, std::unordered_map<std::string, SettingsSnapshotEntry>> settingsSnapshots;
+static std::mutex settingsSnapshotsMutex;
+static std::atomic<uint64_t> settingsSnapshotVersion(0);
+
+/**
+ * Merge the current values of settings into the snapshot of a device (the caller must hold
+ * settingsSnapshotsMutex). visit is called for every setting with a byte or string value, with
+ * changed set if it was not in the snapshot or its value differs. Returns the version the
+ * changes got, or 0 if nothing changed.
+ */
+static uint64_t updateSnapshot(std::unordered_map<std::string, SettingsSnapshotEntry>& snapshot, const DeviceSettings * settings,
+                               const std::function<void(const std::string&, const SettingsSnapshotEntry&, bool changed)>& visit) {
+  uint64_t version = 0;
+  std::string guid;
+
+  for (unsigned int i=0; i<settings->settingCount; ++i) {
+    const SettingInfo& settingSrc = settings->settingInfo[i];
+    if (!settingSrc.guid || !settingSrc.currValue) {
+      continue;
+    }
+
+    SettingValue value;
+    value.type = settingSrc.settingDataType;
+    if (value.type == DataType::settingByte) {
+      value.value = std::string(1, *((const char *)settingSrc.currValue));
+    } else if (value.type == DataType::settingString) {
+      value.value = (const char *)settingSrc.currValue;
+    } else {
+      continue;
+    }
+
+    guid = settingSrc.guid;
+    auto it = snapshot.find(guid);
+    const bool changed = it == snapshot.end() || !(it->second.value == value);
+    if (changed) {
+      if (version == 0) {
+        version = ++settingsSnapshotVersion;
+      }
+      if (it == snapshot.end()) {
+        it = snapshot.emplace(guid, SettingsSnapshotEntry { value, version }).first;
+      } else {
+        it->second = SettingsSnapshotEntry { value, version };
+      }
+    }
+
+    visit(guid, it->second, changed);
+  }
+
+  return version;
+}
+
+struct SettingsDelta {
+  uint64_t version;
+  std::vector<std::pair<std::string, SettingValue>> values;
+};
+
+// GetSettingsDelta(deviceId: number, sinceVersion: number, callback: (error: JabraError, result: SettingsDelta) => void): void;
+Napi::Value napi_GetSettingsDelta(const Napi::CallbackInfo& info) {
+  const char * const functionName = __func__;
+  Napi::Env env = info.Env();
+
+  if (util::verifyArguments(functionName, info, {util::NUMBER, util::NUMBER, util::FUNCTION})) {
+    const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
+    const uint64_t sinceVersion = (uint64_t)std::max<int64_t>(0, info[1].As<Napi::Number>().Int64Value());
+    Napi::Function javascriptResultCallback = info[2].As<Napi::Function>();
+
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<SettingsDelta, Napi::Object>(
+      functionName, 
+      javascriptResultCallback,
+      [functionName, deviceId, sinceVersion]() -> SettingsDelta { 
+        DeviceSettings * const rawSetttings = Jabra_GetSettings(deviceId);
+        if (!rawSetttings) {
+          util::JabraException::LogAndThrow(functionName, "null returned");
+        }
+
+        SettingsDelta result;
+
+        std::lock_guard<std::mutex> lock(settingsSnapshotsMutex);
+        const uint64_t version = updateSnapshot(settingsSnapshots[deviceId], rawSetttings, [&result, sinceVersion](const std::string& guid, const SettingsSnapshotEntry& entry, bool changed) {
+          if (entry.changedVersion > sinceVersion) {
+            result.values.emplace_back(guid, entry.value);
+          }
+        });
+
+        result.version = version != 0 ? version : settingsSnapshotVersion.load();
+
+        Jabra_FreeDeviceSettings(rawSetttings);
+        return result;
+      }, [](const Napi::Env& env, const SettingsDelta& delta) {  
+          Napi::Object values = Napi::Object::New(env);
+          for (const auto& entry : delta.values) {
+            values.Set(entry.first, toNodeType(env, entry.second));
+          }
+
+          Napi::Object napiResult = Napi::Object::New(env);
+          napiResult.Set(Napi::String::New(env, "version"), Napi::Number::New(env, (double)delta.version));
+          napiResult.Set(Napi::String::New(env, "values"), values);
+          return napiResult;
+      }
+    ));
+  }
+
+  return env.Undefined();
+}
+
+void freeSettingsSnapshot(unsigned short deviceId) {
+  std::lock_guard<std::mutex> lock(settingsSnapshotsMutex);
+  settingsSnapshots.erase(deviceId);
+}
+
+void freeSettingsSnapshot() {
+  std::lock_guard<std::mutex> lock(settingsSnapshotsMutex);
+  settingsSnapshots.clear();
+}
+
+std::vector<std::string> updateSettingsSnapshot(unsigned short deviceId, const DeviceSettings * settings) {
+  std::vector<std::string> changedGuids;
+
+  std::lock_guard<std::mutex> lock(settingsSnapshotsMutex);
+  updateSnapshot(settingsSnapshots[deviceId], settings, [&changedGuids](const std::string& guid, const SettingsSnapshotEntry& entry, bool changed) {
+    if (changed) {
+      changedGuids.push_back(guid);
+    }
+  });
+
+  return changedGuids;
+}
+
+/**
+ * The settings passed to Jabra_SetSettingsChangeListener per device. They select which settings
+ * the sdk reports changes for and remain owned by us for as long as the listener is registered.
+ */
+static std::unordered_map<unsigned short, DeviceSettings *> settingsChangeFilters;
+static std::mutex settingsChangeFiltersMutex;
+
+// Swap the registered filter of a device, freeing the previous one.
+static void replaceSettingsChangeFilter(unsigned short deviceId, DeviceSettings * filter) {
+  DeviceSettings * previous = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(settingsChangeFiltersMutex);
+    auto it = settingsChangeFilters.find(deviceId);
+    if (it != settingsChangeFilters.end()) {
+      previous = it->second;
+      settingsChangeFilters.erase(it);
+    }
+    if (filter) {
+      settingsChangeFilters[deviceId] = filter;
+    }
+  }
+
+  if (previous) {
+    Jabra_FreeDeviceSettings(previous);
+  }
+}
+
+Napi::Value napi_SettingsChangeEventEnabled(const Napi::CallbackInfo& info) {
+  const char * const functionName = __func__;
+  return util::SimpleDeviceAsyncBoolSetter(functionName, info, [functionName](unsigned short deviceId, bool enable)
+  {
+    if (!enable) {
+      const Jabra_ReturnCode result = Jabra_SetSettingsChangeListener(deviceId, nullptr, nullptr);
+      if (result != Return_Ok) {
+        util::JabraReturnCodeException::LogAndThrow(functionName, result);
+      }
+      replaceSettingsChangeFilter(deviceId, nullptr);
+      return;
+    }
+
+    // Listen for all settings of the device. Their current values also seed the snapshot, so
+    // the first notification is compared against what the device had when we started listening.
+    DeviceSettings * const filter = Jabra_GetSettings(deviceId);
+    if (!filter) {
+      util::JabraException::LogAndThrow(functionName, "null returned");
+    }
+    updateSettingsSnapshot(deviceId, filter);
+
+    const Jabra_ReturnCode result = Jabra_SetSettingsChangeListener(deviceId, internalCallbackManager::getSettingsChangeCallback(), filter);
+    if (result != Return_Ok) {
+      Jabra_FreeDeviceSettings(filter);
+      util::JabraReturnCodeException::LogAndThrow(functionName, result);
+    }
+    replaceSettingsChangeFilter(deviceId, filter);
+  });
+}
+
+void freeSettingsChangeListener(unsigned short deviceId) {
+  replaceSettingsChangeFilter(deviceId, nullptr);
+}
+
+void freeSettingsChangeListeners() {
+  std::unordered_map<unsigned short, DeviceSettings *> filters;
+  {
+    std::lock_guard<std::mutex> lock(settingsChangeFiltersMutex);
+    filters.swap(settingsChangeFilters);
+  }
+
+  for (const auto& entry : filters) {
+    Jabra_FreeDeviceSettings(entry.second);
+  }
+}
+
+/**
+ * Static part of the settings (everything but the current values) shared by all devices with
+ * the same product id and firmware version. The guids are in the order returned by the sdk,
+ * and the index of a guid is used to pass current values compactly.
+ *
+ * Schemas are cached by product id and firmware version. The id also includes a hash of the
+ * guids, so a schema replaced because the settings did not match it gets a new id.
+ */
+struct SettingsSchema {
+  std::string id;
+  std::vector<std::string> guids;
+  std::unordered_map<std::string, uint32_t> indexes;
+};
+
+static std::unordered_map<std::string, std::shared_ptr<const SettingsSchema>> settingsSchemas;
+static std::mutex settingsSchemasMutex;
+
+static std::string settingsSchemaKey(unsigned short productId, const std::string& firmwareVersion) {
+  return std::to_string(productId) + "/" + firmwareVersion;
+}
+
+// 64 bit FNV-1a hash of the guids in schema order.
+static std::string settingsSchemaHash(const std::vector<std::string>& guids) {
+  uint64_t hash = 14695981039346656037ull;
+  for (const std::string& guid : guids) {
+    for (const char c : guid) {
+      hash = (hash ^ (unsigned char)c) * 1099511628211ull;
+    }
+    // Separator, so moving a character between neighbouring guids changes the hash.
+    hash = (hash ^ 0xffu) * 1099511628211ull;
+  }
+
+  char buf[17];
+  snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)hash);
+  return buf;
+}
+
+// Frozen javascript objects of the schemas built in an environment, only accessed from the
+// javascript thread of that environment and freed when it is torn down.
+typedef std::unordered_map<std::string, std::pair<std::shared_ptr<const SettingsSchema>, Napi::ObjectReference>> SettingsSchemaObjects;
+static std::unordered_map<napi_env, std::unique_ptr<SettingsSchemaObjects>> settingsSchemaObjectsByEnv;
+static std::mutex settingsSchemaObjectsMutex;
+
+static void freeSettingsSchemaObjects(void * arg) {
+  napi_env env = static_cast<napi_env>(arg);
+
+  std::unique_ptr<SettingsSchemaObjects> objects;
+  {
+    std::lock_guard<std::mutex> lock(settingsSchemaObjectsMutex);
+    auto it = settingsSchemaObjectsByEnv.find(env);
+    if (it != settingsSchemaObjectsByEnv.end()) {
+      objects = std::move(it->second);
+      settingsSchemaObjectsByEnv.erase(it);
+    }
+  }
+}
+
+static SettingsSchemaObjects& getSettingsSchemaObjects(napi_env env) {
+  std::lock_guard<std::mutex> lock(settingsSchemaObjectsMutex);
+  std::unique_ptr<SettingsSchemaObjects>& objects = settingsSchemaObjectsByEnv[env];
+  if (!objects) {
+    objects.reset(new SettingsSchemaObjects());
+
+    napi_status status = napi_add_env_cleanup_hook(env, &freeSettingsSchemaObjects, env);
+    if (status != napi_ok) {
+      LOG_ERROR_(LOGINSTANCE) << "Settings schemas could not register cleanup hook: " << status;
+    }
+  }
+  return *objects;
+}
+
+struct SchemaSettings {
+  std::shared_ptr<const SettingsSchema> schema;
+  DeviceSettings * settings = nullptr;
+};
+
+/**
+ * Read all settings of a device and find (or create) the matching schema.
+ */
+static SchemaSettings readSchemaSettings(const char * const functionName, const unsigned short deviceId) {
+  unsigned short productId;
+  std::string firmwareVersion;
+  if (!readDeviceModel(deviceId, productId, firmwareVersion)) {
+    util::JabraException::LogAndThrow(functionName, "firmware version of device " + std::to_string(deviceId) + " could not be read");
+  }
+  const std::string schemaKey = settingsSchemaKey(productId, firmwareVersion);
+
+  SchemaSettings result;
+  result.settings = Jabra_GetSettings(deviceId);
+  if (!result.settings) {
+    util::JabraException::LogAndThrow(functionName, "null returned");
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(settingsSchemasMutex);
+    auto it = settingsSchemas.find(schemaKey);
+    if (it != settingsSchemas.end()) {
+      result.schema = it->second;
+    }
+  }
+
+  // Reuse the cached schema unless the settings unexpectedly do not match it.
+  bool matches = result.schema && result.schema->guids.size() == result.settings->settingCount;
+  for (unsigned int i=0; matches && i<result.settings->settingCount; ++i) {
+    const char * guid = result.settings->settingInfo[i].guid;
+    matches = guid && result.schema->guids[i] == guid;
+  }
+
+  if (!matches) {
+    std::shared_ptr<SettingsSchema> schema = std::make_shared<SettingsSchema>();
+    schema->guids.reserve(result.settings->settingCount);
+    for (unsigned int i=0; i<result.settings->settingCount; ++i) {
+      const char * guid = result.settings->settingInfo[i].guid;
+      schema->guids.push_back(guid ? guid : "");
+      schema->indexes[schema->guids.back()] = i;
+    }
+    schema->id = schemaKey + "/" + settingsSchemaHash(schema->guids);
+
+    if (result.schema) {
+      LOG_WARNING_CAT_(LogCategory::settings) << "Settings of device " << deviceId << " do not match cached schema " << result.schema->id << " - replacing it with " << schema->id;
+    }
+
+    std::lock_guard<std::mutex> lock(settingsSchemasMutex);
+    settingsSchemas[schemaKey] = schema;
+    result.schema = schema;
+  }
+
+  return result;
+}
+
+/**
+ * Get the cached schema of a device from its product id and firmware version without reading
+ * the device, or null if it is not known (yet).
+ */
+static std::shared_ptr<const SettingsSchema> findSettingsSchema(const unsigned short deviceId) {
+  unsigned short productId;
+  std::string firmwareVersion;
+  if (!getDeviceModel(deviceId, productId, firmwareVersion)) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(settingsSchemasMutex);
+  auto it = settingsSchemas.find(settingsSchemaKey(productId, firmwareVersion));
+  return it != settingsSchemas.end() ? it->second : nullptr;
+}
+
+/**
+ * Freeze a javascript value and everything reachable from it.
+ */
+static void deepFreeze(const Napi::Function& freeze, Napi::Value value) {
+  if (value.IsObject()) {
+    Napi::Object obj = value.As<Napi::Object>();
+    Napi::Array names = obj.GetPropertyNames();
+    for (uint32_t i = 0; i < names.Length(); ++i) {
+      deepFreeze(freeze, obj.Get(names.Get(i)));
+    }
+    freeze.Call({ obj });
+  }
+}
+
+// GetSettingsSchema(deviceId: number, callback: (error: JabraError, result: SettingsSchema) => void): void;
+Napi::Value napi_GetSettingsSchema(const Napi::CallbackInfo& info) {
+  const char * const functionName = __func__;
+  Napi::Env env = info.Env();
+
+  if (util::verifyArguments(functionName, info, {util::NUMBER, util::FUNCTION})) {
+    const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
+    Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
+
+    // Only read the settings of the device if this environment has not built its schema before.
+    std::shared_ptr<const SettingsSchema> cachedSchema = findSettingsSchema(deviceId);
+    if (cachedSchema) {
+      const SettingsSchemaObjects& objects = getSettingsSchemaObjects(env);
+      auto it = objects.find(cachedSchema->id);
+      if (it == objects.end() || it->second.first != cachedSchema) {
+        cachedSchema = nullptr;
+      }
+    }
+
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<SchemaSettings, Napi::Object>(
+      functionName, 
+      javascriptResultCallback,
+      [functionName, deviceId, cachedSchema]() -> SchemaSettings { 
+        if (cachedSchema) {
+          SchemaSettings result;
+          result.schema = cachedSchema;
+          return result;
+        }
+        return readSchemaSettings(functionName, deviceId);
+      }, [functionName, deviceId](const Napi::Env& env, const SchemaSettings& src) {  
+          SettingsSchemaObjects& objects = getSettingsSchemaObjects(env);
+          auto it = objects.find(src.schema->id);
+          if (it != objects.end() && it->second.first == src.schema) {
+            return it->second.second.Value();
+          }
+
+          if (!src.settings) {
+            // Replaced by a schema read from another device meanwhile.
+            util::JabraException::LogAndThrow(functionName, "settings schema " + src.schema->id + " changed while reading it");
+          }
+
+          // First request for this schema - build it once and hand out the same frozen object after that.
+          util::PropertyKeys keys(env);
+          Napi::Array settings = Napi::Array::New(env, src.settings->settingCount);
+          for (unsigned int i=0; i<src.settings->settingCount; ++i) {
+            settings.Set(i, toNodeType(deviceId, keys, env, src.settings->settingInfo[i], false));
+          }
+
+          Napi::Object schema = Napi::Object::New(env);
+          schema.Set(Napi::String::New(env, "id"), Napi::String::New(env, src.schema->id));
+          schema.Set(keys[PropertyKey::settingInfo], settings);
+          deepFreeze(env.Global().Get("Object").As<Napi::Object>().Get("freeze").As<Napi::Function>(), schema);
+
+          objects[src.schema->id] = std::make_pair(src.schema, Napi::Persistent(schema));
+          return schema;
+      }, [](SchemaSettings& src) {
+          if (src.settings) {
+            Jabra_FreeDeviceSettings(src.settings);
+          }
+      }
+    ));
   }
 
   return env.Undefined();
 }
 
+// GetSettingValues(deviceId: number, callback: (error: JabraError, result: SchemaSettingValues) => void): void;
+Napi::Value napi_GetSettingValues(const Napi::CallbackInfo& info) {
+  const char * const functionName = __func__;
+  Napi::Env env = info.Env();
+
+  if (util::verifyArguments(functionName, info, {util::NUMBER, util::FUNCTION})) {
+    const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
+    Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
+
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<SchemaSettings, Napi::Object>(
+      functionName, 
+      javascriptResultCallback,
+      [functionName, deviceId]() -> SchemaSettings { 
+        return readSchemaSettings(functionName, deviceId);
+      }, [](const Napi::Env& env, const SchemaSettings& src) {  
+          // Values are stored at the schema index of their setting (settings match the schema order).
+          Napi::Array values = Napi::Array::New(env, src.settings->settingCount);
+          for (unsigned int i=0; i<src.settings->settingCount; ++i) {
+            const SettingInfo& settingSrc = src.settings->settingInfo[i];
+            if (settingSrc.currValue && settingSrc.settingDataType == DataType::settingByte) {
+              values.Set(i, Napi::Number::New(env, *((uint8_t *)settingSrc.currValue)));
+            } else if (settingSrc.currValue && settingSrc.settingDataType == DataType::settingString) {
+              values.Set(i, Napi::String::New(env, (char *)settingSrc.currValue));
+            } else {
+              values.Set(i, env.Null());
+            }
+          }
+
+          Napi::Object result = Napi::Object::New(env);
+          result.Set(Napi::String::New(env, "schemaId"), Napi::String::New(env, src.schema->id));
+          result.Set(Napi::String::New(env, "values"), values);
+          return result;
+      }, [](SchemaSettings& src) {
+          if (src.settings) {
+            Jabra_FreeDeviceSettings(src.settings);
+          }
+      }
+    ));
+  }
+
+  return env.Undefined();
+}
+
+void freeSettingsSchemas() {
+  // Schema objects of the environments are freed by their cleanup hooks - objects of dropped
+  // schemas are never handed out again, as they no longer match a cached schema.
+  std::lock_guard<std::mutex> lock(settingsSchemasMutex);
+  settingsSchemas.clear();
+}
+
 Napi::Value napi_FactoryReset(const Napi::CallbackInfo& info) {
   const char * const functionName = __func__;
   return util::SimpleDeviceAsyncFunction<Napi::Value, Jabra_ReturnCode>(functionName, info, [functionName](unsigned short deviceId) {
@@ -523,21 +1108,21 @@ Napi::Value napi_IsSettingProtectionEnabled(const Napi::CallbackInfo& info) {
 
 Napi::Value napi_IsUploadImageSupported(const Napi::CallbackInfo& info) {
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(__func__, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsUploadImageSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_UPLOAD_IMAGE, &Jabra_IsUploadImageSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) { return Napi::Boolean::New(env, cppResult); });
 }
 
 Napi::Value napi_IsUploadRingtoneSupported(const Napi::CallbackInfo& info) {
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(__func__, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsUploadRingtoneSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_UPLOAD_RINGTONE, &Jabra_IsUploadRingtoneSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) { return Napi::Boolean::New(env, cppResult); });
 }
 
 Napi::Value napi_IsFactoryResetSupported(const Napi::CallbackInfo& info) {
   return util::SimpleDeviceAsyncFunction<Napi::Boolean, bool>(__func__, info, [](unsigned short deviceId) {
-    bool retv = Jabra_IsFactoryResetSupported(deviceId);
+    bool retv = isCapabilitySupported(deviceId, CAPABILITY_FACTORY_RESET, &Jabra_IsFactoryResetSupported);
     return retv;
   }, [](const Napi::Env& env, bool cppResult) { return Napi::Boolean::New(env, cppResult); });
 }
@@ -563,7 +1148,7 @@ Napi::Value napi_GetFailedSettingNames(const Napi::CallbackInfo& info) {
     const unsigned short deviceId = (unsigned short)(info[0].As<Napi::Number>().Int32Value());
     Napi::Function javascriptResultCallback = info[1].As<Napi::Function>();
 
-    (new util::JAsyncWorker<FailedSettings *, Napi::Object>(
+    util::QueueOnDevice(deviceId, new util::JAsyncWorker<FailedSettings *, Napi::Object>(
       functionName, 
       javascriptResultCallback,
       [functionName, deviceId]() -> FailedSettings * { 
@@ -580,7 +1165,7 @@ Napi::Value napi_GetFailedSettingNames(const Napi::CallbackInfo& info) {
             Jabra_FreeFailedSettings(rawSetttings);
           }
       }
-    ))->Queue();
+    ));
   }
 
   return env.Undefined();
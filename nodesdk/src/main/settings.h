@@ -3,9 +3,26 @@
 Napi::Value napi_GetSetting(const Napi::CallbackInfo& info);
 Napi::Value napi_GetSettings(const Napi::CallbackInfo& info);
 Napi::Value napi_SetSettings(const Napi::CallbackInfo& info);
+Napi::Value napi_SetSettingValues(const Napi::CallbackInfo& info);
+Napi::Value napi_GetSettingsDelta(const Napi::CallbackInfo& info);
+Napi::Value napi_GetSettingsSchema(const Napi::CallbackInfo& info);
+Napi::Value napi_GetSettingValues(const Napi::CallbackInfo& info);
 Napi::Value napi_FactoryReset(const Napi::CallbackInfo& info);
 Napi::Value napi_IsSettingProtectionEnabled(const Napi::CallbackInfo& info);
 Napi::Value napi_IsUploadImageSupported(const Napi::CallbackInfo& info);
 Napi::Value napi_IsUploadRingtoneSupported(const Napi::CallbackInfo& info);
 Napi::Value napi_IsFactoryResetSupported(const Napi::CallbackInfo& info);
-Napi::Value napi_GetFailedSettingNames(const Napi::CallbackInfo& info);
\ No newline at end of file
+Napi::Value napi_GetFailedSettingNames(const Napi::CallbackInfo& info);
+Napi::Value napi_SettingsChangeEventEnabled(const Napi::CallbackInfo& info);
+void freeSettingsSnapshot(unsigned short deviceId);
+void freeSettingsSnapshot();
+
+/**
+ * Merge reported setting values into the snapshot of the device and return the guids of
+ * the settings whose value actually changed.
+ */
+std::vector<std::string> updateSettingsSnapshot(unsigned short deviceId, const DeviceSettings * settings);
+
+void freeSettingsChangeListener(unsigned short deviceId);
+void freeSettingsChangeListeners();
+void freeSettingsSchemas();
@@ -24,8 +24,3 @@
 #include "jabrautil.h"
 #include "napiutil.h"
 #include "logger.h"
-
-// Temporary util until supported by napi c++ api.
-// https://github.com/mika-fischer/napi-thread-safe-callback
-
-#include "napi-thread-safe-callback.hpp"
@@ -17,4 +17,16 @@ export function isNodeJs() {
  * @internal 
  * @hidden
  */
-export const nameof = <T>(name: keyof T) => name;
\ No newline at end of file
+export const nameof = <T>(name: keyof T) => name;
+
+/**
+ * Format binary data (f.x. panic codes or DECT raw data) as an uppercase hex string.
+ * Binary payloads are delivered as `Uint8Array` - use this helper when text is needed.
+ */
+export function toHexString(bytes: Uint8Array): string {
+    let result = "";
+    for (let i = 0; i < bytes.length; ++i) {
+        result += (bytes[i] < 16 ? "0" : "") + bytes[i].toString(16);
+    }
+    return result.toUpperCase();
+}
@@ -0,0 +1,152 @@
+/**
+ * jabra-log-decode - converts native log files written with LIBJABRA_NODE_LOG_FORMAT=binary to
+ * the same text lines as the default log format.
+ *
+ * Usage: jabra-log-decode <file.jlog> [<file.jlog> ...]
+ *
+ * Files are decoded in the order given and written to stdout.
+ */
+
+#include "binarylogformat.h"
+
+#include <plog/Severity.h>
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+struct DecoderState {
+  std::unordered_map<uint64_t, std::string> strings;
+  int64_t lastTime = 0;
+};
+
+const std::string& lookup(const DecoderState& state, uint64_t id) {
+  static const std::string unknown("?");
+  auto it = state.strings.find(id);
+  return it != state.strings.end() ? it->second : unknown;
+}
+
+bool decodeLog(DecoderState& state, const char* data, size_t size) {
+  size_t pos = 0;
+  if (size < 1) {
+    return false;
+  }
+  const plog::Severity severity = static_cast<plog::Severity>(static_cast<uint8_t>(data[pos++]));
+
+  int64_t timeDelta;
+  uint64_t tid, callerId, line, messageId;
+  if (!binarylog::getZigzag(data, size, pos, timeDelta) ||
+      !binarylog::getVarint(data, size, pos, tid) ||
+      !binarylog::getVarint(data, size, pos, callerId) ||
+      !binarylog::getVarint(data, size, pos, line) ||
+      !binarylog::getVarint(data, size, pos, messageId)) {
+    return false;
+  }
+
+  state.lastTime += timeDelta;
+  const time_t seconds = static_cast<time_t>(state.lastTime / 1000);
+  const int millis = static_cast<int>(state.lastTime % 1000);
+
+  tm t;
+#ifdef _WIN32
+  localtime_s(&t, &seconds);
+#else
+  localtime_r(&seconds, &t);
+#endif
+
+  char timeStr[32];
+  strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &t);
+
+  const std::string message = messageId == 0 ? std::string(data + pos, size - pos) : lookup(state, messageId);
+  const std::string& caller = lookup(state, callerId);
+
+  // Same layout as plog's TxtFormatter.
+  printf("%s.%03d %-5s [%llu] [%s@%llu] %s\n", timeStr, millis, plog::severityToString(severity),
+         (unsigned long long)tid, caller.c_str(), (unsigned long long)line, message.c_str());
+  return true;
+}
+
+bool decodeFile(const char* fileName) {
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file) {
+    fprintf(stderr, "%s: can not open file\n", fileName);
+    return false;
+  }
+  const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  if (content.size() < binarylog::MAGIC_SIZE + 1 || memcmp(content.data(), binarylog::MAGIC, binarylog::MAGIC_SIZE) != 0) {
+    fprintf(stderr, "%s: not a binary Jabra node log file\n", fileName);
+    return false;
+  }
+
+  const uint8_t version = static_cast<uint8_t>(content[binarylog::MAGIC_SIZE]);
+  if (version > binarylog::VERSION) {
+    fprintf(stderr, "%s: unsupported format version %u\n", fileName, (unsigned int)version);
+    return false;
+  }
+
+  DecoderState state;
+  const char* data = content.data();
+  size_t pos = binarylog::MAGIC_SIZE + 1;
+  while (pos < content.size()) {
+    const uint8_t type = static_cast<uint8_t>(data[pos++]);
+    uint64_t length;
+    if (!binarylog::getVarint(data, content.size(), pos, length) || length > content.size() - pos) {
+      // A record cut short by a crash - everything before it has been decoded.
+      fprintf(stderr, "%s: truncated record at offset %llu\n", fileName, (unsigned long long)pos);
+      return false;
+    }
+
+    const char* payload = data + pos;
+    const size_t payloadSize = static_cast<size_t>(length);
+    pos += payloadSize;
+
+    switch (type) {
+      case binarylog::RECORD_RESET:
+        state = DecoderState();
+        break;
+
+      case binarylog::RECORD_STRING: {
+        size_t payloadPos = 0;
+        uint64_t id;
+        if (binarylog::getVarint(payload, payloadSize, payloadPos, id)) {
+          state.strings[id] = std::string(payload + payloadPos, payloadSize - payloadPos);
+        }
+        break;
+      }
+
+      case binarylog::RECORD_LOG:
+        if (!decodeLog(state, payload, payloadSize)) {
+          fprintf(stderr, "%s: malformed log record\n", fileName);
+        }
+        break;
+
+      default:
+        // Unknown record type from a newer writer - skip it.
+        break;
+    }
+  }
+
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <file.jlog> [<file.jlog> ...]\n", argv[0]);
+    return 2;
+  }
+
+  bool ok = true;
+  for (int i = 1; i < argc; ++i) {
+    ok = decodeFile(argv[i]) && ok;
+  }
+  return ok ? 0 : 1;
+}